@@ -87,6 +87,14 @@ bool IPeriodicActionGenerator::Execute(IActionManager& manager)
 	return true;
 }
 
+time_point_t IPeriodicActionGenerator::GetNextRunTime() const
+{
+	if (m_LastRunTime == time_point_t{})
+		return {};
+
+	return m_LastRunTime + GetInterval();
+}
+
 bool LobbyDebugActionGenerator::ExecuteImpl(IActionManager& manager)
 {
 	if (!manager.QueueAction<GenericCommandAction>("tf_lobby_debug"))
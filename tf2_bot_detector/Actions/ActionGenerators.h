@@ -25,6 +25,9 @@ namespace tf2_bot_detector
 
 		bool Execute(IActionManager& manager) override final;
 
+		// time_point_t{} if we haven't run yet
+		time_point_t GetNextRunTime() const;
+
 	protected:
 		[[nodiscard]] virtual bool ExecuteImpl(IActionManager& manager) = 0;
 
@@ -3,6 +3,7 @@
 #include "Config/Settings.h"
 #include "Actions.h"
 #include "Log.h"
+#include "UpdateScheduler.h"
 #include "WorldEventListener.h"
 #include "WorldState.h"
 
@@ -72,6 +73,9 @@ bool RCONActionManager::QueueAction(std::unique_ptr<IAction>&& action)
 		}
 	}
 
+	if (m_ActionQueuedFunc)
+		m_ActionQueuedFunc(*action);
+
 	m_Actions.push_back(std::move(action));
 	return true;
 }
@@ -243,3 +247,23 @@ void RCONActionManager::Update()
 	ProcessQueuedCommands();
 	ProcessRunningCommands();
 }
+
+time_point_t RCONActionManager::GetNextUpdateTime() const
+{
+	if (!m_Settings.m_Unsaved.m_RCONClient)
+		return time_point_t::max();
+
+	// Nothing tells us when a command finishes, so keep checking
+	if (!m_RunningCommands.empty())
+		return tfbd_clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL;
+
+	const time_point_t nextAllowed = m_LastUpdateTime + UPDATE_INTERVAL;
+	if (!m_Actions.empty())
+		return nextAllowed;
+
+	time_point_t next = time_point_t::max();
+	for (const auto& generator : m_PeriodicActionGenerators)
+		next = std::min(next, generator->GetNextRunTime());
+
+	return std::max(next, nextAllowed);
+}
@@ -12,6 +12,7 @@
 #include <srcon/async_client.h>
 
 #include <filesystem>
+#include <functional>
 #include <iomanip>
 #include <queue>
 #include <regex>
@@ -32,6 +33,9 @@ namespace tf2_bot_detector
 
 		void Update();
 
+		// The soonest time Update() has something to do.
+		time_point_t GetNextUpdateTime() const;
+
 		bool QueueAction(std::unique_ptr<IAction>&& action);
 
 		template<typename TAction, typename... TArgs>
@@ -40,6 +44,10 @@ namespace tf2_bot_detector
 			return QueueAction(std::make_unique<TAction>(std::forward<TArgs>(args)...));
 		}
 
+		// Called with every action that makes it into the queue
+		using ActionQueuedFunc = std::function<void(const IAction& action)>;
+		void SetActionQueuedFunc(ActionQueuedFunc func) { m_ActionQueuedFunc = std::move(func); }
+
 		void AddPeriodicActionGenerator(std::unique_ptr<IPeriodicActionGenerator>&& action);
 
 		template<typename TAction, typename... TArgs>
@@ -71,6 +79,7 @@ namespace tf2_bot_detector
 		std::vector<std::unique_ptr<IAction>> m_Actions;
 		std::vector<std::unique_ptr<IPeriodicActionGenerator>> m_PeriodicActionGenerators;
 		std::map<ActionType, time_point_t> m_LastTriggerTime;
+		ActionQueuedFunc m_ActionQueuedFunc;
 
 		bool ShouldDiscardCommand(const std::string_view& cmd) const;
 		bool m_IsDiscardingServerCommands = true;
@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "Config/ConfigSaveScheduler.h"
 #include "DB/TempDB.h"
 
 // pasted without looking
@@ -16,6 +17,7 @@
 #include "ReleaseChannel.h"
 #include "TextureManager.h"
 #include "UpdateManager.h"
+#include "UpdateScheduler.h"
 #include "Util/PathUtils.h"
 #include "Version.h"
 #include "GlobalDispatcher.h"
@@ -38,6 +40,7 @@
 
 #include <mh/error/ensure.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
@@ -58,18 +61,36 @@ namespace tf2_bot_detector
 		static mh::dispatcher s_Dispatcher;
 		return s_Dispatcher;
 	}
+
+	static std::atomic<uint32_t> s_PendingMainThreadDispatches = 0;
+
+	mh::task<> SwitchToMainThread()
+	{
+		// Counted before waking, so an update that runs before the continuation has been
+		// posted to the dispatcher still knows to come back for it
+		s_PendingMainThreadDispatches++;
+		UpdateScheduler::Get().Wake();
+
+		co_await GetDispatcher().co_dispatch();
+
+		s_PendingMainThreadDispatches--;
+	}
+
+	bool HasPendingMainThreadDispatches()
+	{
+		return s_PendingMainThreadDispatches > 0;
+	}
 }
 
 TF2BDApplication::TF2BDApplication() :
-	m_WorldState(IWorldState::Create(m_Settings)),
+	m_TempDB(DB::ITempDB::Create()),
+	m_WorldState(IWorldState::Create(m_Settings, *m_TempDB)),
 	m_ActionManager(RCONActionManager::Create(m_Settings, GetWorld())),
 	m_UpdateManager(IUpdateManager::Create(m_Settings))
 {
 	assert(!s_Application);
 	s_Application = this;
 
-	m_TempDB = DB::ITempDB::Create();
-
 	// moved from mainwindow
 	ILogManager::GetInstance().CleanupLogFiles();
 
@@ -86,7 +107,11 @@ TF2BDApplication::TF2BDApplication() :
 	QueueUpdate();
 }
 
-TF2BDApplication::~TF2BDApplication() = default;
+TF2BDApplication::~TF2BDApplication()
+{
+	// Write out anything the settings/playerlist/rules saved in the last second
+	IConfigSaveScheduler::Get().Flush();
+}
 
 TF2BDApplication& TF2BDApplication::GetApplication()
 {
@@ -196,11 +221,25 @@ void TF2BDApplication::UpdateServerPing(time_point_t timestamp)
 
 void tf2_bot_detector::TF2BDApplication::Update()
 {
+	auto& scheduler = UpdateScheduler::Get();
+	scheduler.BeginUpdate();
+
+	// Whatever woke us up is something new to show. Anything still waiting on a continuation
+	// to reach the main thread polls for it through its own GetNextUpdateTime().
+	if (scheduler.ConsumeWake())
+		scheduler.MarkDirty();
+
 	if (m_Paused)
 		return;
 
 	GetDispatcher().run_for(10ms);
 
+	for (const auto& event : Processes::PollProcessEvents())
+	{
+		m_SetupFlow.OnProcessEvent(event);
+		scheduler.MarkDirty();
+	}
+
 	GetWorld().Update();
 	m_UpdateManager->Update();
 
@@ -216,20 +255,52 @@ void tf2_bot_detector::TF2BDApplication::Update()
 		if (!m_MainState)
 			m_MainState.emplace(*this);
 
+		if (m_MainState->m_Parser.HasPendingChanges())
+			scheduler.MarkDirty();
+
 		m_MainState->m_Parser.Update();
 		GetModLogic().Update();
 
+		// Still more to read
+		if (m_MainState->m_Parser.HasPendingChanges())
+			scheduler.ScheduleUpdateAt(clock_t::now());
+
 		m_MainState->OnUpdateDiscord();
 	}
 
 	GetActionManager().Update();
 
+	ScheduleNextUpdate();
+
 	// set our "should update even tabbed out" variable to false
 	if (b_ShouldUpdate) {
 		b_ShouldUpdate = false;
 	}
 }
 
+void TF2BDApplication::ScheduleNextUpdate()
+{
+	auto& scheduler = UpdateScheduler::Get();
+
+	scheduler.ScheduleUpdateAt(GetWorld().GetNextUpdateTime());
+	scheduler.ScheduleUpdateAt(GetActionManager().GetNextUpdateTime());
+
+	// Throttled requests are waiting on GetDispatcher(), which only runs in Update(). Requests
+	// that are actually in progress wake us up when they finish.
+	if (auto client = m_Settings.GetHTTPClient())
+	{
+		if (client->GetRequestCounts().m_Throttled > 0)
+			scheduler.ScheduleUpdateIn(UpdateScheduler::PENDING_POLL_INTERVAL);
+	}
+
+	// Their Wake() can get to us before the continuation reaches the dispatcher
+	if (HasPendingMainThreadDispatches())
+		scheduler.ScheduleUpdateIn(UpdateScheduler::PENDING_POLL_INTERVAL);
+
+	// ModeratorLogic runs off of the console log timestamps, so it only ever has something
+	// new to do after we've parsed something, which already wakes us up.
+}
+
 float TF2BDApplication::PlayerExtraData::GetAveragePing() const
 {
 	unsigned totalPing = m_Parent->GetPing();
@@ -247,7 +318,9 @@ float TF2BDApplication::PlayerExtraData::GetAveragePing() const
 TF2BDApplication::PostSetupFlowState::PostSetupFlowState(TF2BDApplication& app) :
 	m_Parent(&app),
 	m_ModeratorLogic(IModeratorLogic::Create(app.GetWorld(), app.m_Settings, app.GetActionManager())),
-	m_Parser(app.GetWorld(), app.m_Settings, app.m_Settings.GetTFDir() / "console.log")
+	m_Parser(app.GetWorld(), app.m_Settings, app.m_Settings.GetTFDir() / "console.log"),
+	m_Scoreboard(app.GetWorld(), *m_ModeratorLogic),
+	m_TeamStats(app.GetWorld(), *m_ModeratorLogic)
 {
 #ifdef TF2BD_ENABLE_DISCORD_INTEGRATION
 	m_DRPManager = IDRPManager::Create(app.m_Settings, app.GetWorld());
@@ -268,7 +341,12 @@ void TF2BDApplication::PostSetupFlowState::OnUpdateDiscord()
 	}
 
 	if (m_DRPManager)
+	{
 		m_DRPManager->Update();
+
+		// discord callbacks
+		UpdateScheduler::Get().ScheduleUpdateIn(1s);
+	}
 #endif
 }
 
@@ -362,10 +440,12 @@ void TF2BDApplication::QueueUpdate()
 }
 
 /// <summary>
-/// should we run Update()?
+/// is there something for Update() to do right now, that nothing is going to wake us up for?
 /// </summary>
 /// <returns></returns>
 bool TF2BDApplication::ShouldUpdate()
 {
-	return !this->IsSleepingEnabled() || b_ShouldUpdate;
+	// TF2/Steam starting or exiting, or tf2 writing to console.log always wakes us up
+	return b_ShouldUpdate || Processes::HasPendingProcessEvents() ||
+		(m_MainState && m_MainState->m_Parser.HasPendingChanges());
 }
@@ -12,11 +12,13 @@
 #include "Networking/GithubAPI.h"
 #include "ModeratorLogic.h"
 #include "SetupFlow/SetupFlow.h"
+#include "TeamStats.h"
 #include "WorldEventListener.h"
 #include "WorldState.h"
 #include "LobbyMember.h"
 #include "PlayerStatus.h"
 #include "GameData/TFConstants.h"
+#include "UI/ScoreboardModel.h"
 
 #include <mh/error/expected.hpp>
 
@@ -53,8 +55,6 @@ namespace tf2_bot_detector
 		// moved from "MainWindow"
 		const void* m_LastLogMessage = nullptr;
 
-		bool IsSleepingEnabled() const;
-
 		bool IsTimeEven() const;
 		float TimeSine(float interval = 1.0f, float min = 0, float max = 1) const;
 
@@ -128,6 +128,9 @@ namespace tf2_bot_detector
 		/// </summary>
 		bool b_ShouldUpdate = false;
 
+		// Tells UpdateScheduler when we next have something to do while sleeping.
+		void ScheduleNextUpdate();
+
 		struct PostSetupFlowState
 		{
 			PostSetupFlowState(TF2BDApplication& window);
@@ -136,6 +139,8 @@ namespace tf2_bot_detector
 			std::unique_ptr<IModeratorLogic> m_ModeratorLogic;
 
 			ConsoleLogParser m_Parser;
+			ScoreboardModel m_Scoreboard;
+			TeamStatsTracker m_TeamStats;
 			std::list<std::shared_ptr<const IConsoleLine>> m_PrintingLines;  // newest to oldest order
 			static constexpr size_t MAX_PRINTING_LINES = 512;
 			mh::generator<IPlayer&> GeneratePlayerPrintData();
@@ -151,6 +156,7 @@ namespace tf2_bot_detector
 	public:
 		void QueueUpdate();
 		bool ShouldUpdate();
+		bool IsSleepingEnabled() const;
 		void Update();
 
 		std::optional<PostSetupFlowState>& GetMainState() { return m_MainState; }
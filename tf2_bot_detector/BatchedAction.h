@@ -2,6 +2,7 @@
 
 #include "Clock.h"
 #include "Log.h"
+#include "UpdateScheduler.h"
 
 #ifdef _WIN32
 // https://developercommunity.visualstudio.com/t/Access-violation-in-_Thrd_yield-after-up/10664660
@@ -86,9 +87,22 @@ namespace tf2_bot_detector
 				}
 
 				m_ResponseFuture = {};
+				UpdateScheduler::Get().MarkDirty();
 			}
 		}
 
+		// When Update() next has something to do.
+		time_point_t GetNextUpdateTime() const
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_ResponseFuture.valid())
+				return clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL;
+			if (m_Queued.empty())
+				return time_point_t::max();
+
+			return m_LastUpdate + MIN_INTERVAL;
+		}
+
 	protected:
 		virtual response_future_type SendRequest(state_type& state, queue_collection_type& collection) = 0;
 		virtual void OnDataReady(state_type& state, const response_type& response, queue_collection_type& collection) = 0;
@@ -96,7 +110,7 @@ namespace tf2_bot_detector
 	private:
 		static constexpr duration_t MIN_INTERVAL = std::chrono::seconds(5);
 		state_type m_State{};
-		std::recursive_mutex m_Mutex;
+		mutable std::recursive_mutex m_Mutex;
 		queue_collection_type m_Queued;
 		response_future_type m_ResponseFuture;
 		time_point_t m_LastUpdate{};
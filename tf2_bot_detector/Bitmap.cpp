@@ -30,6 +30,11 @@ Bitmap::Bitmap(const std::filesystem::path& path, uint8_t desiredChannels)
 	LoadFile(path, desiredChannels);
 }
 
+Bitmap::Bitmap(const std::span<const std::byte>& encoded, uint8_t desiredChannels)
+{
+	LoadMemory(encoded, desiredChannels);
+}
+
 void Bitmap::LoadFile(const std::filesystem::path& path)
 {
 	return LoadFile(path, 0);
@@ -48,3 +53,18 @@ void Bitmap::LoadFile(const std::filesystem::path& path, uint8_t desiredChannels
 	if (!m_Image)
 		throw std::runtime_error("Failed to load image from "s << path << ": " << stbi_failure_reason());
 }
+
+void Bitmap::LoadMemory(const std::span<const std::byte>& encoded, uint8_t desiredChannels)
+{
+	int width, height, channels;
+	m_Image.reset(reinterpret_cast<std::byte*>(
+		stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()), int(encoded.size()),
+			&width, &height, &channels, desiredChannels)));
+
+	m_Width = width;
+	m_Height = height;
+	m_Channels = channels;
+
+	if (!m_Image)
+		throw std::runtime_error("Failed to load image from "s << encoded.size() << " bytes of memory: " << stbi_failure_reason());
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <filesystem>
+#include <span>
 
 namespace tf2_bot_detector
 {
@@ -11,10 +13,14 @@ namespace tf2_bot_detector
 		Bitmap() = default;
 		Bitmap(const std::filesystem::path& path);
 		Bitmap(const std::filesystem::path& path, uint8_t desiredChannels);
+		Bitmap(const std::span<const std::byte>& encoded, uint8_t desiredChannels = 0);
 
 		void LoadFile(const std::filesystem::path& path);
 		void LoadFile(const std::filesystem::path& path, uint8_t desiredChannels);
 
+		// Decodes an image file that's already in memory (jpg, png, etc)
+		void LoadMemory(const std::span<const std::byte>& encoded, uint8_t desiredChannels = 0);
+
 		const void* GetData() const { return m_Image.get(); }
 		uint32_t GetHeight() const { return m_Height; }
 		uint32_t GetWidth() const { return m_Width; }
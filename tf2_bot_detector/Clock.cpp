@@ -2,8 +2,39 @@
 
 #include <mh/chrono/chrono_helpers.hpp>
 
+#include <atomic>
+
 using namespace tf2_bot_detector;
 
+namespace
+{
+	// Ticks since the epoch, 0 when we're using the real time
+	std::atomic<tfbd_clock_t::rep> s_VirtualTime = 0;
+}
+
+auto tfbd_clock_t::now() noexcept -> time_point
+{
+	if (const auto virtualTime = s_VirtualTime.load(std::memory_order_relaxed); virtualTime != 0)
+		return time_point(duration(virtualTime));
+
+	return system_clock::now();
+}
+
+void tfbd_clock_t::SetVirtualTime(time_point t) noexcept
+{
+	s_VirtualTime.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void tfbd_clock_t::ClearVirtualTime() noexcept
+{
+	s_VirtualTime.store(0, std::memory_order_relaxed);
+}
+
+bool tfbd_clock_t::IsVirtualTime() noexcept
+{
+	return s_VirtualTime.load(std::memory_order_relaxed) != 0;
+}
+
 tm tf2_bot_detector::ToTM(const time_point_t& ts)
 {
 	return mh::chrono::to_tm(ts, mh::chrono::time_zone::local);
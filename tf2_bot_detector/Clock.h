@@ -7,8 +7,30 @@
 
 namespace tf2_bot_detector
 {
-	using clock_t = std::chrono::system_clock;
-	using tfbd_clock_t = clock_t;
+	/// <summary>
+	/// The system clock, unless something (the replay harness) has taken it over with a
+	/// virtual time. Time points are plain system_clock ones either way.
+	/// </summary>
+	struct tfbd_clock_t
+	{
+		using system_clock = std::chrono::system_clock;
+		using rep = system_clock::rep;
+		using period = system_clock::period;
+		using duration = system_clock::duration;
+		using time_point = system_clock::time_point;
+		static constexpr bool is_steady = false;
+
+		static time_point now() noexcept;
+
+		static std::time_t to_time_t(const time_point& t) noexcept { return system_clock::to_time_t(t); }
+		static time_point from_time_t(std::time_t t) noexcept { return system_clock::from_time_t(t); }
+
+		// Pins now() to the given time until ClearVirtualTime() is called.
+		static void SetVirtualTime(time_point t) noexcept;
+		static void ClearVirtualTime() noexcept;
+		static bool IsVirtualTime() noexcept;
+	};
+	using clock_t = tfbd_clock_t;
 	using time_point_t = clock_t::time_point;
 	using duration_t = clock_t::duration;
 
@@ -1,4 +1,5 @@
 #include "ConfigHelpers.h"
+#include "ConfigSaveScheduler.h"
 #include "Networking/HTTPClient.h"
 #include "Networking/HTTPHelpers.h"
 #include "Platform/Platform.h"
@@ -254,16 +255,15 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileAsync(const std::filesyst
 		// co_return loadResult;
 	}
 
-	if (auto saveResult = SaveFile(filename))
+	if (!loadResult)
 	{
-		if (loadResult)
-		{
-			LogFatalError(MH_SOURCE_LOCATION_CURRENT(), "Failed to load and resave {}. TF2 Bot Detector may not have permission to write to where it is installed.\n\nLoad error: {}\nSave error: {}", filename, loadResult, saveResult);
-		}
-		else
-		{
-			LogWarning(MH_SOURCE_LOCATION_CURRENT(), "Failed to resave {}", filename);
-		}
+		// Just normalizing the formatting, nobody needs to wait for it
+		if (auto saveResult = QueueSave(filename))
+			LogWarning(MH_SOURCE_LOCATION_CURRENT(), "Failed to resave {}: {}", filename, saveResult);
+	}
+	else if (auto saveResult = SaveFile(filename))
+	{
+		LogFatalError(MH_SOURCE_LOCATION_CURRENT(), "Failed to load and resave {}. TF2 Bot Detector may not have permission to write to where it is installed.\n\nLoad error: {}\nSave error: {}", filename, loadResult, saveResult);
 	}
 
 	co_return loadResult;
@@ -285,6 +285,9 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesy
 		co_return ConfigErrorType::ReadFileFailed;
 	}
 
+	// Don't read back an older version of something we just saved
+	IConfigSaveScheduler::Get().Flush(IFilesystem::Get().ResolvePath(filename, PathUsage::WriteRoaming));
+
 	const auto startTime = clock_t::now();
 
 	nlohmann::json json;
@@ -372,7 +375,53 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesy
 std::error_condition tf2_bot_detector::ConfigFileBase::SaveFile(const std::filesystem::path& filename) const
 {
 	nlohmann::json json;
+	if (auto error = SerializeFile(json, filename))
+		return error;
+
+	try
+	{
+		SaveJSONToFile(filename, json);
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", filename);
+		return ConfigErrorType::WriteFileFailed;
+	}
+
+	return ConfigErrorType::Success;
+}
+
+std::error_condition ConfigFileBase::QueueSave(const std::filesystem::path& filename) const
+{
+	auto path = IFilesystem::Get().ResolvePath(filename, PathUsage::WriteRoaming);
 
+	if (auto snapshot = CloneForSave())
+	{
+		IConfigSaveScheduler::Get().QueueSave(std::move(path),
+			[snapshot = std::move(snapshot), filename](nlohmann::json& output)
+			{
+				return snapshot->SerializeFile(output, filename);
+			});
+
+		return ConfigErrorType::Success;
+	}
+
+	auto json = std::make_shared<nlohmann::json>();
+	if (auto error = SerializeFile(*json, filename))
+		return error;
+
+	IConfigSaveScheduler::Get().QueueSave(std::move(path),
+		[json](nlohmann::json& output) -> std::error_condition
+		{
+			output = std::move(*json);
+			return ConfigErrorType::Success;
+		});
+
+	return ConfigErrorType::Success;
+}
+
+std::error_condition ConfigFileBase::SerializeFile(nlohmann::json& json, const std::filesystem::path& filename) const
+{
 	// If we already have a schema loaded, put it in the $schema property
 	try
 	{
@@ -406,16 +455,6 @@ std::error_condition tf2_bot_detector::ConfigFileBase::SaveFile(const std::files
 		return ConfigErrorType::SerializedSchemaValidationFailed;
 	}
 
-	try
-	{
-		SaveJSONToFile(filename, json);
-	}
-	catch (...)
-	{
-		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", filename);
-		return ConfigErrorType::WriteFileFailed;
-	}
-
 	return ConfigErrorType::Success;
 }
 
@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -91,6 +92,16 @@ namespace tf2_bot_detector
 		mh::task<std::error_condition> LoadFileAsync(const std::filesystem::path& filename, std::shared_ptr<const IHTTPClient> client = nullptr);
 		std::error_condition SaveFile(const std::filesystem::path& filename) const;
 
+		/// <summary>
+		/// Leaves serializing, formatting and writing the file to IConfigSaveScheduler. Only
+		/// the copy from CloneForSave() happens on the calling thread.
+		/// </summary>
+		/// <returns>Any error from serializing, if it had to happen now. Other errors are only logged.</returns>
+		std::error_condition QueueSave(const std::filesystem::path& filename) const;
+
+		// Serialize() plus the $schema, validated. filename is only used for error messages.
+		std::error_condition SerializeFile(nlohmann::json& json, const std::filesystem::path& filename) const;
+
 		virtual void ValidateSchema(const ConfigSchemaInfo& schema) const {}
 		virtual void Deserialize(const nlohmann::json& json) {}
 		virtual void Serialize(nlohmann::json& json) const = 0;
@@ -102,6 +113,12 @@ namespace tf2_bot_detector
 	protected:
 		virtual void PostLoad(bool deserialized) {}
 
+		/// <summary>
+		/// A copy of this file for QueueSave to serialize on the save thread. Files that
+		/// can't be copied return nullptr, and are serialized on the calling thread instead.
+		/// </summary>
+		virtual std::shared_ptr<const ConfigFileBase> CloneForSave() const { return nullptr; }
+
 	private:
 		mh::task<std::error_condition> LoadFileInternalAsync(std::filesystem::path filename, std::shared_ptr<const IHTTPClient> client);
 	};
@@ -168,7 +185,7 @@ namespace tf2_bot_detector
 			const T* defaultMutableList = GetDefaultMutableList();
 			const T* localList = GetLocalList();
 			if (localList)
-				localList->SaveFile(mh::format("cfg/{}.json", GetBaseFileName()));
+				localList->QueueSave(mh::format("cfg/{}.json", GetBaseFileName()));
 
 			if (defaultMutableList && defaultMutableList != localList)
 			{
@@ -177,7 +194,7 @@ namespace tf2_bot_detector
 				if (!IsOfficial())
 					throw std::runtime_error(mh::format("Attempted to save non-official data to {}", filename));
 
-				defaultMutableList->SaveFile(filename);
+				defaultMutableList->QueueSave(filename);
 			}
 		}
 
@@ -0,0 +1,212 @@
+#include "ConfigSaveScheduler.h"
+#include "ConfigHelpers.h"
+#include "Filesystem.h"
+#include "Log.h"
+
+#include <mh/text/formatters/error_code.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class ConfigSaveScheduler final : public IConfigSaveScheduler
+	{
+	public:
+		~ConfigSaveScheduler();
+
+		void QueueSave(std::filesystem::path path, SerializeFunc serialize, SavedFunc onSaved) override;
+		bool IsPending(const std::filesystem::path& path) const override;
+		void Flush(const std::filesystem::path& path) override;
+		void Flush() override;
+
+	private:
+		// Not tfbd_clock_t, that one follows the console log timestamps during replays
+		using clock = std::chrono::steady_clock;
+
+		struct PendingSave
+		{
+			SerializeFunc m_Serialize;
+			std::vector<SavedFunc> m_OnSaved;
+			clock::time_point m_Deadline;
+		};
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_WorkCV;
+		std::condition_variable m_SavedCV;
+		std::map<std::filesystem::path, PendingSave> m_Pending;
+		std::optional<std::filesystem::path> m_Writing;
+		bool m_Exiting = false;
+		std::thread m_Thread;
+
+		bool IsPendingLocked(const std::filesystem::path& path) const;
+		void ThreadFunc();
+		static void Save(const std::filesystem::path& path, PendingSave& save);
+	};
+}
+
+IConfigSaveScheduler& IConfigSaveScheduler::Get()
+{
+	static ConfigSaveScheduler s_Scheduler;
+	return s_Scheduler;
+}
+
+ConfigSaveScheduler::~ConfigSaveScheduler()
+{
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Exiting = true;
+	}
+
+	m_WorkCV.notify_all();
+
+	if (m_Thread.joinable())
+		m_Thread.join();
+}
+
+void ConfigSaveScheduler::QueueSave(std::filesystem::path path, SerializeFunc serialize, SavedFunc onSaved)
+{
+	assert(path.is_absolute());
+
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto [it, inserted] = m_Pending.try_emplace(std::move(path));
+		PendingSave& save = it->second;
+		save.m_Serialize = std::move(serialize);
+
+		if (onSaved)
+			save.m_OnSaved.push_back(std::move(onSaved));
+
+		// Only the first save starts the clock, so something saving constantly still gets written
+		if (inserted)
+			save.m_Deadline = clock::now() + COALESCE_WINDOW;
+
+		if (!m_Thread.joinable())
+			m_Thread = std::thread(&ConfigSaveScheduler::ThreadFunc, this);
+	}
+
+	m_WorkCV.notify_one();
+}
+
+bool ConfigSaveScheduler::IsPending(const std::filesystem::path& path) const
+{
+	std::lock_guard lock(m_Mutex);
+	return IsPendingLocked(path);
+}
+
+bool ConfigSaveScheduler::IsPendingLocked(const std::filesystem::path& path) const
+{
+	return m_Pending.contains(path) || m_Writing == path;
+}
+
+void ConfigSaveScheduler::Flush(const std::filesystem::path& path)
+{
+	std::unique_lock lock(m_Mutex);
+
+	if (auto found = m_Pending.find(path); found != m_Pending.end())
+	{
+		found->second.m_Deadline = clock::time_point{};
+		m_WorkCV.notify_one();
+	}
+
+	m_SavedCV.wait(lock, [&] { return !IsPendingLocked(path); });
+}
+
+void ConfigSaveScheduler::Flush()
+{
+	std::unique_lock lock(m_Mutex);
+
+	for (auto& [path, save] : m_Pending)
+		save.m_Deadline = clock::time_point{};
+
+	m_WorkCV.notify_one();
+	m_SavedCV.wait(lock, [&] { return m_Pending.empty() && !m_Writing; });
+}
+
+void ConfigSaveScheduler::ThreadFunc()
+{
+	std::unique_lock lock(m_Mutex);
+
+	while (true)
+	{
+		if (m_Pending.empty())
+		{
+			if (m_Exiting)
+				return;
+
+			m_WorkCV.wait(lock);
+			continue;
+		}
+
+		auto next = std::min_element(m_Pending.begin(), m_Pending.end(),
+			[](const auto& lhs, const auto& rhs) { return lhs.second.m_Deadline < rhs.second.m_Deadline; });
+
+		if (!m_Exiting && next->second.m_Deadline > clock::now())
+		{
+			m_WorkCV.wait_until(lock, next->second.m_Deadline);
+			continue;
+		}
+
+		auto node = m_Pending.extract(next);
+		m_Writing = node.key();
+
+		lock.unlock();
+		Save(node.key(), node.mapped());
+		lock.lock();
+
+		m_Writing.reset();
+		m_SavedCV.notify_all();
+	}
+}
+
+void ConfigSaveScheduler::Save(const std::filesystem::path& path, PendingSave& save)
+{
+	std::error_condition result;
+
+	try
+	{
+		nlohmann::json json;
+		result = save.m_Serialize(json);
+
+		if (!result)
+		{
+			try
+			{
+				IFilesystem::Get().WriteFile(path,
+					json.dump(1, '\t', true, nlohmann::detail::error_handler_t::ignore) + '\n', PathUsage::WriteRoaming);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", path);
+				result = ConfigErrorType::WriteFileFailed;
+			}
+		}
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to serialize {}", path);
+		result = ConfigErrorType::SerializeFailed;
+	}
+
+	for (const auto& onSaved : save.m_OnSaved)
+	{
+		try
+		{
+			onSaved(result);
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Exception in save callback for {}", path);
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Writes config files on a background thread, so saving from the UI never blocks on
+	/// json formatting or the disk. Saves of the same file that come in within
+	/// COALESCE_WINDOW of the first one are merged, and only the newest one is written.
+	///
+	/// Files are written to a temp file and renamed into place (see IFilesystem::WriteFile).
+	/// Anything still queued is written by Flush(), which is called on exit.
+	/// </summary>
+	class IConfigSaveScheduler
+	{
+	public:
+		virtual ~IConfigSaveScheduler() = default;
+
+		static IConfigSaveScheduler& Get();
+
+		static constexpr std::chrono::milliseconds COALESCE_WINDOW{ 1000 };
+
+		// Called on the save thread. Fills in the json to be written, or returns an error to skip writing.
+		using SerializeFunc = std::function<std::error_condition(nlohmann::json& json)>;
+		// Called on the save thread once the file has been written (or failed to be).
+		using SavedFunc = std::function<void(const std::error_condition& result)>;
+
+		/// <summary>
+		/// Thread safe. Replaces any save of the same file that hasn't happened yet. Every
+		/// onSaved for the replaced saves is still called, after the newest one is written.
+		/// </summary>
+		/// <param name="path">Must be absolute.</param>
+		/// <param name="serialize">Must not reference anything that can change before it is called.</param>
+		virtual void QueueSave(std::filesystem::path path, SerializeFunc serialize, SavedFunc onSaved = nullptr) = 0;
+
+		virtual bool IsPending(const std::filesystem::path& path) const = 0;
+
+		// Writes anything queued for path (or everything) immediately, and waits for it to finish.
+		virtual void Flush(const std::filesystem::path& path) = 0;
+		virtual void Flush() = 0;
+	};
+}
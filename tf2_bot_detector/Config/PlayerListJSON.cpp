@@ -1,11 +1,15 @@
 #include "PlayerListJSON.h"
+#include "PlayerListJournal.h"
+#include "ConfigSaveScheduler.h"
 #include "Networking/HTTPHelpers.h"
 #include "Util/JSONUtils.h"
 #include "ConfigHelpers.h"
+#include "Filesystem.h"
 #include "Log.h"
 #include "Settings.h"
 
 #include <mh/text/case_insensitive_string.hpp>
+#include <mh/text/formatters/error_code.hpp>
 #include <mh/text/string_insertion.hpp>
 #include <nlohmann/json.hpp>
 
@@ -15,10 +19,16 @@
 #include <string>
 
 using namespace tf2_bot_detector;
+using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
 static std::filesystem::path s_PlayerListPath("cfg/playerlist.json");
+static std::filesystem::path s_PlayerListJournalPath("cfg/playerlist.journal");
+
+// Whichever comes first, as long as there's something to compact
+static constexpr size_t COMPACT_AFTER_ENTRIES = 256;
+static constexpr auto COMPACT_INTERVAL = 5min;
 
 namespace tf2_bot_detector
 {
@@ -159,10 +169,21 @@ PlayerListJSON::PlayerListJSON(const Settings& settings) :
 	m_Settings(&settings),
 	m_CFGGroup(settings)
 {
+	m_Journal = std::make_unique<PlayerListJournal>(
+		IFilesystem::Get().ResolvePath(s_PlayerListJournalPath, PathUsage::WriteRoaming));
+	m_CompactionPath = IFilesystem::Get().ResolvePath(s_PlayerListPath, PathUsage::WriteRoaming);
+	m_LastCompactionTime = clock_t::now();
+
 	// Immediately load and resave to normalize any formatting
 	LoadFiles();
 }
 
+PlayerListJSON::~PlayerListJSON()
+{
+	// Everything is already in the journal, but there's no reason to replay it all next time
+	WaitForCompaction();
+}
+
 void PlayerListJSON::PlayerListFile::ValidateSchema(const ConfigSchemaInfo& schema) const
 {
 	if (schema.m_Type != "playerlist")
@@ -214,7 +235,14 @@ PlayerListData& PlayerListJSON::PlayerListFile::GetOrAddPlayer(const SteamID& id
 
 bool PlayerListJSON::LoadFiles()
 {
+	WaitForCompaction();
+
 	m_CFGGroup.LoadFiles();
+	m_Revision++;
+	m_LoadRevision++;
+
+	if (!m_CFGGroup.IsOfficial())
+		ReplayJournal();
 
 	if (m_CFGGroup.IsOfficial())
 	{
@@ -237,6 +265,123 @@ void PlayerListJSON::SaveFiles() const
 	m_CFGGroup.SaveFiles();
 }
 
+void PlayerListJSON::ReplayJournal()
+{
+	auto& list = m_CFGGroup.GetLocalList();
+
+	const auto replayed = m_Journal->Replay([&](PlayerListData&& data)
+		{
+			PlayerListData& existing = list.GetOrAddPlayer(data.GetSteamID());
+			data.m_TransientAttributes = existing.m_TransientAttributes;
+			existing = std::move(data);
+		},
+		[&](const SteamID& id)
+		{
+			auto found = list.m_Players.find(id);
+			if (found == list.m_Players.end())
+				return;
+
+			// Transient marks were never in the journal to begin with
+			if (found->second.m_TransientAttributes.empty())
+			{
+				list.m_Players.erase(found);
+			}
+			else
+			{
+				PlayerListData cleared(id);
+				cleared.m_TransientAttributes = found->second.m_TransientAttributes;
+				found->second = std::move(cleared);
+			}
+		});
+
+	if (replayed > 0)
+	{
+		DebugLog("Replayed {} playerlist journal entries", replayed);
+		StartCompaction();
+	}
+}
+
+void PlayerListJSON::AppendToJournal(const PlayerListData& data)
+{
+	AppendToJournal([&] { m_Journal->Append(data); });
+}
+
+void PlayerListJSON::AppendRemovalToJournal(const SteamID& id)
+{
+	AppendToJournal([&] { m_Journal->AppendRemoval(id); });
+}
+
+void PlayerListJSON::AppendToJournal(const std::function<void()>& append)
+{
+	try
+	{
+		append();
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to append to the playerlist journal, saving the full playerlist instead");
+		SaveFiles();
+		return;
+	}
+
+	const auto entries = m_Journal->GetEntryCount();
+	if (!IsCompacting() && (entries >= COMPACT_AFTER_ENTRIES ||
+		(clock_t::now() - m_LastCompactionTime) >= COMPACT_INTERVAL))
+	{
+		StartCompaction();
+	}
+}
+
+bool PlayerListJSON::IsCompacting() const
+{
+	return m_IsCompacting;
+}
+
+void PlayerListJSON::StartCompaction()
+{
+	// Rotating again would throw away the journal the running compaction hasn't saved yet. This
+	// runs on the main thread, so try again after that one is done instead of waiting for it.
+	if (IsCompacting())
+		return;
+
+	try
+	{
+		// Everything journaled so far is in the snapshot below
+		m_Journal->Rotate();
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to roll over the playerlist journal, not compacting");
+		return;
+	}
+
+	m_LastCompactionTime = clock_t::now();
+	m_IsCompacting = true;
+
+	// Copying the list is cheap compared to serializing it, so only the copy happens here
+	IConfigSaveScheduler::Get().QueueSave(m_CompactionPath,
+		[snapshot = m_CFGGroup.GetLocalList(), targetPath = m_CompactionPath](nlohmann::json& json)
+		{
+			return snapshot.SerializeFile(json, targetPath);
+		},
+		// Safe to capture this, the destructor waits for us
+		[this, rotatedPath = m_Journal->GetRotatedPath(), targetPath = m_CompactionPath](const std::error_condition& result)
+		{
+			// Otherwise it gets replayed again next time
+			if (result)
+				LogError(MH_SOURCE_LOCATION_CURRENT(), "Failed to compact playerlist journal into {}: {}", targetPath, result);
+			else
+				std::filesystem::remove(rotatedPath);
+
+			m_IsCompacting = false;
+		});
+}
+
+void PlayerListJSON::WaitForCompaction() const
+{
+	IConfigSaveScheduler::Get().Flush(m_CompactionPath);
+}
+
 auto PlayerListJSON::FindPlayerData(const SteamID& id) const ->
 	mh::generator<std::pair<const ConfigFileName&, const PlayerListData&>>
 {
@@ -265,6 +410,29 @@ auto PlayerListJSON::FindPlayerData(const SteamID& id) const ->
 	}
 }
 
+auto PlayerListJSON::GetAllPlayerData() const ->
+	mh::generator<std::pair<const ConfigFileName&, const PlayerListData&>>
+{
+	if (m_CFGGroup.m_UserList.has_value())
+	{
+		for (const auto& [id, data] : m_CFGGroup.m_UserList->m_Players)
+			co_yield { m_CFGGroup.m_UserList->GetName(), data };
+	}
+	if (auto list = m_CFGGroup.m_ThirdPartyLists.try_get())
+	{
+		for (auto& file : *list)
+		{
+			for (const auto& [id, data] : file.second)
+				co_yield { file.first, data };
+		}
+	}
+	if (auto list = m_CFGGroup.m_OfficialList.try_get())
+	{
+		for (const auto& [id, data] : list->m_Players)
+			co_yield { list->GetName(), data };
+	}
+}
+
 auto PlayerListJSON::FindPlayerAttributes(const SteamID& id, AttributePersistence persistence) const ->
 	mh::generator<std::pair<const ConfigFileName&, PlayerAttributesList>>
 {
@@ -362,8 +530,27 @@ ModifyPlayerResult PlayerListJSON::ModifyPlayer(const SteamID& id,
 	if (action == ModifyPlayerAction::Modified)
 	{
 		OnPlayerDataChanged(defaultMutableData);
+
+		// Transient marks aren't saved anywhere. The last seen time is, but it isn't worth
+		// a write on its own, it goes out with the next real change or compaction.
+		const bool savedChanged =
+			defaultMutableData.m_SavedAttributes != defaultMutableDataRef.m_SavedAttributes ||
+			defaultMutableData.m_Proof != defaultMutableDataRef.m_Proof;
+
 		defaultMutableDataRef = defaultMutableData;
-		SaveFiles();
+		m_Revision++;
+
+		if (!savedChanged)
+			return ModifyPlayerResult::JustModified;
+
+		// The official list is only ever edited by one person, just save the whole thing for them
+		if (m_CFGGroup.IsOfficial())
+			SaveFiles();
+		else if (defaultMutableDataRef.m_SavedAttributes.empty())
+			AppendRemovalToJournal(id); // Serialize leaves them out of playerlist.json too
+		else
+			AppendToJournal(defaultMutableDataRef);
+
 		return ModifyPlayerResult::FileSaved;
 	}
 	else if (action == ModifyPlayerAction::NoChanges)
@@ -376,6 +563,31 @@ ModifyPlayerResult PlayerListJSON::ModifyPlayer(const SteamID& id,
 	}
 }
 
+uint64_t PlayerListJSON::GetRevision() const
+{
+	UpdateLoadedLists();
+	return m_Revision + m_LoadedListsRevision;
+}
+
+uint64_t PlayerListJSON::GetLoadRevision() const
+{
+	UpdateLoadedLists();
+	return m_LoadRevision + m_LoadedListsRevision;
+}
+
+void PlayerListJSON::UpdateLoadedLists() const
+{
+	const uint8_t loadedLists =
+		(m_CFGGroup.m_OfficialList.try_get() ? 1 : 0) |
+		(m_CFGGroup.m_ThirdPartyLists.try_get() ? 2 : 0);
+
+	if (loadedLists != m_LoadedLists)
+	{
+		m_LoadedLists = loadedLists;
+		m_LoadedListsRevision++;
+	}
+}
+
 ModifyPlayerAction PlayerListJSON::OnPlayerDataChanged(PlayerListData& data)
 {
 	ModifyPlayerAction retVal = ModifyPlayerAction::NoChanges;
@@ -7,14 +7,17 @@
 #include <mh/coroutine/generator.hpp>
 #include <nlohmann/json_fwd.hpp>
 
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
 
 namespace tf2_bot_detector
 {
+	class PlayerListJournal;
 	class Settings;
 
 	/// <summary>
@@ -121,6 +124,7 @@ namespace tf2_bot_detector
 	enum class ModifyPlayerResult
 	{
 		NoChanges,
+		JustModified, // Only the in-memory data changed (transient attributes, last seen)
 		FileSaved,
 	};
 
@@ -171,6 +175,7 @@ namespace tf2_bot_detector
 	{
 	public:
 		PlayerListJSON(const Settings& settings);
+		~PlayerListJSON();
 
 		bool LoadFiles();
 		void SaveFiles() const;
@@ -180,6 +185,9 @@ namespace tf2_bot_detector
 		mh::generator<std::pair<const ConfigFileName&, PlayerAttributesList>>
 			FindPlayerAttributes(const SteamID& id, AttributePersistence persistence = AttributePersistence::Any) const;
 		PlayerMarks GetPlayerAttributes(const SteamID& id) const;
+
+		// Every entry in every loaded list. The same player can show up more than once.
+		mh::generator<std::pair<const ConfigFileName&, const PlayerListData&>> GetAllPlayerData() const;
 		PlayerMarks HasPlayerAttributes(const SteamID& id, const PlayerAttributesList& attributes,
 			AttributePersistence persistence = AttributePersistence::Any) const;
 
@@ -188,11 +196,39 @@ namespace tf2_bot_detector
 
 		size_t GetPlayerCount() const { return m_CFGGroup.size(); }
 
+		// Changes whenever anyone's attributes might have changed (modified, reloaded,
+		// or one of the async lists finished loading). Used to invalidate caches.
+		uint64_t GetRevision() const;
+
+		// Like GetRevision, but doesn't change for ModifyPlayer. For caches that keep track
+		// of the players they modified themselves.
+		uint64_t GetLoadRevision() const;
+
 	private:
 		const Settings* m_Settings = nullptr;
 
+		uint64_t m_Revision = 0;
+		uint64_t m_LoadRevision = 0;
+		mutable uint64_t m_LoadedListsRevision = 0;
+		mutable uint8_t m_LoadedLists = 0;
+		void UpdateLoadedLists() const;
+
 		ModifyPlayerAction OnPlayerDataChanged(PlayerListData& data);
 
+		// Edits to the user list go here instead of rewriting playerlist.json every time.
+		// Every so often, playerlist.json is rewritten in the background from a snapshot.
+		std::unique_ptr<PlayerListJournal> m_Journal;
+		std::filesystem::path m_CompactionPath;
+		clock_t::time_point m_LastCompactionTime{};
+		std::atomic<bool> m_IsCompacting = false; // Regular saves of playerlist.json don't count
+		void ReplayJournal();
+		void AppendToJournal(const PlayerListData& data);
+		void AppendRemovalToJournal(const SteamID& id);
+		void AppendToJournal(const std::function<void()>& append);
+		bool IsCompacting() const;
+		void StartCompaction();
+		void WaitForCompaction() const;
+
 		using PlayerMap_t = std::map<SteamID, PlayerListData>;
 
 		struct PlayerListFile final : public SharedConfigFileBase
@@ -206,6 +242,9 @@ namespace tf2_bot_detector
 			PlayerListData& GetOrAddPlayer(const SteamID& id);
 
 			PlayerMap_t m_Players;
+
+		protected:
+			std::shared_ptr<const ConfigFileBase> CloneForSave() const override { return std::make_shared<PlayerListFile>(*this); }
 		};
 
 		static constexpr int PLAYERLIST_SCHEMA_VERSION = 3;
@@ -227,6 +266,9 @@ namespace tf2_bot_detector
 		friend class PlayerListManagementWindow;
 	};
 
+	void to_json(nlohmann::json& j, const PlayerListData& d);
+	void from_json(const nlohmann::json& j, PlayerListData& d);
+
 	std::string to_string(const PlayerAttribute& d);
 	void to_json(nlohmann::json& j, const PlayerAttribute& d);
 	void from_json(const nlohmann::json& j, PlayerAttribute& d);
@@ -0,0 +1,152 @@
+#include "PlayerListJournal.h"
+#include "PlayerListJSON.h"
+#include "Log.h"
+
+#include <nlohmann/json.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace tf2_bot_detector;
+
+PlayerListJournal::PlayerListJournal(std::filesystem::path path) :
+	m_Path(std::move(path))
+{
+	m_RotatedPath = m_Path;
+	m_RotatedPath += ".old";
+}
+
+namespace
+{
+	constexpr char REMOVED_KEY[] = "removed";
+}
+
+void PlayerListJournal::Append(const PlayerListData& data)
+{
+	AppendLine(nlohmann::json(data).dump(-1, ' ', false, nlohmann::detail::error_handler_t::ignore));
+}
+
+void PlayerListJournal::AppendRemoval(const SteamID& id)
+{
+	AppendLine(nlohmann::json{ { "steamid", id }, { REMOVED_KEY, true } }.dump());
+}
+
+void PlayerListJournal::AppendLine(std::string line)
+{
+	line += '\n';
+
+	if (!m_File.is_open())
+	{
+		if (auto folderPath = m_Path.parent_path(); std::filesystem::create_directories(folderPath))
+			DebugLog("Created one or more directories in the path {}", folderPath);
+
+		// Don't glue this entry onto the end of a torn one
+		if (std::error_code ec; std::filesystem::file_size(m_Path, ec) > 0 && !ec)
+		{
+			std::ifstream existing(m_Path, std::ios::binary);
+			existing.seekg(-1, std::ios::end);
+			if (existing.get() != '\n')
+				line.insert(line.begin(), '\n');
+		}
+
+		m_File.open(m_Path, std::ios::binary | std::ios::app);
+	}
+
+	// One write + flush per edit, so a crash loses at most the line being written
+	m_File.write(line.data(), line.size());
+	m_File.flush();
+
+	if (!m_File)
+	{
+		// Start over with a fresh stream next time
+		m_File.close();
+		m_File.clear();
+		throw std::runtime_error(mh::format("Failed to append to {}", m_Path));
+	}
+
+	m_EntryCount++;
+}
+
+size_t PlayerListJournal::Replay(const ReplayFunc& func, const ReplayRemovalFunc& removed)
+{
+	size_t count = ReplayFile(m_RotatedPath, func, removed);
+
+	m_EntryCount = ReplayFile(m_Path, func, removed);
+	count += m_EntryCount;
+
+	return count;
+}
+
+size_t PlayerListJournal::ReplayFile(const std::filesystem::path& path,
+	const ReplayFunc& func, const ReplayRemovalFunc& removed) const
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.good())
+		return 0;
+
+	size_t count = 0;
+	size_t lineNumber = 0;
+	for (std::string line; std::getline(file, line); )
+	{
+		lineNumber++;
+		if (line.empty())
+			continue;
+
+		try
+		{
+			const auto json = nlohmann::json::parse(line);
+			const SteamID steamID = json.at("steamid");
+			if (json.value(REMOVED_KEY, false))
+			{
+				removed(steamID);
+			}
+			else
+			{
+				PlayerListData data(steamID);
+				json.get_to(data);
+				func(std::move(data));
+			}
+
+			count++;
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Skipping unreadable entry on line {} of {}", lineNumber, path);
+		}
+	}
+
+	return count;
+}
+
+void PlayerListJournal::Rotate()
+{
+	if (m_File.is_open())
+		m_File.close();
+
+	m_EntryCount = 0;
+
+	if (!std::filesystem::exists(m_Path))
+		return;
+
+	if (std::filesystem::file_size(m_Path) == 0)
+	{
+		std::filesystem::remove(m_Path);
+		return;
+	}
+
+	if (!std::filesystem::exists(m_RotatedPath))
+	{
+		std::filesystem::rename(m_Path, m_RotatedPath);
+		return;
+	}
+
+	// The last compaction never finished, so the old entries aren't in playerlist.json yet. Keep them.
+	{
+		std::ifstream current(m_Path, std::ios::binary);
+		std::ofstream rotated(m_RotatedPath, std::ios::binary | std::ios::app);
+		rotated.exceptions(std::ios::badbit | std::ios::failbit);
+		rotated << current.rdbuf();
+	}
+
+	std::filesystem::remove(m_Path);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+namespace tf2_bot_detector
+{
+	struct PlayerListData;
+	class SteamID;
+
+	/// <summary>
+	/// Append-only log of edits to the user's playerlist, so marking someone costs one short
+	/// line of I/O instead of rewriting the whole playerlist.json. Each line is the complete
+	/// json for one player (or a tombstone, once a player has nothing saved left), so replaying
+	/// is "last line for each player wins," and replaying something that already made it into
+	/// playerlist.json is harmless.
+	///
+	/// Compacting rolls the journal over into a .old file next to it. That file can be deleted
+	/// once a playerlist.json containing everything in it has been written. Until then, it is
+	/// replayed (before the current journal) on load.
+	/// </summary>
+	class PlayerListJournal final
+	{
+	public:
+		explicit PlayerListJournal(std::filesystem::path path);
+
+		void Append(const PlayerListData& data);
+
+		// The player no longer belongs in playerlist.json at all.
+		void AppendRemoval(const SteamID& id);
+
+		// Entries appended (or replayed from the current journal) since the last Rotate().
+		size_t GetEntryCount() const { return m_EntryCount; }
+
+		using ReplayFunc = std::function<void(PlayerListData&& data)>;
+		using ReplayRemovalFunc = std::function<void(const SteamID& id)>;
+
+		/// <summary>
+		/// Calls func (or removed, for tombstones) for every entry in the rolled over journal,
+		/// then the current one. Unreadable lines (a torn write at the end of the file) are
+		/// logged and skipped.
+		/// </summary>
+		/// <returns>The number of entries replayed.</returns>
+		size_t Replay(const ReplayFunc& func, const ReplayRemovalFunc& removed);
+
+		// Moves everything in the current journal into the rolled over one.
+		void Rotate();
+		const std::filesystem::path& GetRotatedPath() const { return m_RotatedPath; }
+
+	private:
+		std::filesystem::path m_Path;
+		std::filesystem::path m_RotatedPath;
+
+		std::ofstream m_File;
+		size_t m_EntryCount = 0;
+
+		void AppendLine(std::string line);
+		size_t ReplayFile(const std::filesystem::path& path, const ReplayFunc& func, const ReplayRemovalFunc& removed) const;
+	};
+}
@@ -105,6 +105,9 @@ namespace tf2_bot_detector
 			size_t size() const { return m_Rules.size(); }
 
 			RuleList_t m_Rules;
+
+		protected:
+			std::shared_ptr<const ConfigFileBase> CloneForSave() const override { return std::make_shared<RuleFile>(*this); }
 		};
 
 		static constexpr int RULES_SCHEMA_VERSION = 3;
@@ -415,6 +415,21 @@ catch (...)
 	throw;
 }
 
+Settings::Settings(const Settings& other, SaveCopyTag) :
+	AutoDetectedSettings(other),
+	GeneralSettings(other),
+	ConfigFileBase(other),
+	m_AllowInternetUsage(other.m_AllowInternetUsage),
+	m_GotoProfileSites(other.m_GotoProfileSites),
+	m_Logging(other.m_Logging),
+	m_Discord(other.m_Discord),
+	m_UIState(other.m_UIState),
+	m_Theme(other.m_Theme),
+	m_TF2Interface(other.m_TF2Interface),
+	m_Mods(other.m_Mods)
+{
+}
+
 Settings::~Settings() = default;
 
 void Settings::LoadFile() try
@@ -429,7 +444,8 @@ catch (...)
 
 bool Settings::SaveFile() const try
 {
-	return !ConfigFileBase::SaveFile("cfg/settings.json");
+	// Called from just about every settings checkbox, so don't write it on the UI thread
+	return !ConfigFileBase::QueueSave("cfg/settings.json");
 }
 catch (...)
 {
@@ -437,6 +453,11 @@ catch (...)
 	return false;
 }
 
+std::shared_ptr<const ConfigFileBase> Settings::CloneForSave() const
+{
+	return std::shared_ptr<const Settings>(new Settings(*this, SaveCopyTag{}));
+}
+
 Settings::Unsaved::~Unsaved()
 {
 }
@@ -561,6 +582,8 @@ void Settings::Deserialize(const nlohmann::json& json)
 		try_get_to_defaulted(*found, m_AutoVotekickDelay, "auto_votekick_delay", DEFAULTS.m_AutoVotekickDelay);
 		try_get_to_defaulted(*found, m_AutoMark, "auto_mark", DEFAULTS.m_AutoMark);
 		try_get_to_defaulted(*found, m_LazyLoadAPIData, "lazy_load_api_data", DEFAULTS.m_LazyLoadAPIData);
+		try_get_to_defaulted(*found, m_PlayerHistoryMaxPlayers, "player_history_max_players", DEFAULTS.m_PlayerHistoryMaxPlayers);
+		try_get_to_defaulted(*found, m_PlayerHistoryMaxIdleMinutes, "player_history_max_idle_minutes", DEFAULTS.m_PlayerHistoryMaxIdleMinutes);
 		try_get_to_defaulted(*found, m_ConfigCompatibilityMode, "config_compatibility_mode", DEFAULTS.m_ConfigCompatibilityMode);
 
 		{
@@ -648,6 +671,8 @@ void Settings::Serialize(nlohmann::json& json) const
 				{ "auto_votekick_delay", m_AutoVotekickDelay },
 				{ "auto_mark", m_AutoMark },
 				{ "lazy_load_api_data", m_LazyLoadAPIData },
+				{ "player_history_max_players", m_PlayerHistoryMaxPlayers },
+				{ "player_history_max_idle_minutes", m_PlayerHistoryMaxIdleMinutes },
 				{ "config_compatibility_mode", m_ConfigCompatibilityMode },
 			}
 		},
@@ -165,6 +165,17 @@ namespace tf2_bot_detector
 
 		bool m_LazyLoadAPIData = true;
 
+		/// <summary>
+		/// Players who have left are forgotten (moved to the session history in the temp db) once
+		/// there are more than this many players in memory, least recently seen first...
+		/// </summary>
+		uint32_t m_PlayerHistoryMaxPlayers = 256;
+		/// <summary>
+		/// ...or once they haven't been seen for this long.
+		/// </summary>
+		uint32_t m_PlayerHistoryMaxIdleMinutes = 30;
+		auto GetPlayerHistoryMaxIdleTime() const { return std::chrono::minutes(m_PlayerHistoryMaxIdleMinutes); }
+
 		bool m_ConfigCompatibilityMode = true;
 
 		std::optional<ReleaseChannel> m_ReleaseChannel;
@@ -176,6 +187,9 @@ namespace tf2_bot_detector
 		std::string GetSteamAPIKey() const override;
 		void SetSteamAPIKey(std::string key) override;
 
+		// Made up keys (the replay harness) have nothing to hide, so they aren't registered as log secrets.
+		void SetFakeSteamAPIKey(std::string key) { m_SteamAPIKey = std::move(key); }
+
 		SteamAPIMode m_SteamAPIMode = SteamAPIMode::Disabled;
 		SteamAPIMode GetSteamAPIMode() const override { return m_SteamAPIMode; }
 
@@ -225,6 +239,9 @@ namespace tf2_bot_detector
 		std::optional<bool> m_AllowInternetUsage;
 		std::shared_ptr<const IHTTPClient> GetHTTPClient() const;
 
+		// Use this client instead of creating a real one (the replay harness serves recorded responses)
+		void SetHTTPClient(std::shared_ptr<IHTTPClient> client) { m_HTTPClient = std::move(client); }
+
 		std::vector<GotoProfileSite> m_GotoProfileSites;
 
 		struct Logging
@@ -303,6 +320,11 @@ namespace tf2_bot_detector
 		void Serialize(nlohmann::json& json) const override;
 		void PostLoad(bool deserialized) override;
 
+		// Everything Serialize() looks at, without loading anything or copying m_Unsaved
+		struct SaveCopyTag {};
+		Settings(const Settings& other, SaveCopyTag);
+		std::shared_ptr<const ConfigFileBase> CloneForSave() const override;
+
 		void AddDefaultGotoProfileSites();
 
 		mutable std::shared_ptr<IHTTPClient> m_HTTPClient;
@@ -0,0 +1,37 @@
+#include "ConsoleLinePool.h"
+
+#include <cassert>
+
+using namespace tf2_bot_detector;
+
+FixedSizeBlockPool::FixedSizeBlockPool(size_t blockSize) :
+	m_BlockSize(blockSize)
+{
+	assert(m_BlockSize >= sizeof(FreeBlock));
+	assert((m_BlockSize % alignof(FreeBlock)) == 0);
+}
+
+void* FixedSizeBlockPool::Allocate()
+{
+	std::lock_guard lock(m_Mutex);
+
+	if (!m_FreeList)
+	{
+		auto chunk = static_cast<std::byte*>(::operator new(m_BlockSize * BLOCKS_PER_CHUNK));
+		for (size_t i = BLOCKS_PER_CHUNK; i-- > 0; )
+			m_FreeList = new (chunk + (i * m_BlockSize)) FreeBlock{ m_FreeList };
+	}
+
+	FreeBlock* block = m_FreeList;
+	m_FreeList = block->m_Next;
+	return block;
+}
+
+void FixedSizeBlockPool::Free(void* block) noexcept
+{
+	if (!block)
+		return;
+
+	std::lock_guard lock(m_Mutex);
+	m_FreeList = new (block) FreeBlock{ m_FreeList };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Free list of same-sized blocks, carved out of bigger chunks that are never given back.
+	/// It only ever grows to the most blocks that were in use at once, which for console
+	/// lines is however many are being kept around for printing plus a handful in flight.
+	/// </summary>
+	class FixedSizeBlockPool final
+	{
+	public:
+		explicit FixedSizeBlockPool(size_t blockSize);
+		FixedSizeBlockPool(const FixedSizeBlockPool&) = delete;
+		FixedSizeBlockPool& operator=(const FixedSizeBlockPool&) = delete;
+
+		void* Allocate();
+		void Free(void* block) noexcept;
+
+		template<size_t BlockSize>
+		static FixedSizeBlockPool& Get()
+		{
+			// Intentionally leaked, lines can be kept alive by other statics until after exit()
+			static FixedSizeBlockPool* s_Pool = new FixedSizeBlockPool(BlockSize);
+			return *s_Pool;
+		}
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* m_Next;
+		};
+
+		static constexpr size_t BLOCKS_PER_CHUNK = 64;
+
+		const size_t m_BlockSize;
+		std::mutex m_Mutex;  // Lines are parsed on a worker thread by WorldState::AddConsoleOutputLine
+		FreeBlock* m_FreeList = nullptr;
+	};
+
+	/// <summary>
+	/// Allocator for std::allocate_shared that hands out single objects from a FixedSizeBlockPool,
+	/// shared by everything that rounds up to the same size.
+	/// </summary>
+	template<typename T>
+	class ConsoleLineAllocator final
+	{
+	public:
+		using value_type = T;
+
+		ConsoleLineAllocator() = default;
+		template<typename U>
+		ConsoleLineAllocator(const ConsoleLineAllocator<U>&) noexcept {}
+
+		T* allocate(size_t n)
+		{
+			if (n != 1)
+				return std::allocator<T>{}.allocate(n);
+
+			return static_cast<T*>(GetPool().Allocate());
+		}
+		void deallocate(T* p, size_t n) noexcept
+		{
+			if (n != 1)
+				return std::allocator<T>{}.deallocate(p, n);
+
+			GetPool().Free(p);
+		}
+
+		template<typename U>
+		bool operator==(const ConsoleLineAllocator<U>&) const noexcept { return true; }
+
+	private:
+		static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+		static_assert(alignof(T) <= BLOCK_ALIGNMENT);
+		static constexpr size_t BLOCK_SIZE = (sizeof(T) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+
+		static FixedSizeBlockPool& GetPool() { return FixedSizeBlockPool::Get<BLOCK_SIZE>(); }
+	};
+}
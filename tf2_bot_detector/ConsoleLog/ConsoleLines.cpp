@@ -84,6 +84,15 @@ void IConsoleLine::AddTypeData(ConsoleLineTypeData data)
 	GetTypeData().push_back(std::move(data));
 }
 
+auto IConsoleLine::GetRegisteredTypes() -> std::vector<RegisteredType>
+{
+	std::vector<RegisteredType> retVal;
+	for (const auto& data : GetTypeData())
+		retVal.push_back({ data.m_TryParseFunc, data.m_TypeInfo, data.m_AutoParse });
+
+	return retVal;
+}
+
 #ifdef TF2BD_ENABLE_TESTS
 #include <catch2/catch.hpp>
 
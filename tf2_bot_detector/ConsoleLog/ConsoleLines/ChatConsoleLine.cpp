@@ -30,11 +30,38 @@ using namespace std::string_view_literals;
 
 ChatConsoleLine::ChatConsoleLine(time_point_t timestamp, std::string playerName, std::string message,
 	bool isDead, bool isTeam, bool isSelf, TeamShareResult teamShareResult, SteamID id) :
-	ConsoleLineBase(timestamp), m_PlayerName(std::move(playerName)), m_Message(std::move(message)),
-	m_IsDead(isDead), m_IsTeam(isTeam), m_IsSelf(isSelf), m_TeamShareResult(teamShareResult), m_PlayerSteamID(id)
+	ConsoleLineBase(timestamp), m_OwnedText(std::move(playerName)), m_PlayerSteamID(id), m_TeamShareResult(teamShareResult),
+	m_IsDead(isDead), m_IsTeam(isTeam), m_IsSelf(isSelf), m_OwnsText(true)
 {
-	m_PlayerName.shrink_to_fit();
-	m_Message.shrink_to_fit();
+	const size_t nameLength = m_OwnedText.size();
+	m_OwnedText.append(message);
+
+	const std::string_view owned(m_OwnedText);
+	m_PlayerName = owned.substr(0, nameLength);
+	m_Message = owned.substr(nameLength);
+}
+
+ChatConsoleLine::ChatConsoleLine(borrow_t, time_point_t timestamp, std::string_view playerName, std::string_view message,
+	bool isDead, bool isTeam, bool isSelf, TeamShareResult teamShareResult, SteamID id) :
+	ConsoleLineBase(timestamp), m_PlayerName(playerName), m_Message(message), m_PlayerSteamID(id), m_TeamShareResult(teamShareResult),
+	m_IsDead(isDead), m_IsTeam(isTeam), m_IsSelf(isSelf), m_OwnsText(false)
+{
+}
+
+void ChatConsoleLine::TakeOwnership()
+{
+	if (m_OwnsText)
+		return;
+
+	// One allocation for both
+	m_OwnedText.reserve(m_PlayerName.size() + m_Message.size());
+	m_OwnedText.append(m_PlayerName);
+	m_OwnedText.append(m_Message);
+
+	const std::string_view owned(m_OwnedText);
+	m_Message = owned.substr(m_PlayerName.size());
+	m_PlayerName = owned.substr(0, m_PlayerName.size());
+	m_OwnsText = true;
 }
 
 // this is a bad fix, but we can't really access PlayerExtraData (+ the fact that they will be destroyed when the player leave will screw over a lot of stuff)
@@ -62,7 +89,7 @@ std::shared_ptr<ChatConsoleLine> ChatConsoleLine::TryParse(const std::string_vie
 
 	if (svmatch result; std::regex_match(text.begin(), text.end(), result, flexible ? s_RegexFlexible : s_Regex))
 	{
-		return std::make_shared<ChatConsoleLine>(timestamp, result[3].str(), result[4].str(),
+		return ChatConsoleLine::Create(timestamp, result[3].str(), result[4].str(),
 			result[1].matched, result[2].matched);
 	}
 
@@ -107,7 +134,7 @@ static void ProcessChatMessage(const ChatConsoleLine& msgLine, const Settings::T
 
 	PrintLHS();
 
-	const auto& msg = msgLine.GetMessage();
+	const auto msg = msgLine.GetMessage();
 	const ImVec4 msgColor(0.8f, 0.8f, 0.8f, 1.0f);
 	if (msg.find('\n') == msg.npos)
 	{
@@ -189,11 +216,12 @@ void ChatConsoleLine::Print(const PrintArgs& args) const
 			ImGui::SetClipboardText(fullText.c_str());
 		}
 
-		tf2_bot_detector::DrawPlayerContextCopyMenu(m_PlayerName.c_str(), m_PlayerSteamID);
+		const std::string playerName(m_PlayerName);
+		tf2_bot_detector::DrawPlayerContextCopyMenu(playerName.c_str(), m_PlayerSteamID);
 		tf2_bot_detector::DrawPlayerContextGoToMenu(args.m_Settings, m_PlayerSteamID);
 
 		if (m_PlayerSteamID.IsValid()) {
-			args.m_MainWindow.DrawPlayerContextMarkMenu(m_PlayerSteamID, m_PlayerName, m_PendingMarkReason);
+			args.m_MainWindow.DrawPlayerContextMarkMenu(m_PlayerSteamID, playerName, m_PendingMarkReason);
 		}
 		else {
 			ImGui::TextFmt(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Marking Unavailable");
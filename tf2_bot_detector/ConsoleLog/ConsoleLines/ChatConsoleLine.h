@@ -11,6 +11,7 @@
 
 #include <array>
 #include <memory>
+#include <string>
 #include <string_view>
 
 namespace tf2_bot_detector
@@ -31,14 +32,30 @@ namespace tf2_bot_detector
 	public:
 		ChatConsoleLine(time_point_t timestamp, std::string playerName, std::string message, bool isDead,
 			bool isTeam, bool isSelf, TeamShareResult teamShare, SteamID id);
+
+		// playerName and message are only referenced, they must stay alive until TakeOwnership() is called
+		struct borrow_t {};
+		ChatConsoleLine(borrow_t, time_point_t timestamp, std::string_view playerName, std::string_view message, bool isDead,
+			bool isTeam, bool isSelf, TeamShareResult teamShare, SteamID id);
+
+		// Copies would keep pointing into the original's m_OwnedText
+		ChatConsoleLine(const ChatConsoleLine&) = delete;
+		ChatConsoleLine& operator=(const ChatConsoleLine&) = delete;
+
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
 		//static std::shared_ptr<ChatConsoleLine> TryParseFlexible(const std::string_view& text, time_point_t timestamp);
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::Chat; }
 		void Print(const PrintArgs& args) const override;
+		void TakeOwnership() override;
 
-		const std::string& GetPlayerName() const { return m_PlayerName; }
-		const std::string& GetMessage() const { return m_Message; }
+		/// <summary>
+		/// Until TakeOwnership() is called, these point into the console output that is being
+		/// parsed. They are only valid while the line is being broadcast to listeners; copy
+		/// them if they're needed later.
+		/// </summary>
+		std::string_view GetPlayerName() const { return m_PlayerName; }
+		std::string_view GetMessage() const { return m_Message; }
 		const SteamID getSteamID() const { return m_PlayerSteamID; }
 		bool IsDead() const { return m_IsDead; }
 		bool IsTeam() const { return m_IsTeam; }
@@ -48,13 +65,15 @@ namespace tf2_bot_detector
 	private:
 		//static std::shared_ptr<ChatConsoleLine> TryParse(const std::string_view& text, time_point_t timestamp, bool flexible);
 
-		std::string m_PlayerName;
-		std::string m_Message;
+		std::string_view m_PlayerName;
+		std::string_view m_Message;
+		std::string m_OwnedText;  // m_PlayerName and m_Message point into this once m_OwnsText is set
 		SteamID m_PlayerSteamID;
 		TeamShareResult m_TeamShareResult;
 		bool m_IsDead : 1;
 		bool m_IsTeam : 1;
 		bool m_IsSelf : 1;
+		bool m_OwnsText : 1;
 
 		// this really shouldn't be here, but can't think of a better solution atm.
 		static std::string m_PendingMarkReason;
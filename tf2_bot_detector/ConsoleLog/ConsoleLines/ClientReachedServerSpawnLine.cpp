@@ -15,7 +15,7 @@ using namespace std::string_view_literals;
 std::shared_ptr<IConsoleLine> ClientReachedServerSpawnLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "Client reached server_spawn."sv)
-		return std::make_shared<ClientReachedServerSpawnLine>(args.m_Timestamp); 
+		return ClientReachedServerSpawnLine::Create(args.m_Timestamp); 
 
 	return nullptr;
 }
@@ -35,12 +35,12 @@ std::shared_ptr<IConsoleLine> ConfigExecLine::TryParse(const ConsoleLineTryParse
 	// Success
 	constexpr auto prefix = "execing "sv;
 	if (args.m_Text.starts_with(prefix))
-		return std::make_shared<ConfigExecLine>(args.m_Timestamp, std::string(args.m_Text.substr(prefix.size())), true);
+		return ConfigExecLine::Create(args.m_Timestamp, std::string(args.m_Text.substr(prefix.size())), true);
 
 	// Failure
 	static const std::regex s_Regex(R"regex('(.*)' not present; not executing\.)regex", std::regex::optimize);
 	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-		return std::make_shared<ConfigExecLine>(args.m_Timestamp, result[1].str(), false);
+		return ConfigExecLine::Create(args.m_Timestamp, result[1].str(), false);
 
 	return nullptr;
 }
@@ -35,13 +35,13 @@ std::shared_ptr<IConsoleLine> ConnectingLine::TryParse(const ConsoleLineTryParse
 	{
 		static const std::regex s_ConnectingRegex(R"regex(Connecting to( matchmaking server)? (.*?)(\.\.\.)?)regex", std::regex::optimize);
 		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_ConnectingRegex))
-			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[2].str(), result[1].matched, false);
+			return ConnectingLine::Create(args.m_Timestamp, result[2].str(), result[1].matched, false);
 	}
 
 	{
 		static const std::regex s_RetryingRegex(R"regex(Retrying (.*)\.\.\.)regex", std::regex::optimize);
 		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_RetryingRegex))
-			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[1].str(), false, true);
+			return ConnectingLine::Create(args.m_Timestamp, result[1].str(), false, true);
 	}
 
 	return nullptr;
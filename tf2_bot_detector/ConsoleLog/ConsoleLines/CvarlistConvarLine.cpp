@@ -26,7 +26,7 @@ std::shared_ptr<IConsoleLine> CvarlistConvarLine::TryParse(const ConsoleLineTryP
 	{
 		float value;
 		from_chars_throw(result[2], value);
-		return std::make_shared<CvarlistConvarLine>(args.m_Timestamp, result[1].str(), value, result[3].str(), result[4].str());
+		return CvarlistConvarLine::Create(args.m_Timestamp, result[1].str(), value, result[3].str(), result[4].str());
 	}
 
 	return nullptr;
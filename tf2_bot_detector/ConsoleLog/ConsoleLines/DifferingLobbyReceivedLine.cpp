@@ -55,7 +55,7 @@ std::shared_ptr<IConsoleLine> DifferingLobbyReceivedLine::TryParse(const Console
 		from_chars_throw(result[8], hasLobby);
 		from_chars_throw(result[9], assignedMatchEnded);
 
-		return std::make_shared<DifferingLobbyReceivedLine>(args.m_Timestamp, newLobby, currentLobby,
+		return DifferingLobbyReceivedLine::Create(args.m_Timestamp, newLobby, currentLobby,
 			connectedToMatchServer, hasLobby, assignedMatchEnded);
 	}
 
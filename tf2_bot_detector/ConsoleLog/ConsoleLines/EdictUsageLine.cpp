@@ -39,7 +39,7 @@ std::shared_ptr<IConsoleLine> EdictUsageLine::TryParse(const ConsoleLineTryParse
 		uint16_t usedEdicts, totalEdicts;
 		from_chars_throw(result[1], usedEdicts);
 		from_chars_throw(result[2], totalEdicts);
-		return std::make_shared<EdictUsageLine>(args.m_Timestamp, usedEdicts, totalEdicts);
+		return EdictUsageLine::Create(args.m_Timestamp, usedEdicts, totalEdicts);
 	}
 
 	return nullptr;
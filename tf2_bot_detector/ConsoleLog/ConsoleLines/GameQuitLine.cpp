@@ -28,7 +28,7 @@ using namespace std::string_view_literals;
 std::shared_ptr<IConsoleLine> GameQuitLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "CTFGCClientSystem::ShutdownGC"sv)
-		return std::make_shared<GameQuitLine>(args.m_Timestamp);
+		return GameQuitLine::Create(args.m_Timestamp);
 
 	return nullptr;
 }
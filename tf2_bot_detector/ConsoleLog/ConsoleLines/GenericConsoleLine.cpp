@@ -36,7 +36,7 @@ GenericConsoleLine::GenericConsoleLine(time_point_t timestamp, std::string text)
 
 std::shared_ptr<IConsoleLine> GenericConsoleLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	return std::make_shared<GenericConsoleLine>(args.m_Timestamp, std::string(args.m_Text));
+	return GenericConsoleLine::Create(args.m_Timestamp, std::string(args.m_Text));
 }
 
 void GenericConsoleLine::Print(const PrintArgs& args) const
@@ -28,7 +28,7 @@ using namespace std::string_view_literals;
 std::shared_ptr<IConsoleLine> HostNewGameLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "---- Host_NewGame ----"sv)
-		return std::make_shared<HostNewGameLine>(args.m_Timestamp);
+		return HostNewGameLine::Create(args.m_Timestamp);
 
 	return nullptr;
 }
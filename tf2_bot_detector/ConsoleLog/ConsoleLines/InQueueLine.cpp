@@ -62,7 +62,7 @@ std::shared_ptr<IConsoleLine> InQueueLine::TryParse(const ConsoleLineTryParseArg
 			}
 		}
 
-		return std::make_shared<InQueueLine>(args.m_Timestamp, matchGroup, startTime);
+		return InQueueLine::Create(args.m_Timestamp, matchGroup, startTime);
 	}
 
 	return nullptr;
@@ -51,7 +51,7 @@ std::shared_ptr<IConsoleLine> KillNotificationLine::TryParse(const ConsoleLineTr
 		auto attacker = args.m_World.FindSteamIDForName(result[1].str());
 		auto victim = args.m_World.FindSteamIDForName(result[2].str());
 
-		return std::make_shared<KillNotificationLine>(args.m_Timestamp,
+		return KillNotificationLine::Create(args.m_Timestamp,
 			result[1].str(), attacker.has_value() ? attacker.value() : SteamID(),
 			result[2].str(), victim.has_value() ? victim.value() : SteamID(),
 			result[3].str(), result[4].matched
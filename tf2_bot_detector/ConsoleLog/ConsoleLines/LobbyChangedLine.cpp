@@ -34,11 +34,11 @@ LobbyChangedLine::LobbyChangedLine(time_point_t timestamp, LobbyChangeType type)
 std::shared_ptr<IConsoleLine> LobbyChangedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "Lobby created"sv)
-		return std::make_shared<LobbyChangedLine>(args.m_Timestamp, LobbyChangeType::Created);
+		return LobbyChangedLine::Create(args.m_Timestamp, LobbyChangeType::Created);
 	else if (args.m_Text == "Lobby updated"sv)
-		return std::make_shared<LobbyChangedLine>(args.m_Timestamp, LobbyChangeType::Updated);
+		return LobbyChangedLine::Create(args.m_Timestamp, LobbyChangeType::Updated);
 	else if (args.m_Text == "Lobby destroyed"sv)
-		return std::make_shared<LobbyChangedLine>(args.m_Timestamp, LobbyChangeType::Destroyed);
+		return LobbyChangedLine::Create(args.m_Timestamp, LobbyChangeType::Destroyed);
 
 	return nullptr;
 }
@@ -45,7 +45,7 @@ std::shared_ptr<IConsoleLine> LobbyHeaderLine::TryParse(const ConsoleLineTryPars
 		if (!mh::from_chars(std::string_view(&*result[3].first, result[3].length()), pendingCount))
 			throw std::runtime_error("Failed to parse lobby pending member count");
 
-		return std::make_shared<LobbyHeaderLine>(args.m_Timestamp, memberCount, pendingCount);
+		return LobbyHeaderLine::Create(args.m_Timestamp, memberCount, pendingCount);
 	}
 
 	return nullptr;
@@ -64,7 +64,7 @@ std::shared_ptr<IConsoleLine> LobbyMemberLine::TryParse(const ConsoleLineTryPars
 		else
 			throw std::runtime_error("Unknown lobby member type");
 
-		return std::make_shared<LobbyMemberLine>(args.m_Timestamp, member);
+		return LobbyMemberLine::Create(args.m_Timestamp, member);
 	}
 
 	return nullptr;
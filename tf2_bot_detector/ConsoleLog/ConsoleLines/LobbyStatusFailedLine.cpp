@@ -25,7 +25,7 @@ using namespace std::string_view_literals;
 std::shared_ptr<IConsoleLine> LobbyStatusFailedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "Failed to find lobby shared object"sv)
-		return std::make_shared<LobbyStatusFailedLine>(args.m_Timestamp);
+		return LobbyStatusFailedLine::Create(args.m_Timestamp);
 
 	return nullptr;
 }
@@ -47,7 +47,7 @@ std::shared_ptr<IConsoleLine> PartyHeaderLine::TryParse(const ConsoleLineTryPars
 
 		party.m_LeaderID = SteamID(result[3].str());
 
-		return std::make_shared<PartyHeaderLine>(args.m_Timestamp, std::move(party));
+		return PartyHeaderLine::Create(args.m_Timestamp, std::move(party));
 	}
 
 	return nullptr;
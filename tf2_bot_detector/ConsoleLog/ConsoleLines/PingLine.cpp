@@ -38,7 +38,7 @@ std::shared_ptr<IConsoleLine> PingLine::TryParse(const ConsoleLineTryParseArgs&
 	{
 		uint16_t ping;
 		from_chars_throw(result[1], ping);
-		return std::make_shared<PingLine>(args.m_Timestamp, ping, result[2].str());
+		return PingLine::Create(args.m_Timestamp, ping, result[2].str());
 	}
 
 	return nullptr;
@@ -59,7 +59,7 @@ std::shared_ptr<IConsoleLine> QueueStateChangeLine::TryParse(const ConsoleLineTr
 	for (const auto& match : QUEUE_STATE_CHANGE_TYPES)
 	{
 		if (args.m_Text == match.m_String)
-			return std::make_shared<QueueStateChangeLine>(args.m_Timestamp, match.m_QueueType, match.m_StateChange);
+			return QueueStateChangeLine::Create(args.m_Timestamp, match.m_QueueType, match.m_StateChange);
 	}
 
 	return nullptr;
@@ -41,7 +41,7 @@ std::shared_ptr<IConsoleLine> SVCUserMessageLine::TryParse(const ConsoleLineTryP
 
 		from_chars_throw(result[3], bytes);
 
-		return std::make_shared<SVCUserMessageLine>(args.m_Timestamp, result[1].str(), UserMessageType(type), bytes);
+		return SVCUserMessageLine::Create(args.m_Timestamp, result[1].str(), UserMessageType(type), bytes);
 	}
 
 	return nullptr;
@@ -36,7 +36,7 @@ std::shared_ptr<IConsoleLine> ServerDroppedPlayerLine::TryParse(const ConsoleLin
 
 	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
 	{
-		return std::make_shared<ServerDroppedPlayerLine>(args.m_Timestamp, result[1].str(), result[2].str());
+		return ServerDroppedPlayerLine::Create(args.m_Timestamp, result[1].str(), result[2].str());
 	}
 
 	return nullptr;
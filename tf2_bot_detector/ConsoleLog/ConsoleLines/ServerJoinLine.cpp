@@ -48,7 +48,7 @@ std::shared_ptr<IConsoleLine> ServerJoinLine::TryParse(const ConsoleLineTryParse
 		from_chars_throw(result[3], playerCount);
 		from_chars_throw(result[4], playerMaxCount);
 
-		return std::make_shared<ServerJoinLine>(args.m_Timestamp, result[1].str(), result[2].str(),
+		return ServerJoinLine::Create(args.m_Timestamp, result[1].str(), result[2].str(),
 			playerCount, playerMaxCount, buildNumber, serverNumber);
 	}
 
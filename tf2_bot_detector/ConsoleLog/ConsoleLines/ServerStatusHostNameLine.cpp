@@ -36,7 +36,7 @@ std::shared_ptr<IConsoleLine> ServerStatusHostnameLine::TryParse(const ConsoleLi
 
 	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
 	{
-		return std::make_shared<ServerStatusHostnameLine>(args.m_Timestamp, result[1].str());
+		return ServerStatusHostnameLine::Create(args.m_Timestamp, result[1].str());
 	}
 
 	return nullptr;
@@ -42,7 +42,7 @@ std::shared_ptr<IConsoleLine> ServerStatusMapLine::TryParse(const ConsoleLineTry
 		from_chars_throw(result[3], pos[1]);
 		from_chars_throw(result[4], pos[2]);
 
-		return std::make_shared<ServerStatusMapLine>(args.m_Timestamp, result[1].str(), pos);
+		return ServerStatusMapLine::Create(args.m_Timestamp, result[1].str(), pos);
 	}
 
 	return nullptr;
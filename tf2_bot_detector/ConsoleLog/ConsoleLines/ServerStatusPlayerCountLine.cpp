@@ -41,7 +41,7 @@ std::shared_ptr<IConsoleLine> ServerStatusPlayerCountLine::TryParse(const Consol
 		from_chars_throw(result[1], playerCount);
 		from_chars_throw(result[2], botCount);
 		from_chars_throw(result[3], maxPlayers);
-		return std::make_shared<ServerStatusPlayerCountLine>(args.m_Timestamp, playerCount, botCount, maxPlayers);
+		return ServerStatusPlayerCountLine::Create(args.m_Timestamp, playerCount, botCount, maxPlayers);
 	}
 
 	return nullptr;
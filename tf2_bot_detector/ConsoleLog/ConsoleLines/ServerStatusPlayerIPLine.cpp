@@ -38,7 +38,7 @@ std::shared_ptr<IConsoleLine> ServerStatusPlayerIPLine::TryParse(const ConsoleLi
 	static const std::regex s_Regex(R"regex(udp\/ip  : (.*)  \(public ip: (.*)\))regex", std::regex::optimize);
 
 	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-		return std::make_shared<ServerStatusPlayerIPLine>(args.m_Timestamp, result[1].str(), result[2].str());
+		return ServerStatusPlayerIPLine::Create(args.m_Timestamp, result[1].str(), result[2].str());
 
 	return nullptr;
 }
@@ -15,7 +15,7 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 
@@ -33,57 +33,191 @@ ServerStatusPlayerLine::ServerStatusPlayerLine(time_point_t timestamp, PlayerSta
 {
 }
 
-std::shared_ptr<IConsoleLine> ServerStatusPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
+namespace
 {
-	static const std::regex s_Regex(R"regex(#\s+(\d+)\s+"((?:.)+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(.*))?)regex", std::regex::optimize);
-	
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	// Same character classes as \s, \d and \w in the regex this replaced
+	constexpr bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+	}
+	constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+	constexpr bool IsWordChar(char c)
 	{
-		PlayerStatus status{};
+		return IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+	}
 
-		from_chars_throw(result[1], status.m_UserID);
-		status.m_Name = result[2].str();
-		status.m_SteamID = SteamID(std::string_view(&*result[3].first, result[3].length()));
+	template<typename TFunc>
+	constexpr std::string_view TakeWhile(const std::string_view& text, size_t& pos, TFunc&& pred)
+	{
+		const size_t begin = pos;
+		while (pos < text.size() && pred(text[pos]))
+			pos++;
 
-		// Connected time
-		{
-			uint32_t connectedHours = 0;
-			uint32_t connectedMins;
-			uint32_t connectedSecs;
+		return text.substr(begin, pos - begin);
+	}
+
+	constexpr bool SkipSpaces(const std::string_view& text, size_t& pos)
+	{
+		return !TakeWhile(text, pos, IsSpace).empty();
+	}
 
-			if (result[4].matched)
-				from_chars_throw(result[4], connectedHours);
+	constexpr bool SkipChar(const std::string_view& text, size_t& pos, char c)
+	{
+		if (pos >= text.size() || text[pos] != c)
+			return false;
 
-			from_chars_throw(result[5], connectedMins);
-			from_chars_throw(result[6], connectedSecs);
+		pos++;
+		return true;
+	}
 
-			status.m_ConnectionTime = args.m_Timestamp - ((connectedHours * 1h) + (connectedMins * 1min) + connectedSecs * 1s);
+	struct StatusRowTokens
+	{
+		std::string_view m_UserID;
+		std::string_view m_Name;
+		std::string_view m_SteamID;
+		std::string_view m_ConnectedHours;  // Empty if under an hour
+		std::string_view m_ConnectedMins;
+		std::string_view m_ConnectedSecs;
+		std::string_view m_Ping;
+		std::string_view m_Loss;
+		std::string_view m_State;
+		std::string_view m_Address;         // Empty on valve servers
+	};
+
+	// Everything after the SteamID: [hh:]mm:ss ping loss state [address]
+	constexpr bool TokenizeStatusRowTail(const std::string_view& text, size_t pos, StatusRowTokens& tokens)
+	{
+		if (!SkipSpaces(text, pos))
+			return false;
+
+		const auto first = TakeWhile(text, pos, IsDigit);
+		if (first.empty() || !SkipChar(text, pos, ':'))
+			return false;
+
+		const auto second = TakeWhile(text, pos, IsDigit);
+		if (second.empty())
+			return false;
+
+		if (SkipChar(text, pos, ':'))
+		{
+			tokens.m_ConnectedHours = first;
+			tokens.m_ConnectedMins = second;
+			tokens.m_ConnectedSecs = TakeWhile(text, pos, IsDigit);
+			if (tokens.m_ConnectedSecs.empty())
+				return false;
 		}
+		else
+		{
+			tokens.m_ConnectedHours = {};
+			tokens.m_ConnectedMins = first;
+			tokens.m_ConnectedSecs = second;
+		}
+
+		if (!SkipSpaces(text, pos) || (tokens.m_Ping = TakeWhile(text, pos, IsDigit)).empty())
+			return false;
+		if (!SkipSpaces(text, pos) || (tokens.m_Loss = TakeWhile(text, pos, IsDigit)).empty())
+			return false;
+		if (!SkipSpaces(text, pos) || (tokens.m_State = TakeWhile(text, pos, IsWordChar)).empty())
+			return false;
 
-		from_chars_throw(result[7], status.m_Ping);
-		from_chars_throw(result[8], status.m_Loss);
+		tokens.m_Address = {};
+		if (pos == text.size())
+			return true;
 
-		// State
+		if (!SkipSpaces(text, pos))
+			return false;
+
+		tokens.m_Address = text.substr(pos);
+		return true;
+	}
+
+	// # userid "name" [U:1:1234] [hh:]mm:ss ping loss state [address]
+	constexpr std::optional<StatusRowTokens> TokenizeStatusRow(const std::string_view& text)
+	{
+		StatusRowTokens tokens{};
+		size_t pos = 0;
+
+		if (!SkipChar(text, pos, '#') || !SkipSpaces(text, pos))
+			return std::nullopt;
+
+		tokens.m_UserID = TakeWhile(text, pos, IsDigit);
+		if (tokens.m_UserID.empty() || !SkipSpaces(text, pos) || !SkipChar(text, pos, '"'))
+			return std::nullopt;
+
+		const size_t nameBegin = pos;
+
+		// Names can have quotes (and anything else) in them, so the closing quote is the last one
+		// that the rest of the row still fits after. That's nearly always the very last quote, so
+		// this is normally a single pass.
+		for (size_t nameEnd = text.rfind('"'); nameEnd != text.npos && nameEnd > nameBegin; nameEnd = text.rfind('"', nameEnd - 1))
 		{
-			const auto state = std::string_view(&*result[9].first, result[9].length());
-			if (state == "active"sv)
-				status.m_State = PlayerStatusState::Active;
-			else if (state == "spawning"sv)
-				status.m_State = PlayerStatusState::Spawning;
-			else if (state == "connecting"sv)
-				status.m_State = PlayerStatusState::Connecting;
-			else if (state == "challenging"sv)
-				status.m_State = PlayerStatusState::Challenging;
-			else
-				throw std::runtime_error("Unknown player status state "s << std::quoted(state));
+			size_t steamIDBegin = nameEnd + 1;
+			if (!SkipSpaces(text, steamIDBegin) || steamIDBegin >= text.size() || text[steamIDBegin] != '[')
+				continue;
+
+			for (size_t steamIDEnd = text.rfind(']'); steamIDEnd != text.npos && steamIDEnd > steamIDBegin; steamIDEnd = text.rfind(']', steamIDEnd - 1))
+			{
+				if (TokenizeStatusRowTail(text, steamIDEnd + 1, tokens))
+				{
+					tokens.m_Name = text.substr(nameBegin, nameEnd - nameBegin);
+					tokens.m_SteamID = text.substr(steamIDBegin, steamIDEnd + 1 - steamIDBegin);
+					return tokens;
+				}
+			}
 		}
 
-		status.m_Address = result[10].str();
+		return std::nullopt;
+	}
+}
+
+std::shared_ptr<IConsoleLine> ServerStatusPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
+{
+	const auto tokens = TokenizeStatusRow(args.m_Text);
+	if (!tokens)
+		return nullptr;
+
+	PlayerStatus status{};
+
+	from_chars_throw(tokens->m_UserID, status.m_UserID);
+	status.m_Name = tokens->m_Name;
+	status.m_SteamID = SteamID(tokens->m_SteamID);
+
+	// Connected time
+	{
+		uint32_t connectedHours = 0;
+		uint32_t connectedMins;
+		uint32_t connectedSecs;
+
+		if (!tokens->m_ConnectedHours.empty())
+			from_chars_throw(tokens->m_ConnectedHours, connectedHours);
+
+		from_chars_throw(tokens->m_ConnectedMins, connectedMins);
+		from_chars_throw(tokens->m_ConnectedSecs, connectedSecs);
 
-		return std::make_shared<ServerStatusPlayerLine>(args.m_Timestamp, std::move(status));
+		status.m_ConnectionTime = args.m_Timestamp - ((connectedHours * 1h) + (connectedMins * 1min) + connectedSecs * 1s);
 	}
 
-	return nullptr;
+	from_chars_throw(tokens->m_Ping, status.m_Ping);
+	from_chars_throw(tokens->m_Loss, status.m_Loss);
+
+	// State
+	{
+		const auto state = tokens->m_State;
+		if (state == "active"sv)
+			status.m_State = PlayerStatusState::Active;
+		else if (state == "spawning"sv)
+			status.m_State = PlayerStatusState::Spawning;
+		else if (state == "connecting"sv)
+			status.m_State = PlayerStatusState::Connecting;
+		else if (state == "challenging"sv)
+			status.m_State = PlayerStatusState::Challenging;
+		else
+			throw std::runtime_error("Unknown player status state "s << std::quoted(state));
+	}
+
+	status.m_Address = tokens->m_Address;
+
+	return ServerStatusPlayerLine::Create(args.m_Timestamp, std::move(status));
 }
 
 void ServerStatusPlayerLine::Print(const PrintArgs& args) const
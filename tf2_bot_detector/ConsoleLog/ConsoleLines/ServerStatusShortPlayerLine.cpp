@@ -45,7 +45,7 @@ std::shared_ptr<IConsoleLine> ServerStatusShortPlayerLine::TryParse(const Consol
 		assert(status.m_ClientIndex >= 1);
 		status.m_Name = result[2].str();
 
-		return std::make_shared<ServerStatusShortPlayerLine>(args.m_Timestamp, std::move(status));
+		return ServerStatusShortPlayerLine::Create(args.m_Timestamp, std::move(status));
 	}
 
 	return nullptr;
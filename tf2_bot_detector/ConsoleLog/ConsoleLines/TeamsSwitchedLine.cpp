@@ -29,7 +29,7 @@ using namespace std::string_view_literals;
 std::shared_ptr<IConsoleLine> TeamsSwitchedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
 	if (args.m_Text == "Teams have been switched."sv)
-		return std::make_unique<TeamsSwitchedLine>(args.m_Timestamp);
+		return TeamsSwitchedLine::Create(args.m_Timestamp);
 
 	return nullptr;
 }
@@ -5,6 +5,7 @@
 #include "Util/RegexUtils.h"
 #include "Config/Settings.h"
 #include "WorldState.h"
+#include "Platform/FileWatcher.h"
 #include "Platform/Platform.h"
 
 #include "ConsoleLines/ChatConsoleLine.h"
@@ -13,6 +14,7 @@
 #include <mh/text/formatters/error_code.hpp>
 #include <mh/future.hpp>
 
+#include <bit>
 #include <regex>
 
 using namespace std::chrono_literals;
@@ -30,63 +32,105 @@ void ConsoleLogParser::TrySnapshot(bool& snapshotUpdated)
 }
 
 ConsoleLogParser::ConsoleLogParser(IWorldState& world, const Settings& settings, std::filesystem::path conLogFile) :
-	m_Settings(&settings), m_WorldState(&world), m_FileName(std::move(conLogFile))
+	m_Settings(&settings), m_WorldState(&world), m_FileName(std::move(conLogFile)),
+	m_FileWatcher(IFileWatcher::Create(m_FileName))
 {
+	if (!m_FileWatcher->IsEventDriven())
+		DebugLogWarning("Falling back to polling {} for changes", m_FileName);
 }
 
-void ConsoleLogParser::Update()
+ConsoleLogParser::~ConsoleLogParser() = default;
+
+bool ConsoleLogParser::HasPendingChanges() const
 {
-	const auto now = clock_t::now();
-	if (!m_File && (now - m_LastFileLoadAttempt) > 1s)
-	{
-		m_LastFileLoadAttempt = now;
+	return m_ReadPending || m_FileWatcher->HasPendingChanges();
+}
 
-		// Try to truncate
-		{
-			std::error_code ec;
-			const auto filesize = std::filesystem::file_size(m_FileName, ec);
-			if (ec)
-				LogWarning("Failed to get size of {}: {}", m_FileName, ec);
-			else if (std::filesystem::resize_file(m_FileName, 0, ec); ec)
-				Log("Unable to truncate {}, current size is {}", m_FileName, filesize);
-			else
-				Log("Truncated console log file");
-		}
+void ConsoleLogParser::TryOpenFile(bool truncate)
+{
+	m_LastFileLoadAttempt = clock_t::now();
 
+	// Only throw away whatever was there before we started. After a rotation, everything in
+	// the new file was written while we were watching it.
+	if (truncate)
+	{
 		std::error_code ec;
-		{
+		const auto filesize = std::filesystem::file_size(m_FileName, ec);
+		if (ec)
+			LogWarning("Failed to get size of {}: {}", m_FileName, ec);
+		else if (std::filesystem::resize_file(m_FileName, 0, ec); ec)
+			Log("Unable to truncate {}, current size is {}", m_FileName, filesize);
+		else
+			Log("Truncated console log file");
+	}
+
+	std::error_code ec;
+	{
 #ifdef _WIN32
-			FILE* temp = _wfsopen(m_FileName.c_str(), L"r", _SH_DENYNO);
+		FILE* temp = _wfsopen(m_FileName.c_str(), L"r", _SH_DENYNO);
 #else
-			FILE* temp = fopen(m_FileName.c_str(), "r");
+		FILE* temp = fopen(m_FileName.c_str(), "r");
 #endif
-			if (!temp)
-			{
-				auto e = errno;
-				ec = std::error_code(e, std::generic_category());
-			}
-			m_File.reset(temp);
+		if (!temp)
+		{
+			auto e = errno;
+			ec = std::error_code(e, std::generic_category());
 		}
+		m_File.reset(temp);
+	}
 
-		if (!m_File)
-			DebugLog("Failed to open {}: {}", m_FileName, ec);
-		else
-			Log("Successfully opened {}", m_FileName);
+	if (!m_File)
+		DebugLog("Failed to open {}: {}", m_FileName, ec);
+	else
+		Log("Successfully opened {}", m_FileName);
+
+	// whatever we did to the file just now doesn't count as a change
+	(void)m_FileWatcher->ConsumeChanges();
+	m_ReadPending = true;
+}
+
+void ConsoleLogParser::Update()
+{
+	const FileChange change = m_FileWatcher->ConsumeChanges();
+
+	if (change == FileChange::Replaced && m_File)
+	{
+		Log("{} was replaced, reopening", m_FileName);
+		m_File.reset();
+		m_FileLineBuf.clear();
+	}
+
+	// If we can't get notified when the file appears, keep retrying once per second like before
+	if (const bool firstAttempt = m_LastFileLoadAttempt == time_point_t{};
+		!m_File && (change != FileChange::None || firstAttempt ||
+		(!m_FileWatcher->IsEventDriven() && (clock_t::now() - m_LastFileLoadAttempt) > 1s)))
+	{
+		TryOpenFile(firstAttempt);
 	}
 
 	bool snapshotUpdated = false;
 
 	bool linesProcessed = false;
 	bool consoleLinesUpdated = false;
-	if (m_File)
+	if (m_File && (m_ReadPending || change != FileChange::None))
 	{
+		std::error_code ec;
+		const auto length = std::filesystem::file_size(m_FileName, ec);
+		if (const auto pos = ftell(m_File.get()); !ec && pos >= 0 && uintmax_t(pos) > length)
+		{
+			// Someone truncated the file out from under us, start from the beginning again.
+			Log("{} was truncated, rewinding", m_FileName);
+			fseek(m_File.get(), 0, SEEK_SET);
+			m_FileLineBuf.clear();
+		}
+
 		Parse(linesProcessed, snapshotUpdated, consoleLinesUpdated);
 
 		// Parse progress
 		{
 			const auto pos = ftell(m_File.get());
-			const auto length = std::filesystem::file_size(m_FileName);
-			m_ParseProgress = float(double(pos) / length);
+			const auto newLength = std::filesystem::file_size(m_FileName, ec);
+			m_ParseProgress = (!ec && newLength > 0) ? float(double(pos) / newLength) : 1.0f;
 		}
 	}
 
@@ -127,12 +171,59 @@ void ConsoleLogParser::Parse(bool& linesProcessed, bool& snapshotUpdated, bool&
 			break;
 
 	} while (readCount > 0);
+
+	// If we didn't hit the end of the file, we have to come back even if there are no new changes.
+	m_ReadPending = readCount > 0;
+}
+
+void ConsoleLogParser::UpdateChatWrapperLookup()
+{
+	const auto& wrappers = m_Settings->m_Unsaved.m_ChatMsgWrappers;
+
+	bool changed = m_ChatWrapperLookup.m_HasWrappers != wrappers.has_value();
+	m_ChatWrapperLookup.m_HasWrappers = wrappers.has_value();
+	for (size_t i = 0; i < m_ChatWrapperLookup.m_Starts.size(); i++)
+	{
+		const std::string_view start = wrappers ? std::string_view(wrappers->m_Types[i].m_Full.m_Start.m_Narrow) : std::string_view{};
+		if (m_ChatWrapperLookup.m_Starts[i] != start)
+		{
+			m_ChatWrapperLookup.m_Starts[i] = start;
+			changed = true;
+		}
+	}
+
+	if (!changed)
+		return;
+
+	m_ChatWrapperLookup.m_CategoriesByFirstByte.fill(0);
+	for (size_t i = 0; i < m_ChatWrapperLookup.m_Starts.size(); i++)
+	{
+		const auto& start = m_ChatWrapperLookup.m_Starts[i];
+		const auto bit = uint8_t(1 << i);
+
+		if (!start.empty())
+		{
+			m_ChatWrapperLookup.m_CategoriesByFirstByte[uint8_t(start.front())] |= bit;
+		}
+		else if (m_ChatWrapperLookup.m_HasWrappers)
+		{
+			// Matches everything, like an empty starts_with() would
+			for (auto& categories : m_ChatWrapperLookup.m_CategoriesByFirstByte)
+				categories |= bit;
+		}
+	}
 }
 
 bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed)
 {
-	for (int i = 0; i < (int)ChatCategory::COUNT; i++)
+	if (lineStr.empty())
+		return true;
+
+	// Lowest bit first, so categories are still tried in the same order as before
+	for (auto candidates = m_ChatWrapperLookup.m_CategoriesByFirstByte[uint8_t(lineStr.front())];
+		candidates != 0; candidates &= candidates - 1)
 	{
+		const int i = std::countr_zero(candidates);
 		const auto category = ChatCategory(i);
 
 		auto& type = m_Settings->m_Unsaved.m_ChatMsgWrappers.value().m_Types[i];
@@ -175,8 +266,9 @@ bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter
 						id = *player;
 					}
 
-					parsed = std::make_unique<ChatConsoleLine>(m_WorldState->GetCurrentTime(),
-						std::string(name), std::string(msg), IsDead(category), IsTeam(category), isSelf, teamShareResult, id);
+					// Borrows from m_FileLineBuf, see ParseChunk
+					parsed = ChatConsoleLine::Create(ChatConsoleLine::borrow_t{}, m_WorldState->GetCurrentTime(),
+						name, msg, IsDead(category), IsTeam(category), isSelf, teamShareResult, id);
 				}
 				else
 				{
@@ -208,6 +300,8 @@ void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool&
 {
 	static const std::regex s_TimestampRegex(R"regex(\n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n])regex", std::regex::optimize);
 
+	UpdateChatWrapperLookup();
+
 	std::smatch match;
 	while (std::regex_search(parseEnd, m_FileLineBuf.cend(), match, s_TimestampRegex))
 	{
@@ -255,6 +349,10 @@ void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool&
 				{
 					m_WorldState->GetConsoleLineListenerBroadcaster().OnConsoleLineParsed(*m_WorldState, *parsed);
 					consoleLinesUpdated = true;
+
+					// m_FileLineBuf gets erased after this chunk, so anyone that kept the line needs their own copy
+					if (parsed.use_count() > 1)
+						parsed->TakeOwnership();
 				}
 			}
 			else
@@ -1,15 +1,20 @@
 #pragma once
 
 #include "CompensatedTS.h"
+#include "Config/ChatWrappers.h"
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <unordered_set>
 
 namespace tf2_bot_detector
 {
 	class IConsoleLine;
 	class IConsoleLineListener;
+	class IFileWatcher;
 	class Settings;
 	class IWorldState;
 
@@ -17,9 +22,16 @@ namespace tf2_bot_detector
 	{
 	public:
 		ConsoleLogParser(IWorldState& world, const Settings& settings, std::filesystem::path conLogFile);
+		~ConsoleLogParser();
 
 		void Update();
 
+		// Has tf2 written anything to console.log that we haven't read yet?
+		bool HasPendingChanges() const;
+
+		// Read the file next Update() even if the file watcher hasn't noticed any changes yet
+		void RequestRead() { m_ReadPending = true; }
+
 		float GetParseProgress() const { return m_ParseProgress; }
 
 		const CompensatedTS& GetCurrentTimestamp() const { return m_CurrentTimestamp; }
@@ -40,17 +52,34 @@ namespace tf2_bot_detector
 		};
 
 		using striter = std::string::const_iterator;
+		void TryOpenFile(bool truncate);
 		void Parse(bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
 		void ParseChunk(striter& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
 		bool ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed);
 
+		// Which chat categories' wrappers could start with a given byte, so most lines can be
+		// ruled out as chat messages without comparing them against every wrapper.
+		struct ChatWrapperLookup
+		{
+			std::array<std::string, size_t(ChatCategory::COUNT)> m_Starts;
+			std::array<uint8_t, 256> m_CategoriesByFirstByte{};  // Bit i set for ChatCategory(i)
+			bool m_HasWrappers = false;
+		};
+		static_assert(size_t(ChatCategory::COUNT) <= 8);
+		ChatWrapperLookup m_ChatWrapperLookup;
+		void UpdateChatWrapperLookup();
+
 		struct CustomDeleters
 		{
 			void operator()(FILE*) const;
 		};
 		std::filesystem::path m_FileName;
 		std::unique_ptr<FILE, CustomDeleters> m_File;
+		std::unique_ptr<IFileWatcher> m_FileWatcher;
 		time_point_t m_LastFileLoadAttempt{};
+
+		// Parse() ran out of time before reaching the end of the file last update.
+		bool m_ReadPending = true;
 		std::string m_FileLineBuf;
 		float m_ParseProgress = 0;
 	};
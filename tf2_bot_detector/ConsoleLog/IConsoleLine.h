@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Clock.h"
+#include "ConsoleLinePool.h"
 
 #include <list>
 #include <memory>
 #include <string_view>
+#include <typeinfo>
+#include <vector>
 
 namespace tf2_bot_detector
 {
@@ -86,6 +89,13 @@ namespace tf2_bot_detector
 		virtual ConsoleLineType GetType() const = 0;
 		virtual bool ShouldPrint() const { return true; }
 
+		/// <summary>
+		/// Lines are allowed to point into the console log read buffer while they are being
+		/// broadcast. If anything is still holding on to the line afterwards, this is called
+		/// so it can copy whatever it was borrowing.
+		/// </summary>
+		virtual void TakeOwnership() {}
+
 		struct PrintArgs
 		{
 			const Settings& m_Settings;
@@ -98,8 +108,18 @@ namespace tf2_bot_detector
 
 		time_point_t GetTimestamp() const { return m_Timestamp; }
 
-	protected:
 		using TryParseFunc = std::shared_ptr<IConsoleLine>(*)(const ConsoleLineTryParseArgs& args);
+		struct RegisteredType
+		{
+			TryParseFunc m_TryParseFunc = nullptr;
+			const std::type_info* m_TypeInfo = nullptr;
+			bool m_AutoParse = true;
+		};
+
+		// Every line type, whether or not ParseConsoleLine tries it (for the parser benchmarks)
+		static std::vector<RegisteredType> GetRegisteredTypes();
+
+	protected:
 		struct ConsoleLineTypeData
 		{
 			TryParseFunc m_TryParseFunc = nullptr;
@@ -126,6 +146,14 @@ namespace tf2_bot_detector
 	public:
 		ConsoleLineBase(time_point_t timestamp) : IConsoleLine(timestamp) {}
 
+		// Use instead of std::make_shared. Most lines are thrown away right after being
+		// broadcast, so they come out of a pool rather than a fresh heap allocation each.
+		template<typename... TArgs>
+		static std::shared_ptr<TSelf> Create(TArgs&&... args)
+		{
+			return std::allocate_shared<TSelf>(ConsoleLineAllocator<TSelf>{}, std::forward<TArgs>(args)...);
+		}
+
 	private:
 		#ifdef __linux__
 		__attribute__((__used__))
@@ -54,7 +54,7 @@ std::shared_ptr<IConsoleLine> SplitPacketLine::TryParse(const ConsoleLineTryPars
 		from_chars_throw(result[6], packet.m_MTU);
 		packet.m_Address = result[7].str();
 
-		return std::make_shared<SplitPacketLine>(args.m_Timestamp, std::move(packet));
+		return SplitPacketLine::Create(args.m_Timestamp, std::move(packet));
 	}
 
 	return nullptr;
@@ -126,7 +126,7 @@ std::shared_ptr<IConsoleLine> NetStatusConfigLine::TryParse(const ConsoleLineTry
 		unsigned connectionCount;
 		from_chars_throw(result[3], connectionCount);
 
-		return std::make_shared<NetStatusConfigLine>(args.m_Timestamp, playerMode, serverMode, connectionCount);
+		return NetStatusConfigLine::Create(args.m_Timestamp, playerMode, serverMode, connectionCount);
 	}
 
 	return nullptr;
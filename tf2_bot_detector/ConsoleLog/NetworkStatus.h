@@ -118,7 +118,7 @@ namespace tf2_bot_detector
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args)
 		{
 			if (float f0, f1; NetChannelDualFloatLineBase::TryParse(args.m_Text, TSelf::REGEX_PATTERN, f0, f1))
-				return std::make_shared<TSelf>(args.m_Timestamp, f0, f1);
+				return BaseClass::Create(args.m_Timestamp, f0, f1);
 
 			return nullptr;
 		}
@@ -0,0 +1,458 @@
+#include "BlobStore.h"
+#include "Platform/MappedFile.h"
+#include "Log.h"
+
+#include <mh/text/string_insertion.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::string_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	static constexpr uint32_t INDEX_MAGIC = 0x58444942; // "BIDX"
+	static constexpr uint32_t INDEX_VERSION = 2;
+
+	// Access times only get persisted every so often, they don't need to be exact
+	static constexpr uint32_t SAVE_INDEX_INTERVAL = 32;
+
+	template<typename T> void WriteValue(std::ostream& stream, const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+	template<typename T> bool ReadValue(std::istream& stream, T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		return !!stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+	}
+
+	int64_t ToSeconds(time_point_t time)
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+	}
+	time_point_t FromSeconds(int64_t seconds)
+	{
+		return time_point_t(std::chrono::duration_cast<duration_t>(std::chrono::seconds(seconds)));
+	}
+
+	std::filesystem::path AppendExtension(std::filesystem::path path, const char* extension)
+	{
+		path += extension;
+		return path;
+	}
+}
+
+uint64_t BlobStore::Entry::GetRecordSize(const std::string_view& key) const
+{
+	return sizeof(RecordHeader) + key.size() + m_DataSize;
+}
+
+uint64_t BlobStore::Entry::GetDataOffset(const std::string_view& key) const
+{
+	return m_RecordOffset + sizeof(RecordHeader) + key.size();
+}
+
+BlobStore::BlobStore(std::filesystem::path dataFile, uint64_t maxBytes, duration_t maxAge) :
+	m_DataFilePath(std::move(dataFile)),
+	m_IndexFilePath(AppendExtension(m_DataFilePath, ".idx")),
+	m_MaxBytes(maxBytes),
+	m_MaxAge(maxAge)
+{
+	std::filesystem::create_directories(m_DataFilePath.parent_path());
+
+	try
+	{
+		m_DataFileSize = std::filesystem::exists(m_DataFilePath) ? std::filesystem::file_size(m_DataFilePath) : 0;
+
+		if (!LoadIndex())
+			RebuildIndex();
+
+		EvictExpired(clock_t::now());
+		EvictOverBudget();
+
+		// Nothing can be mapped yet, so this is the one safe time to move the data file around
+		if (m_DataFileSize > m_LiveBytes)
+			Compact();
+	}
+	catch (const std::exception& e)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to open {}, starting over with an empty store", m_DataFilePath);
+
+		m_Index.clear();
+		m_LiveBytes = 0;
+		m_DataFileSize = 0;
+		std::filesystem::remove(m_DataFilePath);
+		std::filesystem::remove(m_IndexFilePath);
+	}
+
+	m_DataFile.open(m_DataFilePath, std::ios::binary | std::ios::app);
+	if (!m_DataFile.good())
+		throw std::runtime_error("Failed to open "s << m_DataFilePath << " for writing");
+}
+
+BlobStore::~BlobStore()
+{
+	try
+	{
+		Flush();
+	}
+	catch (const std::exception& e)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to save {}", m_IndexFilePath);
+	}
+}
+
+auto BlobStore::Find(const std::string_view& key) -> Blob
+{
+	std::lock_guard lock(m_Mutex);
+
+	auto found = m_Index.find(key);
+	if (found == m_Index.end())
+		return {};
+
+	Entry& entry = found->second;
+	entry.m_LastAccess = clock_t::now();
+
+	const uint64_t dataOffset = entry.GetDataOffset(found->first);
+	const uint64_t dataEnd = dataOffset + entry.m_DataSize;
+
+	// Only remap when something was appended after our current mapping was made
+	if (!m_Mapping || m_Mapping->GetData().size() < dataEnd)
+		m_Mapping = IMappedFile::Open(m_DataFilePath);
+
+	if (m_Mapping->GetData().size() < dataEnd)
+	{
+		LogError("Blob {} in {} ends at {}, but the file is only {} bytes", found->first,
+			m_DataFilePath, dataEnd, m_Mapping->GetData().size());
+		Erase(found);
+		return {};
+	}
+
+	return Blob{ m_Mapping->GetData().subspan(dataOffset, entry.m_DataSize), m_Mapping };
+}
+
+void BlobStore::Store(const std::string_view& key, const std::span<const std::byte>& data)
+{
+	std::lock_guard lock(m_Mutex);
+
+	const auto now = clock_t::now();
+	const uint64_t recordOffset = m_DataFileSize;
+	AppendRecord(RecordHeader{ RECORD_MAGIC, uint32_t(key.size()), uint32_t(data.size()), 0, ToSeconds(now) }, key, data);
+
+	const Entry entry{ recordOffset, uint32_t(data.size()), now };
+	m_LiveBytes += entry.GetRecordSize(key);
+
+	// The old record (if any) becomes dead space
+	if (auto [it, inserted] = m_Index.try_emplace(std::string(key), entry); !inserted)
+	{
+		m_LiveBytes -= it->second.GetRecordSize(it->first);
+		it->second = entry;
+	}
+
+	EvictOverBudget();
+
+	if (++m_UnsavedChanges >= SAVE_INDEX_INTERVAL)
+		SaveIndex();
+}
+
+void BlobStore::Remove(const std::string_view& key)
+{
+	std::lock_guard lock(m_Mutex);
+
+	if (auto found = m_Index.find(key); found != m_Index.end())
+	{
+		Erase(found);
+		SaveIndex(); // Rare, and we don't want it coming back if we don't get to save later
+	}
+}
+
+void BlobStore::Flush()
+{
+	std::lock_guard lock(m_Mutex);
+	SaveIndex();
+}
+
+size_t BlobStore::GetBlobCount() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_Index.size();
+}
+
+uint64_t BlobStore::GetLiveBytes() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_LiveBytes;
+}
+
+uint64_t BlobStore::GetDataFileSize() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_DataFileSize;
+}
+
+bool BlobStore::LoadIndex()
+{
+	std::ifstream file(m_IndexFilePath, std::ios::binary);
+	if (!file.good())
+		return false;
+
+	uint32_t magic{}, version{};
+	uint64_t dataFileSize{}, count{};
+	if (!ReadValue(file, magic) || !ReadValue(file, version) || !ReadValue(file, dataFileSize) || !ReadValue(file, count))
+		return false;
+
+	if (magic != INDEX_MAGIC || version != INDEX_VERSION)
+	{
+		DebugLog("{} has an unknown magic/version, rebuilding", m_IndexFilePath);
+		return false;
+	}
+
+	if (dataFileSize != m_DataFileSize)
+	{
+		DebugLog("{} was written for a {} byte data file, but it's {} bytes now, rebuilding",
+			m_IndexFilePath, dataFileSize, m_DataFileSize);
+		return false;
+	}
+
+	Index index;
+	uint64_t liveBytes = 0;
+	std::string key;
+	for (uint64_t i = 0; i < count; i++)
+	{
+		uint32_t keySize{};
+		Entry entry;
+		int64_t lastAccess{};
+		if (!ReadValue(file, keySize))
+			return false;
+
+		key.resize(keySize);
+		if (!file.read(key.data(), keySize) ||
+			!ReadValue(file, entry.m_RecordOffset) ||
+			!ReadValue(file, entry.m_DataSize) ||
+			!ReadValue(file, lastAccess))
+		{
+			return false;
+		}
+
+		entry.m_LastAccess = FromSeconds(lastAccess);
+
+		const uint64_t recordSize = entry.GetRecordSize(key);
+		if (entry.m_RecordOffset + recordSize > m_DataFileSize)
+			return false;
+
+		liveBytes += recordSize;
+		index.emplace(std::move(key), entry);
+	}
+
+	m_Index = std::move(index);
+	m_LiveBytes = liveBytes;
+	return true;
+}
+
+void BlobStore::RebuildIndex()
+{
+	m_Index.clear();
+	m_LiveBytes = 0;
+
+	if (m_DataFileSize == 0)
+		return;
+
+	const auto mapping = IMappedFile::Open(m_DataFilePath);
+	const auto data = mapping->GetData();
+
+	uint64_t offset = 0;
+	while (offset + sizeof(RecordHeader) <= data.size())
+	{
+		RecordHeader header;
+		std::memcpy(&header, data.data() + offset, sizeof(header));
+		if (header.m_Magic != RECORD_MAGIC && header.m_Magic != TOMBSTONE_MAGIC)
+			break;
+
+		const uint64_t recordSize = sizeof(header) + uint64_t(header.m_KeySize) + header.m_DataSize;
+		if (offset + recordSize > data.size())
+			break;
+
+		// A key that was stored or removed again shows up more than once, the last one wins
+		std::string key(reinterpret_cast<const char*>(data.data() + offset + sizeof(header)), header.m_KeySize);
+		auto found = m_Index.find(key);
+		if (found != m_Index.end())
+			m_LiveBytes -= found->second.GetRecordSize(found->first);
+
+		if (header.m_Magic == TOMBSTONE_MAGIC)
+		{
+			if (found != m_Index.end())
+				m_Index.erase(found);
+		}
+		else
+		{
+			const Entry entry{ offset, header.m_DataSize, FromSeconds(header.m_StoredTime) };
+			if (found != m_Index.end())
+				found->second = entry;
+			else
+				m_Index.emplace(std::move(key), entry);
+
+			m_LiveBytes += recordSize;
+		}
+
+		offset += recordSize;
+	}
+
+	if (offset < data.size())
+		LogWarning("Ignoring {} bytes of garbage at the end of {}", data.size() - offset, m_DataFilePath);
+
+	DebugLog("Rebuilt index for {}: {} blobs", m_DataFilePath, m_Index.size());
+	m_UnsavedChanges++;
+}
+
+void BlobStore::SaveIndex()
+{
+	const auto tempPath = AppendExtension(m_IndexFilePath, ".tmp");
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		WriteValue(file, INDEX_MAGIC);
+		WriteValue(file, INDEX_VERSION);
+		WriteValue(file, m_DataFileSize);
+		WriteValue(file, uint64_t(m_Index.size()));
+
+		for (const auto& [key, entry] : m_Index)
+		{
+			WriteValue(file, uint32_t(key.size()));
+			file.write(key.data(), key.size());
+			WriteValue(file, entry.m_RecordOffset);
+			WriteValue(file, entry.m_DataSize);
+			WriteValue(file, ToSeconds(entry.m_LastAccess));
+		}
+
+		if (!file.good())
+			throw std::runtime_error("Failed to write "s << tempPath);
+	}
+
+	std::filesystem::rename(tempPath, m_IndexFilePath);
+	m_UnsavedChanges = 0;
+}
+
+void BlobStore::Compact()
+{
+	const auto tempPath = AppendExtension(m_DataFilePath, ".tmp");
+	const uint64_t oldSize = m_DataFileSize;
+
+	Index compacted;
+	uint64_t offset = 0;
+	{
+		const auto mapping = IMappedFile::Open(m_DataFilePath);
+		const auto data = mapping->GetData();
+
+		// Keep the original order, so blobs that were stored together stay together
+		std::vector<Index::const_iterator> entries;
+		entries.reserve(m_Index.size());
+		for (auto it = m_Index.cbegin(); it != m_Index.cend(); ++it)
+			entries.push_back(it);
+
+		std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b)
+			{
+				return a->second.m_RecordOffset < b->second.m_RecordOffset;
+			});
+
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		for (const auto& it : entries)
+		{
+			const uint64_t recordSize = it->second.GetRecordSize(it->first);
+			file.write(reinterpret_cast<const char*>(data.data() + it->second.m_RecordOffset), recordSize);
+
+			Entry entry = it->second;
+			entry.m_RecordOffset = offset;
+			compacted.emplace(it->first, entry);
+			offset += recordSize;
+		}
+
+		if (!file.good())
+			throw std::runtime_error("Failed to write "s << tempPath);
+	}
+
+	std::filesystem::rename(tempPath, m_DataFilePath);
+	m_Index = std::move(compacted);
+	m_DataFileSize = offset;
+	SaveIndex();
+
+	DebugLog("Compacted {} from {} to {} bytes", m_DataFilePath, oldSize, m_DataFileSize);
+}
+
+void BlobStore::EvictExpired(time_point_t now)
+{
+	const auto cutoff = now - m_MaxAge;
+	for (auto it = m_Index.begin(); it != m_Index.end(); )
+	{
+		auto current = it++;
+		if (current->second.m_LastAccess < cutoff)
+			Erase(current);
+	}
+}
+
+void BlobStore::EvictOverBudget()
+{
+	if (m_LiveBytes <= m_MaxBytes)
+		return;
+
+	std::vector<Index::iterator> entries;
+	entries.reserve(m_Index.size());
+	for (auto it = m_Index.begin(); it != m_Index.end(); ++it)
+		entries.push_back(it);
+
+	std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b)
+		{
+			return a->second.m_LastAccess < b->second.m_LastAccess;
+		});
+
+	for (const auto& it : entries)
+	{
+		if (m_LiveBytes <= m_MaxBytes)
+			break;
+
+		Erase(it);
+	}
+}
+
+void BlobStore::Erase(Index::iterator it)
+{
+	// Evictions while opening are followed by a compaction, which drops the records for good.
+	// After that, leave a tombstone so a rebuilt index doesn't bring the key back.
+	if (m_DataFile.is_open())
+	{
+		try
+		{
+			AppendRecord(RecordHeader{ TOMBSTONE_MAGIC, uint32_t(it->first.size()), 0, 0, ToSeconds(clock_t::now()) }, it->first, {});
+		}
+		catch (const std::exception& e)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to write a tombstone for {} to {}", it->first, m_DataFilePath);
+		}
+	}
+
+	m_LiveBytes -= it->second.GetRecordSize(it->first);
+	m_Index.erase(it);
+	m_UnsavedChanges++;
+}
+
+void BlobStore::AppendRecord(const RecordHeader& header, const std::string_view& key, const std::span<const std::byte>& data)
+{
+	WriteValue(m_DataFile, header);
+	m_DataFile.write(key.data(), key.size());
+	m_DataFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+	m_DataFile.flush();
+
+	if (!m_DataFile.good())
+	{
+		// Don't trust our idea of where the end of the file is anymore
+		m_DataFile.clear();
+		m_DataFileSize = std::filesystem::file_size(m_DataFilePath);
+		throw std::runtime_error("Failed to append "s << data.size() << " bytes to " << m_DataFilePath);
+	}
+
+	m_DataFileSize += sizeof(header) + key.size() + data.size();
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace tf2_bot_detector
+{
+	class IMappedFile;
+
+	/// <summary>
+	/// Lots of small blobs (avatar jpgs) packed into a single append-only data file,
+	/// with a small index file next to it mapping each key to where its blob lives and when it
+	/// was last used. Reading a blob is a hash lookup plus a slice of a memory mapping of the
+	/// data file; nothing gets copied or opened per-blob.
+	///
+	/// Blobs that haven't been touched in maxAge, or that don't fit into maxBytes (least recently
+	/// used first), are dropped from the index. The space they took up in the data file is
+	/// reclaimed the next time the store is opened.
+	///
+	/// If the index is missing or doesn't match the data file, it is rebuilt from the data file,
+	/// which is self-describing: every record carries the time it was stored, and removed or
+	/// evicted keys get a tombstone record so they don't come back.
+	/// </summary>
+	class BlobStore final
+	{
+	public:
+		BlobStore(std::filesystem::path dataFile, uint64_t maxBytes, duration_t maxAge);
+		~BlobStore();
+
+		struct Blob
+		{
+			std::span<const std::byte> m_Data;
+
+			// Keeps m_Data valid
+			std::shared_ptr<const IMappedFile> m_Mapping;
+
+			explicit operator bool() const { return !!m_Mapping; }
+		};
+
+		Blob Find(const std::string_view& key);
+
+		// Replaces whatever was already stored under this key.
+		void Store(const std::string_view& key, const std::span<const std::byte>& data);
+
+		// For blobs that turned out to be garbage. Does nothing if the key isn't stored.
+		void Remove(const std::string_view& key);
+
+		// Saves the index (including last access times). Also happens automatically now and then.
+		void Flush();
+
+		size_t GetBlobCount() const;
+		uint64_t GetLiveBytes() const;
+		uint64_t GetDataFileSize() const;
+
+	private:
+		struct RecordHeader
+		{
+			uint32_t m_Magic;
+			uint32_t m_KeySize;
+			uint32_t m_DataSize;
+			uint32_t m_Reserved;
+			int64_t m_StoredTime; // Seconds since epoch, a rebuilt index uses it as the last access time
+		};
+		static constexpr uint32_t RECORD_MAGIC = 0x32424c42; // "BLB2", version 1 records were "BLOB"
+		static constexpr uint32_t TOMBSTONE_MAGIC = 0x44414544; // "DEAD", no data, the key was removed
+
+		struct Entry
+		{
+			uint64_t m_RecordOffset{};
+			uint32_t m_DataSize{};
+			time_point_t m_LastAccess{};
+
+			uint64_t GetRecordSize(const std::string_view& key) const;
+			uint64_t GetDataOffset(const std::string_view& key) const;
+		};
+
+		struct KeyHash
+		{
+			using is_transparent = void;
+			size_t operator()(const std::string_view& key) const { return std::hash<std::string_view>{}(key); }
+		};
+		using Index = std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>;
+
+		bool LoadIndex();
+		void RebuildIndex();
+		void SaveIndex();
+		void Compact();
+		void EvictExpired(time_point_t now);
+		void EvictOverBudget();
+		void Erase(Index::iterator it);
+		void AppendRecord(const RecordHeader& header, const std::string_view& key, const std::span<const std::byte>& data);
+
+		std::filesystem::path m_DataFilePath;
+		std::filesystem::path m_IndexFilePath;
+		uint64_t m_MaxBytes;
+		duration_t m_MaxAge;
+
+		mutable std::mutex m_Mutex;
+		Index m_Index;
+		uint64_t m_LiveBytes = 0;
+		uint64_t m_DataFileSize = 0;
+		std::ofstream m_DataFile;
+		std::shared_ptr<const IMappedFile> m_Mapping;
+		uint32_t m_UnsavedChanges = 0;
+	};
+}
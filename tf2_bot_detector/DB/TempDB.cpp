@@ -8,9 +8,11 @@
 #include <mh/error/ensure.hpp>
 #include <mh/concurrency/thread_sentinel.hpp>
 #include <mh/types/enum_class_bit_ops.hpp>
+#include <nlohmann/json.hpp>
 #include <sqlite3.h>
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include <algorithm>
 #include <cassert>
 
 using namespace tf2_bot_detector;
@@ -21,7 +23,7 @@ namespace
 	class TempDB final : public ITempDB
 	{
 	public:
-		TempDB();
+		explicit TempDB(std::string dbPath);
 
 		void Store(const AccountAgeInfo& info) override;
 		bool TryGet(AccountAgeInfo& info) const override;
@@ -33,10 +35,18 @@ namespace
 		void Store(const AccountInventorySizeInfo& info) override;
 		bool TryGet(AccountInventorySizeInfo& info) const override;
 
+		void Store(const SourceBansCacheInfo& info) override;
+		bool TryGet(SourceBansCacheInfo& info) const override;
+
+		void Store(const std::vector<SessionHistoryInfo>& infos) override;
+		bool TryGet(SessionHistoryInfo& info) const override;
+		std::vector<SessionHistoryInfo> GetSessionHistory(time_point_t lastSeenAfter, size_t maxCount) const override;
+
 	private:
 		static constexpr size_t DB_VERSION = 4;
 		void Connect();
 
+		std::string m_DBPath;
 		std::optional<SQLite::Database> m_Connection;
 	};
 
@@ -86,7 +96,29 @@ namespace
 
 	} static const s_TableInventorySize;
 
-	TempDB::TempDB() try
+	struct TABLE_SOURCEBANS_CACHE final : BASETABLE_EXPIRABLE
+	{
+		TABLE_SOURCEBANS_CACHE() : BASETABLE_EXPIRABLE("TABLE_SOURCEBANS_CACHE") {}
+
+		// json array in the same shape as the steamhistory.net response
+		const ColumnDefinition COL_BANS = Column("Bans", ColumnType::Text, ColumnFlags::NotNull);
+
+	} static const s_TableSourceBansCache;
+
+	struct TABLE_SESSION_HISTORY final : BASETABLE
+	{
+		TABLE_SESSION_HISTORY() : BASETABLE("TABLE_SESSION_HISTORY") {}
+
+		const ColumnDefinition COL_NAME = Column("Name", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_FIRST_SEEN = Column("FirstSeen", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_LAST_SEEN = Column("LastSeen", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_KILLS = Column("Kills", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_DEATHS = Column("Deaths", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TableSessionHistory;
+
+	TempDB::TempDB(std::string dbPath) try :
+		m_DBPath(std::move(dbPath))
 	{
 		Connect();
 
@@ -94,9 +126,9 @@ namespace
 		if (const auto currentUserVersion = m_Connection->execAndGet("PRAGMA user_version").getInt();
 			currentUserVersion != DB_VERSION)
 		{
-			LogWarning("Current {} version = {}. Deleting and recreating...", CreateDBPath(), currentUserVersion);
+			LogWarning("Current {} version = {}. Deleting and recreating...", m_DBPath, currentUserVersion);
 			m_Connection.reset();
-			std::filesystem::remove(CreateDBPath());
+			std::filesystem::remove(m_DBPath);
 			Connect();
 			m_Connection->exec(mh::format("PRAGMA user_version = {}", DB_VERSION)); // TODO check current user_version and delete if different
 		}
@@ -106,6 +138,8 @@ namespace
 		CreateTable(m_Connection.value(), s_TableAccountAges, CreateTableFlags::IfNotExists);
 		CreateTable(m_Connection.value(), s_TableLogsTFCache, CreateTableFlags::IfNotExists);
 		CreateTable(m_Connection.value(), s_TableInventorySize, CreateTableFlags::IfNotExists);
+		CreateTable(m_Connection.value(), s_TableSourceBansCache, CreateTableFlags::IfNotExists);
+		CreateTable(m_Connection.value(), s_TableSessionHistory, CreateTableFlags::IfNotExists);
 	}
 	catch (...)
 	{
@@ -226,7 +260,7 @@ SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_Acc
 	void TempDB::Connect()
 	{
 		assert(!m_Connection.has_value());
-		m_Connection.emplace(CreateDBPath(), SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE | SQLite::OPEN_FULLMUTEX);
+		m_Connection.emplace(m_DBPath, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE | SQLite::OPEN_FULLMUTEX);
 	}
 
 	void TempDB::Store(const LogsTFCacheInfo& info) try
@@ -292,9 +326,167 @@ SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_Acc
 
 		return false;
 	}
+
+	void TempDB::Store(const SourceBansCacheInfo& info) try
+	{
+		const std::string bans = nlohmann::json(info.m_Bans).dump();
+
+		ReplaceInto(m_Connection.value(), s_TableSourceBansCache.GetTableName(),
+			{
+				{ s_TableSourceBansCache.COL_ACCOUNT_ID, info.GetSteamID() },
+				{ s_TableSourceBansCache.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
+				{ s_TableSourceBansCache.COL_BANS, bans.c_str() },
+			});
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
+
+	bool TempDB::TryGet(SourceBansCacheInfo& info) const
+	{
+		auto query = SelectStatementBuilder(s_TableSourceBansCache.GetTableName())
+			.Where(s_TableSourceBansCache.COL_ACCOUNT_ID == info.GetSteamID())
+			.Run(m_Connection.value());
+
+		if (query.executeStep())
+		{
+			info.m_LastCacheUpdateTime = query.getColumn(s_TableSourceBansCache.COL_LAST_UPDATE_TIME);
+			nlohmann::json::parse(query.getColumn(s_TableSourceBansCache.COL_BANS).getString()).get_to(info.m_Bans);
+			return true;
+		}
+
+		return false;
+	}
+
+	void TempDB::Store(const std::vector<SessionHistoryInfo>& infos) try
+	{
+		auto& db = m_Connection.value();
+		SQLite::Transaction transaction(db);
+
+		for (const SessionHistoryInfo& info : infos)
+		{
+			SessionHistoryInfo existing{};
+			existing.m_SteamID = info.m_SteamID;
+			const time_point_t firstSeen = TryGet(existing) ? std::min(existing.m_FirstSeen, info.m_FirstSeen) : info.m_FirstSeen;
+
+			ReplaceInto(db, s_TableSessionHistory.GetTableName(),
+				{
+					{ s_TableSessionHistory.COL_ACCOUNT_ID, info.GetSteamID() },
+					{ s_TableSessionHistory.COL_NAME, info.m_Name.c_str() },
+					{ s_TableSessionHistory.COL_FIRST_SEEN, firstSeen },
+					{ s_TableSessionHistory.COL_LAST_SEEN, info.m_LastSeen },
+					{ s_TableSessionHistory.COL_KILLS, info.m_Kills },
+					{ s_TableSessionHistory.COL_DEATHS, info.m_Deaths },
+				});
+		}
+
+		{
+			auto queryStr = mh::format(R"SQL(DELETE FROM {tbl_SessionHistory} WHERE {col_LastSeen} < $lastSeenBefore)SQL",
+				mh::fmtarg("tbl_SessionHistory", s_TableSessionHistory.GetTableName()),
+				mh::fmtarg("col_LastSeen", s_TableSessionHistory.COL_LAST_SEEN.m_Name));
+
+			SQLite::Statement query(db, queryStr);
+			query.bind("$lastSeenBefore", ColumnDataSerializer<time_point_t>::Serialize(tfbd_clock_t::now() - SessionHistoryInfo::GetMaxAge()));
+			query.exec();
+		}
+
+		transaction.commit();
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
+
+	static SessionHistoryInfo DeserializeSessionHistoryInfo(Statement2& query)
+	{
+		SessionHistoryInfo info;
+		info.m_SteamID = query.getColumn(s_TableSessionHistory.COL_ACCOUNT_ID);
+		info.m_Name = query.getColumn(s_TableSessionHistory.COL_NAME).getString();
+		info.m_FirstSeen = query.getColumn(s_TableSessionHistory.COL_FIRST_SEEN);
+		info.m_LastSeen = query.getColumn(s_TableSessionHistory.COL_LAST_SEEN);
+		info.m_Kills = query.getColumn(s_TableSessionHistory.COL_KILLS).getUInt();
+		info.m_Deaths = query.getColumn(s_TableSessionHistory.COL_DEATHS).getUInt();
+		return info;
+	}
+
+	bool TempDB::TryGet(SessionHistoryInfo& info) const
+	{
+		auto query = SelectStatementBuilder(s_TableSessionHistory.GetTableName())
+			.Where(s_TableSessionHistory.COL_ACCOUNT_ID == info.GetSteamID())
+			.Run(m_Connection.value());
+
+		if (query.executeStep())
+		{
+			info = DeserializeSessionHistoryInfo(query);
+			return true;
+		}
+
+		return false;
+	}
+
+	std::vector<SessionHistoryInfo> TempDB::GetSessionHistory(time_point_t lastSeenAfter, size_t maxCount) const try
+	{
+		auto queryStr = mh::format(R"SQL(
+SELECT * FROM {tbl_SessionHistory} WHERE {col_LastSeen} >= $lastSeenAfter ORDER BY {col_LastSeen} DESC LIMIT $maxCount)SQL",
+
+			mh::fmtarg("tbl_SessionHistory", s_TableSessionHistory.GetTableName()),
+			mh::fmtarg("col_LastSeen", s_TableSessionHistory.COL_LAST_SEEN.m_Name));
+
+		Statement2 query(SQLite::Statement(const_cast<SQLite::Database&>(m_Connection.value()), queryStr));
+		query.bind("$lastSeenAfter", ColumnDataSerializer<time_point_t>::Serialize(lastSeenAfter));
+		query.bind("$maxCount", int64_t(maxCount));
+
+		std::vector<SessionHistoryInfo> retVal;
+		while (query.executeStep())
+			retVal.push_back(DeserializeSessionHistoryInfo(query));
+
+		return retVal;
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
+	}
 }
 
 std::unique_ptr<ITempDB> tf2_bot_detector::DB::ITempDB::Create()
 {
-	return std::make_unique<TempDB>();
+	return Create(CreateDBPath());
+}
+
+std::unique_ptr<ITempDB> tf2_bot_detector::DB::ITempDB::Create(const std::filesystem::path& dbPath)
+{
+	return std::make_unique<TempDB>(dbPath.string());
+}
+
+mh::thread_pool& tf2_bot_detector::DB::ITempDB::GetIOPool()
+{
+	static mh::thread_pool s_IOPool(1);
+	return s_IOPool;
+}
+
+auto tf2_bot_detector::DB::SourceBansCacheInfo::FromResult(const std::vector<SteamID>& requested,
+	const SteamHistoryAPI::PlayerSourceBansResult& result, time_point_t now) -> std::vector<SourceBansCacheInfo>
+{
+	std::vector<SourceBansCacheInfo> retVal;
+	for (const SteamID& steamID : requested)
+	{
+		if (steamID.Type != SteamAccountType::Individual)
+			continue;
+
+		auto found = result.m_Bans.find(steamID);
+		if (found == result.m_Bans.end() && !result.m_IsComplete)
+			continue;
+
+		SourceBansCacheInfo& info = retVal.emplace_back();
+		info.m_SteamID = steamID;
+		info.m_LastCacheUpdateTime = now;
+		if (found != result.m_Bans.end())
+			info.m_Bans = found->second;
+	}
+
+	return retVal;
 }
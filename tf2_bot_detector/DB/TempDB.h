@@ -2,14 +2,19 @@
 
 #include "Networking/LogsTFAPI.h"
 #include "Networking/SteamAPI.h"
+#include "Networking/SteamHistoryAPI.h"
 #include "Clock.h"
 #include "SteamID.h"
 
+#include <mh/concurrency/thread_pool.hpp>
 #include <mh/coroutine/task.hpp>
 #include <mh/memory/stack_info.hpp>
 
 #include <cassert>
+#include <filesystem>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace tf2_bot_detector::DB
 {
@@ -73,12 +78,70 @@ namespace tf2_bot_detector::DB
 		duration_t GetCacheLiveTime() const override final { return day_t(7); }
 	};
 
+	enum class SourceBansCacheState
+	{
+		Fresh,    // Use as-is
+		Stale,    // Show it, but look the player up again
+		Expired,  // Too old to show at all
+	};
+
+	struct SourceBansCacheInfo final : detail::BaseCacheInfo_SteamID, detail::BaseCacheInfo_Expiration
+	{
+		// Empty for players with no bans, so they don't get looked up again every session either
+		SteamHistoryAPI::PlayerSourceBans m_Bans;
+
+		// New bans on players we already know about are rare, but should still show up within a day or so
+		duration_t GetCacheLiveTime() const override { return m_Bans.empty() ? day_t(1) : day_t(3); }
+
+		// Past GetCacheLiveTime(), but still shown while it is being refreshed
+		duration_t GetCacheStaleTime() const { return day_t(30); }
+
+		SourceBansCacheState GetCacheState(time_point_t now) const
+		{
+			const auto age = now - m_LastCacheUpdateTime;
+			if (age <= GetCacheLiveTime())
+				return SourceBansCacheState::Fresh;
+			if (age <= GetCacheStaleTime())
+				return SourceBansCacheState::Stale;
+
+			return SourceBansCacheState::Expired;
+		}
+
+		/// <summary>
+		/// What to cache for a batch of requested players. Players missing from an incomplete
+		/// result are left out, rather than being remembered as having no bans.
+		/// </summary>
+		static std::vector<SourceBansCacheInfo> FromResult(const std::vector<SteamID>& requested,
+			const SteamHistoryAPI::PlayerSourceBansResult& result, time_point_t now);
+	};
+
+	// A player that was dropped from WorldState to keep memory usage flat during long sessions
+	struct SessionHistoryInfo final : detail::BaseCacheInfo_SteamID
+	{
+		std::string m_Name;
+		time_point_t m_FirstSeen{};
+		time_point_t m_LastSeen{};
+		uint32_t m_Kills = 0;
+		uint32_t m_Deaths = 0;
+
+		// Rows last seen longer ago than this are deleted the next time anything is stored
+		static duration_t GetMaxAge() { return day_t(30); }
+	};
+
 	class ITempDB
 	{
 	public:
 		virtual ~ITempDB() = default;
 
 		static std::unique_ptr<ITempDB> Create();
+		static std::unique_ptr<ITempDB> Create(const std::filesystem::path& dbPath);
+
+		/// <summary>
+		/// Coroutines co_await GetIOPool().co_add_task() before touching the TempDB, so none of
+		/// the SQLite I/O happens on the main thread. One thread is plenty, the connection is
+		/// serialized anyway.
+		/// </summary>
+		static mh::thread_pool& GetIOPool();
 
 		virtual void Store(const AccountAgeInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(AccountAgeInfo& info) const = 0;
@@ -90,6 +153,19 @@ namespace tf2_bot_detector::DB
 		virtual void Store(const AccountInventorySizeInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(AccountInventorySizeInfo& info) const = 0;
 
+		virtual void Store(const SourceBansCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(SourceBansCacheInfo& info) const = 0;
+
+		/// <summary>
+		/// Stores a batch of players in one transaction. Players that are already in the
+		/// history keep their earliest m_FirstSeen.
+		/// </summary>
+		virtual void Store(const std::vector<SessionHistoryInfo>& infos) = 0;
+		[[nodiscard]] virtual bool TryGet(SessionHistoryInfo& info) const = 0;
+
+		// Most recently seen first
+		virtual std::vector<SessionHistoryInfo> GetSessionHistory(time_point_t lastSeenAfter, size_t maxCount) const = 0;
+
 		template<typename TInfo, typename TUpdateFunc>
 		mh::task<> GetOrUpdateAsync(TInfo& info, TUpdateFunc&& updateFunc)
 		{
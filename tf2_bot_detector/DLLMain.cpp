@@ -5,12 +5,14 @@
 #include "Util/TextUtils.h"
 #include "Log.h"
 #include "Filesystem.h"
+#include "UpdateScheduler.h"
 
 #include <mh/text/string_insertion.hpp>
 
 #include "UI/MainWindow.h"
 #include "UI/SettingsWindow.h"
 #include "UI/PlayerListManagementWindow.h"
+#include <algorithm>
 #include <chrono>
 
 #ifdef WIN32
@@ -92,15 +94,17 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 #ifdef _DEBUG
 			if (!strcmp(argv[i], "--static-seed") && (i + 1) < argc)
 				tf2_bot_detector::g_StaticRandomSeed = atoi(argv[i + 1]);
-			else if (!strcmp(argv[i], "--run-tests"))
+#endif
+			// Not debug only, benchmarks need release builds
+			if (!strcmp(argv[i], "--run-tests"))
 			{
 #ifdef TF2BD_ENABLE_TESTS
-				return tf2_bot_detector::RunTests();
+				// Everything after --run-tests goes to Catch2 (test specs, --reporter xml, --out, ...)
+				return tf2_bot_detector::RunTests(argc - i, argv + i);
 #else
 				LogError("--run-tests was on the command line, but tests were not compiled in");
 #endif
 			}
-#endif
 		}
 
 		if (running_from_steam) {
@@ -145,29 +149,41 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 			});
 		}
 
-		std::chrono::milliseconds last_update;
-		auto now_milis = []() {
-			return std::chrono::duration_cast<std::chrono::milliseconds>(
-				std::chrono::steady_clock::now().time_since_epoch()
-			);
-		};
+		auto& scheduler = UpdateScheduler::Get();
+		scheduler.SetWakeCallback([&renderer]() { renderer.Wake(); });
 
 		DebugLog("Entering event loop...");
+		bool settleFrame = false;
 		while (!renderer.ShouldQuit()) {
-			// app is in focus or app queued update (/sleep disabled)
-			if ((renderer.InFocus() || app->ShouldUpdate())) {
-				app->Update();
-				last_update = now_milis();
+			// while we're in focus (or sleeping is disabled) draw every frame, vsync and the
+			// renderer's frame delay pace us. animations (marked player pulses, spinners) and
+			// anything that changed without telling the scheduler stay live that way.
+			const bool continuous = renderer.InFocus() || !app->IsSleepingEnabled();
+
+			// otherwise block until input, a wakeup, or the next time the app has something
+			// to do. console.log changes don't go through SDL, so check on them every so often.
+			bool hasInput = continuous && renderer.WaitForEvents(0);
+			while (!continuous && !hasInput && !settleFrame && !app->ShouldUpdate() && !scheduler.IsWoken() &&
+				!scheduler.IsDeadlineReached() && !scheduler.IsRedrawDue()) {
+				const auto now = tfbd_clock_t::now();
+				const auto timeLeft = std::chrono::duration_cast<std::chrono::milliseconds>(std::min<duration_t>({
+					scheduler.GetNextDeadline() - now, scheduler.GetRedrawDeadline() - now, UpdateScheduler::SLEEP_POLL_INTERVAL }));
+
+				hasInput = renderer.WaitForEvents(static_cast<int>(std::max<std::chrono::milliseconds::rep>(timeLeft.count(), 0)));
 			}
-			// 100ms since last update (and sleeping)
-			// TODO: make this configurable?
-			else if (last_update + std::chrono::milliseconds(100) < now_milis()) {
+
+			if (hasInput || app->ShouldUpdate() || scheduler.IsWoken() || scheduler.IsDeadlineReached())
 				app->Update();
-				last_update = now_milis();
-			}
 
-			renderer.DrawFrame();
+			// in the background, only redraw if something changed. imgui needs one more frame
+			// after input to settle (hover states, popups opening), so give it that too.
+			if (scheduler.ConsumeDirty() || continuous || hasInput || settleFrame) {
+				renderer.DrawFrame();
+				settleFrame = hasInput;
+			}
 		}
+
+		scheduler.SetWakeCallback(nullptr);
 #endif
 	}
 
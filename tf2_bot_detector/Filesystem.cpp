@@ -7,7 +7,9 @@
 #include <mh/text/string_insertion.hpp>
 #include <mh/utility.hpp>
 
+#include <atomic>
 #include <fstream>
+#include <mutex>
 
 using namespace tf2_bot_detector;
 
@@ -30,6 +32,8 @@ namespace
 		mh::generator<std::filesystem::directory_entry> IterateDir(std::filesystem::path path, bool recursive,
 			std::filesystem::directory_options options) const override;
 
+		void SetRootOverride(std::filesystem::path root) override;
+
 	private:
 		bool m_IsInit = false;
 		void EnsureInit(MH_SOURCE_LOCATION_AUTO(location)) const;
@@ -40,6 +44,10 @@ namespace
 
 		mh::thread_sentinel m_Sentinel;
 
+		std::filesystem::path m_RootOverride;
+		mutable std::mutex m_RootOverrideMutex;
+		std::filesystem::path GetRootOverride() const;
+
 		std::filesystem::path m_ExeDir;
 		std::filesystem::path m_WorkingDir;
 #ifndef __linux__
@@ -133,6 +141,15 @@ std::filesystem::path Filesystem::ResolvePath(const std::filesystem::path& path,
 	if (path.is_absolute())
 		return path;
 
+	if (auto root = GetRootOverride(); !root.empty())
+	{
+		auto fullPath = root / path;
+		if (usage == PathUsage::Read && !std::filesystem::exists(fullPath))
+			return {};
+
+		return fullPath;
+	}
+
 	EnsureInit();
 
 	auto retVal = std::invoke([&]() -> std::filesystem::path
@@ -210,12 +227,31 @@ void Filesystem::WriteFile(std::filesystem::path path, const void* begin, const
 	if (auto folderPath = mh::copy(path).remove_filename(); std::filesystem::create_directories(folderPath))
 		DebugLog("Created one or more directories in the path {}", folderPath);
 
-	std::ofstream file;
-	file.exceptions(std::ios::badbit | std::ios::failbit);
-	file.open(path, std::ios::binary | std::ios::trunc);
+	// Write next to the real file and swap it in, so nobody (including us, after a crash)
+	// ever sees a half-written file.
+	static std::atomic<uint32_t> s_TempFileCounter = 0;
+	auto tempPath = path;
+	tempPath += mh::format(".{}.tmp", ++s_TempFileCounter);
+
+	try
+	{
+		{
+			std::ofstream file;
+			file.exceptions(std::ios::badbit | std::ios::failbit);
+			file.open(tempPath, std::ios::binary | std::ios::trunc);
 
-	const auto bytes = uintptr_t(end) - uintptr_t(begin);
-	file.write(reinterpret_cast<const char*>(begin), bytes);
+			const auto bytes = uintptr_t(end) - uintptr_t(begin);
+			file.write(reinterpret_cast<const char*>(begin), bytes);
+		}
+
+		std::filesystem::rename(tempPath, path);
+	}
+	catch (...)
+	{
+		std::error_code ec;
+		std::filesystem::remove(tempPath, ec);
+		throw;
+	}
 }
 catch (...)
 {
@@ -225,6 +261,9 @@ catch (...)
 
 std::filesystem::path Filesystem::GetLocalAppDataDir() const
 {
+	if (auto root = GetRootOverride(); !root.empty())
+		return root;
+
 	EnsureInit();
 
 	return m_ExeDir;
@@ -232,11 +271,29 @@ std::filesystem::path Filesystem::GetLocalAppDataDir() const
 
 std::filesystem::path Filesystem::GetTempDir() const
 {
+	if (auto root = GetRootOverride(); !root.empty())
+		return root / "temp";
+
 	EnsureInit();
 
 	return m_ExeDir / "temp";
 }
 
+void Filesystem::SetRootOverride(std::filesystem::path root)
+{
+	assert(root.empty() || root.is_absolute());
+
+	std::lock_guard lock(m_RootOverrideMutex);
+	m_RootOverride = std::move(root);
+}
+
+std::filesystem::path Filesystem::GetRootOverride() const
+{
+	// Config files get resolved from thread pool threads too
+	std::lock_guard lock(m_RootOverrideMutex);
+	return m_RootOverride;
+}
+
 void Filesystem::EnsureInit(const mh::source_location& location) const
 {
 	if (!m_IsInit)
@@ -248,7 +305,7 @@ void Filesystem::EnsureInit(const mh::source_location& location) const
 
 template<typename TIter>
 static mh::generator<std::filesystem::directory_entry> IterateDirImpl(
-	const std::vector<std::filesystem::path>& searchPaths, std::filesystem::path path, std::filesystem::directory_options options)
+	std::vector<std::filesystem::path> searchPaths, std::filesystem::path path, std::filesystem::directory_options options)
 {
 	for (std::filesystem::path searchPath : searchPaths)
 	{
@@ -267,8 +324,14 @@ mh::generator<std::filesystem::directory_entry> Filesystem::IterateDir(std::file
 {
 	assert(!path.is_absolute());
 
+	std::vector<std::filesystem::path> searchPaths;
+	if (auto root = GetRootOverride(); !root.empty())
+		searchPaths.push_back(std::move(root));
+	else
+		searchPaths = m_SearchPaths;
+
 	if (recursive)
-		return IterateDirImpl<std::filesystem::recursive_directory_iterator>(m_SearchPaths, std::move(path), options);
+		return IterateDirImpl<std::filesystem::recursive_directory_iterator>(std::move(searchPaths), std::move(path), options);
 	else
-		return IterateDirImpl<std::filesystem::directory_iterator>(m_SearchPaths, std::move(path), options);
+		return IterateDirImpl<std::filesystem::directory_iterator>(std::move(searchPaths), std::move(path), options);
 }
@@ -44,6 +44,11 @@ namespace tf2_bot_detector
 		virtual mh::generator<std::filesystem::directory_entry> IterateDir(std::filesystem::path path, bool recursive,
 			std::filesystem::directory_options options = std::filesystem::directory_options::none) const = 0;
 
+		// Resolves every relative path (reads and writes) under root, and nowhere else, until
+		// it's set back to an empty path. Lets tests use real config files without ever seeing
+		// or touching the user's.
+		virtual void SetRootOverride(std::filesystem::path root) = 0;
+
 		void WriteFile(const std::filesystem::path& path, const std::string_view& data, PathUsage usage) const
 		{
 			return WriteFile(path, data.data(), data.data() + data.size(), usage);
@@ -0,0 +1,226 @@
+#include "FriendsGraph.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	uint32_t CountIntersection(const std::vector<SteamID>& a, const std::vector<SteamID>& b)
+	{
+		const auto& smaller = a.size() < b.size() ? a : b;
+		const auto& larger = a.size() < b.size() ? b : a;
+
+		uint32_t count = 0;
+
+		// A few hundred friends vs thousands of marked players, binary search is way ahead
+		if (smaller.size() * 16 < larger.size())
+		{
+			for (const SteamID& id : smaller)
+			{
+				if (std::binary_search(larger.begin(), larger.end(), id))
+					count++;
+			}
+
+			return count;
+		}
+
+		auto itA = a.begin();
+		auto itB = b.begin();
+		while (itA != a.end() && itB != b.end())
+		{
+			if (*itA < *itB)
+				++itA;
+			else if (*itB < *itA)
+				++itB;
+			else
+			{
+				count++;
+				++itA;
+				++itB;
+			}
+		}
+
+		return count;
+	}
+
+	bool SetContains(const std::vector<SteamID>& set, const SteamID& id)
+	{
+		return std::binary_search(set.begin(), set.end(), id);
+	}
+
+	void SetInsertOrErase(std::vector<SteamID>& set, const SteamID& id, bool insert)
+	{
+		const auto it = std::lower_bound(set.begin(), set.end(), id);
+		const bool found = it != set.end() && *it == id;
+
+		if (insert && !found)
+			set.insert(it, id);
+		else if (!insert && found)
+			set.erase(it);
+	}
+
+	void SortUnique(std::vector<SteamID>& set)
+	{
+		std::sort(set.begin(), set.end());
+		set.erase(std::unique(set.begin(), set.end()), set.end());
+	}
+}
+
+void FriendsGraph::SetAllMarks(std::vector<std::pair<SteamID, PlayerAttributesList>> marks)
+{
+	for (auto& set : m_MarkedSets)
+		set.clear();
+	m_AnyMarkedSet.clear();
+
+	for (const auto& [id, attributes] : marks)
+	{
+		if (!attributes)
+			continue;
+
+		for (size_t i = 0; i < m_MarkedSets.size(); i++)
+		{
+			if (attributes.HasAttribute(PlayerAttribute(i)))
+				m_MarkedSets[i].push_back(id);
+		}
+
+		m_AnyMarkedSet.push_back(id);
+	}
+
+	// The same player can show up in more than one list
+	for (auto& set : m_MarkedSets)
+		SortUnique(set);
+	SortUnique(m_AnyMarkedSet);
+
+	for (auto& [id, node] : m_Nodes)
+		Recount(node);
+}
+
+void FriendsGraph::SetPlayerMarks(const SteamID& id, const PlayerAttributesList& attributes)
+{
+	const PlayerAttributesList oldAttributes = GetPlayerMarks(id);
+
+	std::array<int32_t, size_t(PlayerAttribute::COUNT)> deltas{};
+	bool changed = false;
+	for (size_t i = 0; i < m_MarkedSets.size(); i++)
+	{
+		const bool wasSet = oldAttributes.HasAttribute(PlayerAttribute(i));
+		const bool isSet = attributes.HasAttribute(PlayerAttribute(i));
+		if (wasSet == isSet)
+			continue;
+
+		SetInsertOrErase(m_MarkedSets[i], id, isSet);
+		deltas[i] = isSet ? 1 : -1;
+		changed = true;
+	}
+
+	if (!changed)
+		return;
+
+	const bool wasMarked = !!oldAttributes;
+	const bool isMarked = !!attributes;
+	SetInsertOrErase(m_AnyMarkedSet, id, isMarked);
+
+	for (auto& [nodeID, node] : m_Nodes)
+	{
+		if (!SetContains(node.m_Friends, id))
+			continue;
+
+		for (size_t i = 0; i < deltas.size(); i++)
+			node.m_Counts.m_Attributes[i] += deltas[i];
+
+		node.m_Counts.m_Marked += int32_t(isMarked) - int32_t(wasMarked);
+	}
+}
+
+PlayerAttributesList FriendsGraph::GetPlayerMarks(const SteamID& id) const
+{
+	PlayerAttributesList retVal;
+
+	for (size_t i = 0; i < m_MarkedSets.size(); i++)
+	{
+		if (SetContains(m_MarkedSets[i], id))
+			retVal.SetAttribute(PlayerAttribute(i));
+	}
+
+	return retVal;
+}
+
+void FriendsGraph::SetFriends(const SteamID& id, const std::unordered_set<SteamID>& friends)
+{
+	Node& node = m_Nodes[id];
+	node.m_Friends.assign(friends.begin(), friends.end());
+	std::sort(node.m_Friends.begin(), node.m_Friends.end());
+	Recount(node);
+}
+
+const FriendsMarkCounts* FriendsGraph::GetMarkCounts(const SteamID& id) const
+{
+	if (auto found = m_Nodes.find(id); found != m_Nodes.end())
+		return &found->second.m_Counts;
+
+	return nullptr;
+}
+
+bool FriendsGraph::AreFriends(const SteamID& a, const SteamID& b) const
+{
+	if (auto found = m_Nodes.find(a); found != m_Nodes.end() && SetContains(found->second.m_Friends, b))
+		return true;
+	if (auto found = m_Nodes.find(b); found != m_Nodes.end() && SetContains(found->second.m_Friends, a))
+		return true;
+
+	return false;
+}
+
+std::vector<std::vector<SteamID>> FriendsGraph::FindClusters(const std::vector<SteamID>& players) const
+{
+	// Union-find over indices into players
+	std::vector<size_t> parents(players.size());
+	std::iota(parents.begin(), parents.end(), size_t(0));
+
+	const auto FindRoot = [&](size_t i)
+	{
+		while (parents[i] != i)
+			i = parents[i] = parents[parents[i]];
+
+		return i;
+	};
+
+	for (size_t i = 0; i < players.size(); i++)
+	{
+		auto found = m_Nodes.find(players[i]);
+		if (found == m_Nodes.end())
+			continue;
+
+		for (size_t j = 0; j < players.size(); j++)
+		{
+			if (i != j && SetContains(found->second.m_Friends, players[j]))
+				parents[FindRoot(i)] = FindRoot(j);
+		}
+	}
+
+	std::unordered_map<size_t, std::vector<SteamID>> groups;
+	for (size_t i = 0; i < players.size(); i++)
+		groups[FindRoot(i)].push_back(players[i]);
+
+	std::vector<std::vector<SteamID>> clusters;
+	for (auto& [root, members] : groups)
+	{
+		if (members.size() >= 2)
+			clusters.push_back(std::move(members));
+	}
+
+	std::sort(clusters.begin(), clusters.end(), [](const auto& a, const auto& b) { return a.size() > b.size(); });
+	return clusters;
+}
+
+void FriendsGraph::Recount(Node& node) const
+{
+	node.m_Counts.m_Friends = uint32_t(node.m_Friends.size());
+
+	for (size_t i = 0; i < m_MarkedSets.size(); i++)
+		node.m_Counts.m_Attributes[i] = CountIntersection(node.m_Friends, m_MarkedSets[i]);
+
+	node.m_Counts.m_Marked = CountIntersection(node.m_Friends, m_AnyMarkedSet);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Config/PlayerListJSON.h"
+#include "SteamID.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	struct FriendsMarkCounts
+	{
+		std::array<uint32_t, size_t(PlayerAttribute::COUNT)> m_Attributes{};
+
+		// Friends with at least one attribute
+		uint32_t m_Marked = 0;
+		uint32_t m_Friends = 0;
+	};
+
+	/// <summary>
+	/// The friends lists of the players we've seen recently, plus sorted sets of everyone
+	/// that is marked with each attribute. A player's marked friend counts are the sizes of
+	/// the intersections of the two, worked out once when the friends list shows up, and
+	/// then only adjusted for the players whose marks actually changed.
+	/// </summary>
+	class FriendsGraph final
+	{
+	public:
+		// Replaces every marked set, and recounts everyone.
+		void SetAllMarks(std::vector<std::pair<SteamID, PlayerAttributesList>> marks);
+
+		// One player's marks changed.
+		void SetPlayerMarks(const SteamID& id, const PlayerAttributesList& attributes);
+		PlayerAttributesList GetPlayerMarks(const SteamID& id) const;
+
+		void SetFriends(const SteamID& id, const std::unordered_set<SteamID>& friends);
+		bool HasFriends(const SteamID& id) const { return m_Nodes.contains(id); }
+		void RemoveFriends(const SteamID& id) { m_Nodes.erase(id); }
+		size_t GetPlayerCount() const { return m_Nodes.size(); }
+
+		// nullptr if we don't know their friends list
+		const FriendsMarkCounts* GetMarkCounts(const SteamID& id) const;
+
+		// Are a and b friends, according to either one's friends list? (friends lists can be private)
+		bool AreFriends(const SteamID& a, const SteamID& b) const;
+
+		// Groups of two or more players that are connected to each other through friendships
+		// with other players in the group. Biggest first.
+		std::vector<std::vector<SteamID>> FindClusters(const std::vector<SteamID>& players) const;
+
+		template<typename TFunc> void ForEachPlayer(TFunc&& func) const
+		{
+			for (const auto& [id, node] : m_Nodes)
+				func(id);
+		}
+
+	private:
+		struct Node
+		{
+			std::vector<SteamID> m_Friends; // sorted
+			FriendsMarkCounts m_Counts;
+		};
+
+		std::unordered_map<SteamID, Node> m_Nodes;
+
+		// sorted
+		std::array<std::vector<SteamID>, size_t(PlayerAttribute::COUNT)> m_MarkedSets;
+		std::vector<SteamID> m_AnyMarkedSet;
+
+		void Recount(Node& node) const;
+	};
+}
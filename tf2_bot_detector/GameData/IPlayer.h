@@ -2,15 +2,14 @@
 
 #include "Clock.h"
 #include "SteamID.h"
+#include "GameData/PlayerDataSlots.h"
 #include "GameData/TFConstants.h"
 
 #include <mh/error/expected.hpp>
 
-#include <any>
 #include <cstdint>
 #include <optional>
 #include <ostream>
-#include <typeindex>
 
 namespace tf2_bot_detector
 {
@@ -83,7 +82,7 @@ namespace tf2_bot_detector
 		virtual duration_t GetConnectedTime() const = 0;
 
 		virtual TFTeam GetTeam() const = 0;
-		virtual const PlayerScores& GetScores() const = 0;
+		virtual PlayerScores GetScores() const = 0;
 		virtual uint16_t GetPing() const = 0;
 
 		virtual time_point_t GetLastStatusUpdateTime() const = 0;
@@ -96,6 +95,8 @@ namespace tf2_bot_detector
 
 		virtual const mh::expected<LogsTFAPI::PlayerLogsInfo>& GetLogsInfo() const = 0;
 		virtual const mh::expected<SteamAPI::PlayerFriends>& GetFriendsInfo() const = 0;
+		// Like GetFriendsInfo(), but never starts a fetch. nullptr until something else has fetched it.
+		virtual const SteamAPI::PlayerFriends* TryGetFriendsInfo() const = 0;
 		virtual const mh::expected<SteamAPI::PlayerInventoryInfo>& GetInventoryInfo() const = 0;
 
 		// The time that this player has been in the "active" state.
@@ -109,28 +110,22 @@ namespace tf2_bot_detector
 		}
 		template<typename T, typename... TArgs> inline T& GetOrCreateData(TArgs&&... args)
 		{
-			auto& storage = GetOrCreateDataStorage(typeid(T));
-			if (!storage.has_value())
-				return storage.emplace<T>(std::forward<TArgs>(args)...);
-			else
-				return std::any_cast<T&>(storage);
+			return GetDataSlots().GetOrCreate<T>(std::forward<TArgs>(args)...);
 		}
 		template<typename T> inline const T* GetData() const
 		{
-			return std::any_cast<T>(FindDataStorage(typeid(T)));
+			return GetDataSlots().Find<T>();
 		}
 		template<typename T> inline void SetData(T&& value)
 		{
-			GetOrCreateDataStorage(typeid(T)) = std::move(value);
+			GetDataSlots().Set(std::forward<T>(value));
 		}
 
-		virtual std::any& GetOrCreateDataStorage(const std::type_index& type) = 0;
-
 	protected:
-		virtual const std::any* FindDataStorage(const std::type_index& type) const = 0;
-		virtual std::any* FindDataStorage(const std::type_index& type)
+		virtual const PlayerDataSlots& GetDataSlots() const = 0;
+		virtual PlayerDataSlots& GetDataSlots()
 		{
-			return const_cast<std::any*>(std::as_const(*this).FindDataStorage(type));
+			return const_cast<PlayerDataSlots&>(std::as_const(*this).GetDataSlots());
 		}
 	};
 }
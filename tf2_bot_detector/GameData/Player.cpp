@@ -35,11 +35,18 @@ using namespace tf2_bot_detector;
 
 
 Player::Player(WorldState& world, SteamID id) :
-	m_World(&world)
+	m_World(&world),
+	m_Table(world.m_PlayerTable),
+	m_TableIndex(m_Table->Add(id, this))
 {
 	m_Status.m_SteamID = id;
 }
 
+Player::~Player()
+{
+	m_Table->Remove(m_TableIndex);
+}
+
 const WorldState& Player::GetWorld() const
 {
 	assert(m_World);
@@ -134,7 +141,7 @@ const mh::expected<T>& Player::GetOrFetchDataAsync(mh::expected<T>& var, TFunc&&
 
 			auto sharedThis = shared_from_this();
 
-			[](std::shared_ptr<const Player> sharedThis, std::shared_ptr<const IHTTPClient> client,
+			const auto fetch = [](std::shared_ptr<const Player> sharedThis, std::shared_ptr<const IHTTPClient> client,
 				mh::expected<T>& var, std::vector<std::error_condition> silentErrors, TFunc updateFunc,
 				mh::source_location location) -> mh::task<>
 			{
@@ -158,7 +165,7 @@ const mh::expected<T>& Player::GetOrFetchDataAsync(mh::expected<T>& var, TFunc&&
 						result = ErrorCode::UnknownError;
 					}
 
-					co_await GetDispatcher().co_dispatch();  // switch to main thread
+					co_await SwitchToMainThread();
 
 					var = std::move(result);
 				}
@@ -167,30 +174,61 @@ const mh::expected<T>& Player::GetOrFetchDataAsync(mh::expected<T>& var, TFunc&&
 					LogException(location);
 				}
 
-			}(sharedThis, client, var, silentErrors, std::move(updateFunc), location);
+			};
+
+			// Started once the world's scheduler gets to us, so the players that matter most go first
+			m_World->QueuePlayerFetch(GetSteamID(),
+				[=, &var, silentErrors = std::vector<std::error_condition>(silentErrors)]
+				{
+					return fetch(sharedThis, client, var, silentErrors, updateFunc, location);
+				},
+				[sharedThis, &var]
+				{
+					// They left before we got to them. Not LazyValueUninitialized, or anything
+					// still polling for it would queue it right back up. SetStatus resets it if
+					// they come back.
+					var = ErrorCode::PlayerDeparted;
+				});
 		}
 	}
 
 	return var;
 }
 
-const mh::expected<LogsTFAPI::PlayerLogsInfo>& Player::GetLogsInfo() const
+const mh::expected<LogsTFAPI::PlayerLogsInfo>& Player::QueueLogsInfo(LogsTFAPI::RequestPriority priority) const
 {
-	return GetOrFetchDataAsync(m_LogsInfo,
-		[&](std::shared_ptr<const Player> pThis, auto client) -> mh::task<LogsTFAPI::PlayerLogsInfo>
+	m_Sentinel.check();
+
+	if (m_LogsInfo == ErrorCode::LazyValueUninitialized ||
+		m_LogsInfo == ErrorCode::InternetConnectivityDisabled)
+	{
+		if (!m_World->GetSettings().GetHTTPClient())
 		{
-			DB::ITempDB& cacheDB = TF2BDApplication::GetApplication().GetTempDB();
+			m_LogsInfo = ErrorCode::InternetConnectivityDisabled;
+		}
+		else
+		{
+			m_LogsInfo = std::errc::operation_in_progress;
+			m_World->QueuePlayerLogsUpdate(GetSteamID(), priority);
+		}
+	}
+	else if (!m_LogsInfo && m_LogsInfo.error() == std::errc::operation_in_progress)
+	{
+		// Bumps a prefetch up the queue once someone actually wants to see it
+		m_World->QueuePlayerLogsUpdate(GetSteamID(), priority);
+	}
 
-			DB::LogsTFCacheInfo cacheInfo{};
-			cacheInfo.m_ID = pThis->GetSteamID();
+	return m_LogsInfo;
+}
 
-			co_await cacheDB.GetOrUpdateAsync(cacheInfo, [&client](DB::LogsTFCacheInfo& info) -> mh::task<>
-				{
-					info = co_await LogsTFAPI::GetPlayerLogsInfoAsync(client, info.m_ID);
-				});
+const mh::expected<LogsTFAPI::PlayerLogsInfo>& Player::GetLogsInfo() const
+{
+	return QueueLogsInfo(LogsTFAPI::RequestPriority::Visible);
+}
 
-			co_return cacheInfo;
-		});
+void Player::PrefetchLogsInfo() const
+{
+	QueueLogsInfo(LogsTFAPI::RequestPriority::Background);
 }
 
 const mh::expected<SteamAPI::PlayerFriends>& Player::GetFriendsInfo() const
@@ -211,6 +249,11 @@ const mh::expected<SteamAPI::PlayerFriends>& Player::GetFriendsInfo() const
 		});
 }
 
+const SteamAPI::PlayerFriends* Player::TryGetFriendsInfo() const
+{
+	return m_FriendsInfo.has_value() ? &m_FriendsInfo.value() : nullptr;
+}
+
 const mh::expected<SteamAPI::PlayerInventoryInfo>& Player::GetInventoryInfo() const
 {
 	return GetOrFetchDataAsync(m_InventoryInfo,
@@ -257,10 +300,10 @@ bool Player::IsFriend() const
 
 duration_t Player::GetActiveTime() const
 {
-	if (m_Status.m_State != PlayerStatusState::Active)
+	if (GetConnectionState() != PlayerStatusState::Active)
 		return 0s;
 
-	return m_LastStatusUpdateTime - m_LastStatusActiveBegin;
+	return GetLastStatusUpdateTime() - m_LastStatusActiveBegin;
 }
 
 std::optional<time_point_t> Player::GetEstimatedAccountCreationTime() const
@@ -274,30 +317,37 @@ std::optional<time_point_t> Player::GetEstimatedAccountCreationTime() const
 	return m_World->GetAccountAges().EstimateAccountCreationTime(GetSteamID());
 }
 
+template<typename T>
+static void ResetIfDeparted(mh::expected<T>& var)
+{
+	if (var == ErrorCode::PlayerDeparted)
+		var = ErrorCode::LazyValueUninitialized;
+}
+
 void Player::SetStatus(PlayerStatus status, time_point_t timestamp)
 {
-	if (m_Status.m_State != PlayerStatusState::Active && status.m_State == PlayerStatusState::Active)
+	// Anything cancelled while they were gone can be fetched again now that they're back
+	ResetIfDeparted(m_TF2Playtime);
+	ResetIfDeparted(m_FriendsInfo);
+	ResetIfDeparted(m_InventoryInfo);
+
+	if (GetConnectionState() != PlayerStatusState::Active && status.m_State == PlayerStatusState::Active)
 		m_LastStatusActiveBegin = timestamp;
 
+	const std::string oldName = std::move(m_Status.m_Name);
 	m_Status = std::move(status);
-	m_LastStatusUpdateTime = m_LastPingUpdateTime = timestamp;
-}
 
-void Player::SetPing(uint16_t ping, time_point_t timestamp)
-{
-	m_Status.m_Ping = ping;
-	m_LastPingUpdateTime = timestamp;
-}
+	m_Table->m_States[m_TableIndex] = m_Status.m_State;
+	m_Table->m_Pings[m_TableIndex] = m_Status.m_Ping;
+	m_Table->m_LastStatusUpdateTimes[m_TableIndex] = timestamp;
+	m_Table->m_LastPingUpdateTimes[m_TableIndex] = timestamp;
 
-const std::any* Player::FindDataStorage(const std::type_index& type) const
-{
-	if (auto found = m_UserData.find(type); found != m_UserData.end())
-		return &found->second;
-
-	return nullptr;
+	m_World->UpdatePlayerNameIndex(GetSteamID(), oldName, m_Status.m_Name, timestamp);
 }
 
-std::any& Player::GetOrCreateDataStorage(const std::type_index& type)
+void Player::SetPing(uint16_t ping, time_point_t timestamp)
 {
-	return m_UserData[type];
+	m_Status.m_Ping = ping;
+	m_Table->m_Pings[m_TableIndex] = ping;
+	m_Table->m_LastPingUpdateTimes[m_TableIndex] = timestamp;
 }
@@ -10,6 +10,7 @@
 #include "Networking/SteamHistoryAPI.h"
 
 #include "GameData/IPlayer.h"
+#include "GameData/PlayerTable.h"
 
 #include "ConsoleLog/ConsoleLogParser.h"
 #include "ConsoleLog/ConsoleLineListener.h"
@@ -22,20 +23,23 @@ namespace tf2_bot_detector
 	{
 	public:
 		Player(tf2_bot_detector::WorldState& world, SteamID id);
+		Player(const Player&) = delete;
+		Player& operator=(const Player&) = delete;
+		~Player();
 
 		tf2_bot_detector::WorldState& GetWorld() override { return static_cast<tf2_bot_detector::WorldState&>(IPlayer::GetWorld()); }
 		const tf2_bot_detector::WorldState& GetWorld() const override;
 		const LobbyMember* GetLobbyMember() const override;
 		std::string GetNameUnsafe() const override { return m_Status.m_Name; }
 		tf2_bot_detector::SteamID GetSteamID() const override { return m_Status.m_SteamID; }
-		PlayerStatusState GetConnectionState() const override { return m_Status.m_State; }
+		PlayerStatusState GetConnectionState() const override { return m_Table->m_States[m_TableIndex]; }
 		std::optional<UserID_t> GetUserID() const override;
-		TFTeam GetTeam() const override { return m_Team; }
+		TFTeam GetTeam() const override { return m_Table->m_Teams[m_TableIndex]; }
 		time_point_t GetConnectionTime() const override { return m_Status.m_ConnectionTime; }
 		duration_t GetConnectedTime() const override;
-		const PlayerScores& GetScores() const override { return m_Scores; }
-		uint16_t GetPing() const override { return m_Status.m_Ping; }
-		time_point_t GetLastStatusUpdateTime() const override { return m_LastStatusUpdateTime; }
+		PlayerScores GetScores() const override { return m_Table->m_Scores[m_TableIndex]; }
+		uint16_t GetPing() const override { return m_Table->m_Pings[m_TableIndex]; }
+		time_point_t GetLastStatusUpdateTime() const override { return m_Table->m_LastStatusUpdateTimes[m_TableIndex]; }
 		const mh::expected<SteamAPI::PlayerSummary>& GetPlayerSummary() const override;
 		const mh::expected<SteamAPI::PlayerBans>& GetPlayerBans() const override;
 		const mh::expected<SteamHistoryAPI::PlayerSourceBanState>& GetPlayerSourceBanState() const override;
@@ -49,27 +53,35 @@ namespace tf2_bot_detector
 
 		const mh::expected<LogsTFAPI::PlayerLogsInfo>& GetLogsInfo() const override;
 		const mh::expected<SteamAPI::PlayerFriends>& GetFriendsInfo() const override;
+		const SteamAPI::PlayerFriends* TryGetFriendsInfo() const override;
 		const mh::expected<SteamAPI::PlayerInventoryInfo>& GetInventoryInfo() const override;
 
-		PlayerScores m_Scores{};
-		TFTeam m_Team{};
+		// Only valid until the next player is created
+		PlayerScores& GetScores() { return m_Table->m_Scores[m_TableIndex]; }
+		void SetTeam(TFTeam team) { m_Table->m_Teams[m_TableIndex] = team; }
+		void SetClientIndex(uint8_t clientIndex) { m_Table->m_ClientIndices[m_TableIndex] = clientIndex; }
+		PlayerTable::index_t GetTableIndex() const { return m_TableIndex; }
 
-		uint8_t m_ClientIndex{};
 		mutable mh::expected<SteamAPI::PlayerSummary> m_PlayerSummary = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamAPI::PlayerBans> m_PlayerSteamBans = ErrorCode::LazyValueUninitialized;
 
 		mutable mh::expected<SteamHistoryAPI::PlayerSourceBans> m_PlayerSourceBans = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamHistoryAPI::PlayerSourceBanState> m_PlayerSourceBanState = ErrorCode::LazyValueUninitialized;
 
+		mutable mh::expected<LogsTFAPI::PlayerLogsInfo> m_LogsInfo = ErrorCode::LazyValueUninitialized;
+
+		// Same as GetLogsInfo(), but doesn't jump ahead of the players someone is actually looking at
+		void PrefetchLogsInfo() const;
+
 		void SetStatus(PlayerStatus status, time_point_t timestamp);
 		const PlayerStatus& GetStatus() const { return m_Status; }
 
 		void SetPing(uint16_t ping, time_point_t timestamp);
 
 	protected:
-		std::map<std::type_index, std::any> m_UserData;
-		const std::any* FindDataStorage(const std::type_index& type) const override;
-		std::any& GetOrCreateDataStorage(const std::type_index& type) override;
+		PlayerDataSlots m_UserData;
+		const PlayerDataSlots& GetDataSlots() const override { return m_UserData; }
+		PlayerDataSlots& GetDataSlots() override { return m_UserData; }
 
 		std::shared_ptr<Player> shared_from_this() { return std::static_pointer_cast<Player>(IPlayer::shared_from_this()); }
 		std::shared_ptr<const Player> shared_from_this() const { return std::static_pointer_cast<const Player>(IPlayer::shared_from_this()); }
@@ -81,16 +93,19 @@ namespace tf2_bot_detector
 		const mh::expected<T>& GetOrFetchDataAsync(mh::expected<T>& variable, TFunc&& updateFunc,
 			std::initializer_list<std::error_condition> silentErrors = {}, MH_SOURCE_LOCATION_AUTO(location)) const;
 
+		const mh::expected<LogsTFAPI::PlayerLogsInfo>& QueueLogsInfo(LogsTFAPI::RequestPriority priority) const;
+
 		WorldState* m_World = nullptr;
+
+		// Hot fields live in here, shared with the world so scans don't have to go through us
+		std::shared_ptr<PlayerTable> m_Table;
+		PlayerTable::index_t m_TableIndex;
+
 		PlayerStatus m_Status{};
 
 		time_point_t m_LastStatusActiveBegin{};
 
-		time_point_t m_LastStatusUpdateTime{};
-		time_point_t m_LastPingUpdateTime{};
-
 		mutable mh::expected<duration_t> m_TF2Playtime = ErrorCode::LazyValueUninitialized;
-		mutable mh::expected<LogsTFAPI::PlayerLogsInfo> m_LogsInfo = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamAPI::PlayerFriends> m_FriendsInfo = ErrorCode::LazyValueUninitialized;
 		mutable mh::expected<SteamAPI::PlayerInventoryInfo> m_InventoryInfo = ErrorCode::LazyValueUninitialized;
 	};
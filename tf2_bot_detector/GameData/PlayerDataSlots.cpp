@@ -0,0 +1,28 @@
+#include "PlayerDataSlots.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+using namespace tf2_bot_detector;
+
+PlayerDataSlots::~PlayerDataSlots()
+{
+	for (Slot& slot : m_Slots)
+	{
+		if (slot.m_Data)
+			slot.m_Destroy(slot.m_Data);
+	}
+}
+
+size_t PlayerDataSlots::AllocateSlotID(const char* typeName)
+{
+	// Constant initialized, so this is safe to call from other static initializers. Logging isn't.
+	static std::atomic<size_t> s_NextSlotID = 0;
+
+	const size_t id = s_NextSlotID++;
+	if (id >= MAX_SLOTS)
+		throw std::length_error(std::string("Too many player data types, increase PlayerDataSlots::MAX_SLOTS for ") + typeName);
+
+	return id;
+}
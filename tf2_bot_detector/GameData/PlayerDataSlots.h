@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Per-player extension data (IPlayer::GetData/GetOrCreateData), stored in a fixed array
+	/// indexed by a small integer id that each type is assigned the first time it's used.
+	/// Lookups are a static init guard check and an array index, no tree walk and no RTTI
+	/// comparisons.
+	///
+	/// The data itself is constructed in a small buffer inside this object when it fits, so
+	/// the few types that exist don't cost a heap allocation per player each.
+	/// </summary>
+	class PlayerDataSlots final
+	{
+	public:
+		// There are only a handful of extension types in the whole program, bump this if we run out.
+		static constexpr size_t MAX_SLOTS = 16;
+
+		// Enough for all of them at once, anything that doesn't fit goes on the heap.
+		static constexpr size_t INLINE_STORAGE_SIZE = 256;
+
+		PlayerDataSlots() = default;
+		PlayerDataSlots(const PlayerDataSlots&) = delete;
+		PlayerDataSlots& operator=(const PlayerDataSlots&) = delete;
+		~PlayerDataSlots();
+
+		template<typename T> static size_t GetSlotID()
+		{
+			// Function local so it's always assigned before it's read, even from other
+			// static initializers
+			static const size_t s_SlotID = AllocateSlotID(typeid(T).name());
+			return s_SlotID;
+		}
+
+		template<typename T> const T* Find() const
+		{
+			return static_cast<const T*>(m_Slots[GetSlotID<T>()].m_Data);
+		}
+		template<typename T> T* Find()
+		{
+			return static_cast<T*>(m_Slots[GetSlotID<T>()].m_Data);
+		}
+
+		template<typename T, typename... TArgs> T& GetOrCreate(TArgs&&... args)
+		{
+			Slot& slot = m_Slots[GetSlotID<T>()];
+			if (!slot.m_Data)
+				Emplace<T>(slot, std::forward<TArgs>(args)...);
+
+			return *static_cast<T*>(slot.m_Data);
+		}
+
+		template<typename T> void Set(T&& value)
+		{
+			using value_type = std::decay_t<T>;
+			Slot& slot = m_Slots[GetSlotID<value_type>()];
+			if (slot.m_Data)
+				*static_cast<value_type*>(slot.m_Data) = std::forward<T>(value);
+			else
+				Emplace<value_type>(slot, std::forward<T>(value));
+		}
+
+	private:
+		static size_t AllocateSlotID(const char* typeName);
+
+		struct Slot
+		{
+			void* m_Data = nullptr;
+			void (*m_Destroy)(void* data) = nullptr;
+		};
+
+		template<typename T, typename... TArgs> void Emplace(Slot& slot, TArgs&&... args)
+		{
+			if constexpr (alignof(T) <= alignof(std::max_align_t) && sizeof(T) <= INLINE_STORAGE_SIZE)
+			{
+				const size_t offset = (m_StorageUsed + alignof(T) - 1) / alignof(T) * alignof(T);
+				if (offset + sizeof(T) <= INLINE_STORAGE_SIZE)
+				{
+					slot.m_Data = new (m_Storage + offset) T(std::forward<TArgs>(args)...);
+					slot.m_Destroy = [](void* data) { static_cast<T*>(data)->~T(); };
+					m_StorageUsed = offset + sizeof(T);
+					return;
+				}
+			}
+
+			slot.m_Data = new T(std::forward<TArgs>(args)...);
+			slot.m_Destroy = [](void* data) { delete static_cast<T*>(data); };
+		}
+
+		std::array<Slot, MAX_SLOTS> m_Slots{};
+		size_t m_StorageUsed = 0;
+		alignas(std::max_align_t) std::byte m_Storage[INLINE_STORAGE_SIZE];
+	};
+}
@@ -0,0 +1,83 @@
+#include "PlayerFetchScheduler.h"
+#include "Log.h"
+#include "UpdateScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace tf2_bot_detector;
+
+PlayerFetchScheduler::PlayerFetchScheduler(size_t maxInFlight, PriorityFunc getPriority) :
+	m_MaxInFlight(maxInFlight),
+	m_GetPriority(std::move(getPriority))
+{
+	assert(m_MaxInFlight > 0);
+}
+
+void PlayerFetchScheduler::Queue(const SteamID& id, StartFunc start, CancelFunc cancel)
+{
+	m_Queued.push_back({ id, std::move(start), std::move(cancel) });
+}
+
+void PlayerFetchScheduler::Update()
+{
+	std::erase_if(m_InFlight, [](const mh::task<>& task) { return task.is_ready(); });
+
+	if (m_Queued.empty() || m_InFlight.size() >= m_MaxInFlight)
+		return;
+
+	// Drop anyone that left while they were waiting
+	std::vector<CancelFunc> cancelled;
+	std::erase_if(m_Queued, [&](QueuedFetch& fetch)
+		{
+			const auto priority = m_GetPriority(fetch.m_ID);
+			if (priority)
+			{
+				fetch.m_Priority = *priority;
+				return false;
+			}
+
+			if (fetch.m_Cancel)
+				cancelled.push_back(std::move(fetch.m_Cancel));
+
+			return true;
+		});
+
+	// Stable, so it is still oldest first within the same priority
+	std::stable_sort(m_Queued.begin(), m_Queued.end(),
+		[](const QueuedFetch& lhs, const QueuedFetch& rhs) { return lhs.m_Priority > rhs.m_Priority; });
+
+	const size_t startCount = std::min(m_MaxInFlight - m_InFlight.size(), m_Queued.size());
+	std::vector<StartFunc> starting;
+	starting.reserve(startCount);
+	for (size_t i = 0; i < startCount; i++)
+		starting.push_back(std::move(m_Queued[i].m_Start));
+
+	m_Queued.erase(m_Queued.begin(), m_Queued.begin() + startCount);
+
+	// Called last, these are allowed to queue more fetches
+	for (const auto& cancel : cancelled)
+		cancel();
+
+	for (const auto& start : starting)
+	{
+		try
+		{
+			m_InFlight.push_back(start());
+		}
+		catch (...)
+		{
+			LogException("Failed to start a player data fetch");
+		}
+	}
+}
+
+time_point_t PlayerFetchScheduler::GetNextUpdateTime() const
+{
+	if (!m_Queued.empty() && m_InFlight.size() < m_MaxInFlight)
+		return tfbd_clock_t::now();
+	if (!m_InFlight.empty())
+		return tfbd_clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL;
+
+	return time_point_t::max();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Clock.h"
+#include "SteamID.h"
+
+#include <mh/coroutine/task.hpp>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	// Higher goes first
+	enum class FetchPriority
+	{
+		Normal,
+		Hovered,
+		Enemy,
+	};
+
+	/// <summary>
+	/// Hands out a fixed number of concurrent request slots for one API to the per-player
+	/// lookups that want them. Priority is asked for when a slot opens up rather than when
+	/// something is queued, so a player that just moved to the enemy team or got hovered
+	/// jumps ahead of everyone else, and players that have already left are dropped
+	/// without ever being requested.
+	/// </summary>
+	class PlayerFetchScheduler final
+	{
+	public:
+		// nullopt if the player is gone and anything queued for them should be cancelled
+		using PriorityFunc = std::function<std::optional<FetchPriority>(const SteamID& id)>;
+
+		// Starts the request. The returned task must not throw.
+		using StartFunc = std::function<mh::task<>()>;
+		// Called instead of StartFunc if the fetch gets cancelled
+		using CancelFunc = std::function<void()>;
+
+		PlayerFetchScheduler(size_t maxInFlight, PriorityFunc getPriority);
+
+		void Queue(const SteamID& id, StartFunc start, CancelFunc cancel = nullptr);
+
+		size_t GetQueuedCount() const { return m_Queued.size(); }
+		size_t GetInFlightCount() const { return m_InFlight.size(); }
+
+		void Update();
+		time_point_t GetNextUpdateTime() const;
+
+	private:
+		size_t m_MaxInFlight;
+		PriorityFunc m_GetPriority;
+
+		struct QueuedFetch
+		{
+			SteamID m_ID;
+			StartFunc m_Start;
+			CancelFunc m_Cancel;
+			FetchPriority m_Priority{};
+		};
+		std::vector<QueuedFetch> m_Queued;  // Oldest first
+		std::vector<mh::task<>> m_InFlight;
+	};
+}
@@ -0,0 +1,124 @@
+#include "PlayerTable.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace tf2_bot_detector;
+
+auto PlayerTable::Add(const SteamID& id, Player* owner) -> index_t
+{
+	assert(std::this_thread::get_id() == m_OwnerThread);
+
+	{
+		std::lock_guard lock(m_RemovedElsewhereMutex);
+		for (index_t removed : m_RemovedElsewhere)
+		{
+			m_Owners[removed] = nullptr;
+			m_FreeSlots.push_back(removed);
+		}
+
+		m_RemovedElsewhere.clear();
+	}
+
+	index_t index;
+	if (!m_FreeSlots.empty())
+	{
+		index = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+
+		m_Owners[index] = owner;
+		m_SteamIDs[index] = id;
+		m_Teams[index] = {};
+		m_States[index] = PlayerStatusState::Invalid;
+		m_Pings[index] = 0;
+		m_ClientIndices[index] = 0;
+		m_Scores[index] = {};
+		m_LastStatusUpdateTimes[index] = {};
+		m_LastPingUpdateTimes[index] = {};
+		m_IsCurrent[index] = true;
+	}
+	else
+	{
+		index = index_t(m_SteamIDs.size());
+
+		m_Owners.push_back(owner);
+		m_SteamIDs.push_back(id);
+		m_Teams.push_back({});
+		m_States.push_back(PlayerStatusState::Invalid);
+		m_Pings.push_back(0);
+		m_ClientIndices.push_back(0);
+		m_Scores.push_back({});
+		m_LastStatusUpdateTimes.push_back({});
+		m_LastPingUpdateTimes.push_back({});
+		m_IsCurrent.push_back(true);
+	}
+
+	m_CurrentCount++;
+	return index;
+}
+
+void PlayerTable::Remove(index_t index)
+{
+	if (std::this_thread::get_id() != m_OwnerThread)
+	{
+		// Scans skip slots that aren't current, so nobody on the main thread is looking at this one
+		std::lock_guard lock(m_RemovedElsewhereMutex);
+		m_RemovedElsewhere.push_back(index);
+		return;
+	}
+
+	assert(index < GetSlotCount());
+
+	if (m_IsCurrent[index])
+	{
+		m_IsCurrent[index] = false;
+		m_CurrentCount--;
+	}
+
+	m_Owners[index] = nullptr;
+	m_FreeSlots.push_back(index);
+}
+
+void PlayerTable::Detach(index_t index)
+{
+	assert(index < GetSlotCount());
+
+	if (m_IsCurrent[index])
+	{
+		m_IsCurrent[index] = false;
+		m_CurrentCount--;
+	}
+}
+
+void PlayerTable::DetachAll()
+{
+	std::fill(m_IsCurrent.begin(), m_IsCurrent.end(), uint8_t(false));
+	m_CurrentCount = 0;
+}
+
+void PlayerTable::ResetScores()
+{
+	std::fill(m_Scores.begin(), m_Scores.end(), PlayerScores{});
+}
+
+void PlayerTable::ResetClientIndices()
+{
+	std::fill(m_ClientIndices.begin(), m_ClientIndices.end(), uint8_t(0));
+}
+
+auto PlayerTable::GetRecentPlayers(size_t recentPlayerCount) const -> std::vector<index_t>
+{
+	std::vector<index_t> retVal;
+	retVal.reserve(m_CurrentCount);
+	ForEachCurrent([&](index_t i) { retVal.push_back(i); });
+
+	const auto middle = retVal.begin() + std::min(recentPlayerCount, retVal.size());
+	std::partial_sort(retVal.begin(), middle, retVal.end(),
+		[&](index_t a, index_t b)
+		{
+			return m_LastStatusUpdateTimes[b] < m_LastStatusUpdateTimes[a];
+		});
+
+	retVal.erase(middle, retVal.end());
+	return retVal;
+}
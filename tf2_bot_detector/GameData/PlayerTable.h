@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Clock.h"
+#include "GameData/IPlayer.h"
+#include "GameData/TFConstants.h"
+#include "PlayerStatus.h"
+#include "SteamID.h"
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	class Player;
+
+	/// <summary>
+	/// The fields of every Player that get looked at by whole-server scans (team, state, ping,
+	/// scores, update times), stored one array per field so a scan over 100 players touches a
+	/// few cache lines instead of 100 separate heap allocations. Player objects just hold an
+	/// index into here.
+	///
+	/// Indices are stable for as long as the owning Player is alive, and only get reused after
+	/// it is destroyed. Players that have been dropped from the world (but are still referenced
+	/// elsewhere) keep their slot, but are no longer "current" and get skipped by scans.
+	///
+	/// Main thread only, except for Remove(). The last reference to a dropped Player can go away
+	/// on any thread (a pending API request, for example), so slots freed elsewhere are handed
+	/// back to the main thread on its next Add(). Adding can reallocate every column, so don't
+	/// hold on to references into them.
+	/// </summary>
+	class PlayerTable final
+	{
+	public:
+		using index_t = uint32_t;
+
+		index_t Add(const SteamID& id, Player* owner);
+		// Thread safe, as long as the slot isn't current anymore
+		void Remove(index_t index);
+
+		// No longer current, but the slot stays valid until the owner is destroyed
+		void Detach(index_t index);
+
+		// Everyone in the table stops being current (new lobby/server)
+		void DetachAll();
+
+		size_t GetSlotCount() const { return m_SteamIDs.size(); }
+		size_t GetCurrentCount() const { return m_CurrentCount; }
+		bool IsCurrent(index_t index) const { return m_IsCurrent[index]; }
+
+		void ResetScores();
+		void ResetClientIndices();
+
+		// The most recently updated current players, newest first
+		std::vector<index_t> GetRecentPlayers(size_t recentPlayerCount) const;
+
+		template<typename TFunc>
+		void ForEachCurrent(TFunc&& func) const
+		{
+			const size_t count = GetSlotCount();
+			for (index_t i = 0; i < count; i++)
+			{
+				if (m_IsCurrent[i])
+					func(i);
+			}
+		}
+
+		std::vector<Player*> m_Owners;
+		std::vector<SteamID> m_SteamIDs;
+		std::vector<TFTeam> m_Teams;
+		std::vector<PlayerStatusState> m_States;
+		std::vector<uint16_t> m_Pings;
+		std::vector<uint8_t> m_ClientIndices;
+		std::vector<PlayerScores> m_Scores;
+		std::vector<time_point_t> m_LastStatusUpdateTimes;
+		std::vector<time_point_t> m_LastPingUpdateTimes;
+
+	private:
+		std::vector<uint8_t> m_IsCurrent;
+		std::vector<index_t> m_FreeSlots;
+		size_t m_CurrentCount = 0;
+
+		const std::thread::id m_OwnerThread = std::this_thread::get_id();
+		std::mutex m_RemovedElsewhereMutex;
+		std::vector<index_t> m_RemovedElsewhere;
+	};
+}
@@ -22,6 +22,8 @@ namespace
 				return "Unknown error.";
 			case ErrorCode::LogicError:
 				return "They were right all along! I *am* a bad programmer (logic error).";
+			case ErrorCode::PlayerDeparted:
+				return "The player left before this was loaded.";
 			}
 
 			return mh::format("Unknown error condition {}", condition);
@@ -12,6 +12,7 @@ namespace tf2_bot_detector
 		LazyValueUninitialized,
 		UnknownError, // I SWORE I WOULD NEVER TYPE THESE WORDS
 		LogicError,
+		PlayerDeparted, // A lazily-loaded value that was cancelled because the player left
 	};
 
 	std::error_condition make_error_condition(tf2_bot_detector::ErrorCode e);
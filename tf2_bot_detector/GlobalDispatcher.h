@@ -1,8 +1,19 @@
 #pragma once
 
 #include <mh/concurrency/dispatcher.hpp>
+#include <mh/coroutine/task.hpp>
 
 namespace tf2_bot_detector
 {
 	mh::dispatcher& GetDispatcher();
+
+	/// <summary>
+	/// co_await this from another thread to continue on the main thread, instead of
+	/// GetDispatcher().co_dispatch(). The dispatcher only runs during an update, so this also
+	/// keeps the main loop polling until the continuation has actually run there.
+	/// </summary>
+	mh::task<> SwitchToMainThread();
+
+	// Main thread only. Are any SwitchToMainThread() continuations still waiting to run?
+	bool HasPendingMainThreadDispatches();
 }
@@ -1,6 +1,7 @@
 #include "Log.h"
 #include "Util/PathUtils.h"
 #include "Filesystem.h"
+#include "UpdateScheduler.h"
 
 #include <imgui.h>
 #include <mh/compiler.hpp>
@@ -353,21 +354,30 @@ void detail::log_h::LogImplBase(const LogMessageColor& color, LogSeverity severi
 void LogManager::Log(std::string msg, const LogMessageColor& color,
 	LogSeverity severity, LogVisibility visibility, time_point_t timestamp)
 {
-	std::lock_guard lock(m_LogMutex);
-	ReplaceSecrets(msg);
-
-	LogToStream(msg, GetLogStream(), timestamp, true);
+	const bool isVisible = !(visibility == LogVisibility::Debug && !mh::is_debug);
 
-	if (!(visibility == LogVisibility::Debug && !mh::is_debug))
 	{
-		m_LogMessages.push_back({ timestamp, std::move(msg), { color.r, color.g, color.b, color.a } });
+		std::lock_guard lock(m_LogMutex);
+		ReplaceSecrets(msg);
+
+		LogToStream(msg, GetLogStream(), timestamp, true);
 
-		if (m_IsInit && m_LogMessages.size() > MAX_LOG_MESSAGES)
+		if (isVisible)
 		{
-			m_LogMessages.erase(m_LogMessages.begin(),
-				std::next(m_LogMessages.begin(), m_LogMessages.size() - MAX_LOG_MESSAGES));
+			m_LogMessages.push_back({ timestamp, std::move(msg), { color.r, color.g, color.b, color.a } });
+
+			if (m_IsInit && m_LogMessages.size() > MAX_LOG_MESSAGES)
+			{
+				m_LogMessages.erase(m_LogMessages.begin(),
+					std::next(m_LogMessages.begin(), m_LogMessages.size() - MAX_LOG_MESSAGES));
+			}
 		}
 	}
+
+	// Make sure the new message shows up even if we're sleeping. This can be called from any
+	// thread (including while drawing), so batch them up rather than redrawing for every line.
+	if (isVisible)
+		UpdateScheduler::Get().RequestRedrawWithin(250ms);
 }
 
 mh::generator<const LogMessage&> LogManager::GetVisibleMsgs() const
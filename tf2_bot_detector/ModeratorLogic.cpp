@@ -7,6 +7,7 @@
 #include "Config/Settings.h"
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/IConsoleLine.h"
+#include "FriendsGraph.h"
 #include "GameData/UserMessageType.h"
 #include "GameData/IPlayer.h"
 #include "Log.h"
@@ -21,8 +22,10 @@
 #include <mh/text/fmtstr.hpp>
 #include <mh/text/string_insertion.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <map>
+#include <optional>
 #include <regex>
 #include <unordered_set>
 #include <fstream>
@@ -79,6 +82,8 @@ namespace
 		size_t GetRuleCount() const override { return m_Rules.GetRuleCount(); }
 
 		MarkedFriends GetMarkedFriendsCount(IPlayer& id) const override;
+		const std::vector<FriendsCluster>& GetFriendsClusters() const override { return m_FriendsClusters; }
+		const FriendsCluster* FindFriendsCluster(const SteamID& id) const override;
 
 		void ReloadConfigFiles() override;
 
@@ -91,9 +96,6 @@ namespace
 
 		struct PlayerExtraData
 		{
-			bool m_FriendsProcessed = false;
-			MarkedFriends m_MarkedFriends;
-
 			// If this is a known cheater, warn them ahead of time that the player is connecting, but only once
 			// (we don't know the cheater's name yet, so don't spam if they can't do anything about it yet)
 			bool m_PreWarnedOtherTeam = false;
@@ -170,6 +172,18 @@ namespace
 
 		PlayerListJSON m_PlayerList;
 		ModerationRules m_Rules;
+
+		// Friends lists of current and recent players, and who's marked. Only ever touched from
+		// Update(), GetMarkedFriendsCount just reads whatever is there.
+		FriendsGraph m_FriendsGraph;
+		std::optional<uint64_t> m_FriendsGraphLoadRevision;   // Everyone's marks are recounted when this changes
+		std::unordered_set<SteamID> m_FriendsGraphDirtyMarks; // Players SetPlayerAttribute changed since the last update
+		std::vector<FriendsCluster> m_FriendsClusters;
+		time_point_t m_LastFriendsGraphUpdate{};
+
+		void UpdateFriendsGraph();
+		void RefreshFriendsGraphMarks();
+		PlayerAttributesList GetCombinedAttributes(const SteamID& id) const;
 	};
 
 	template<typename CharT, typename Traits>
@@ -262,6 +276,7 @@ std::unique_ptr<IModeratorLogic> IModeratorLogic::Create(IWorldState& world,
 void ModeratorLogic::Update()
 {
 	ProcessPlayerActions();
+	UpdateFriendsGraph();
 }
 
 void ModeratorLogic::OnRuleMatch(const ModerationRule& rule, const IPlayer& player, std::string reason)
@@ -1073,7 +1088,6 @@ bool ModeratorLogic::SetPlayerAttribute(const IPlayer& player, PlayerAttribute a
 bool ModeratorLogic::SetPlayerAttribute(const SteamID& player, std::string name, PlayerAttribute attribute, AttributePersistence persistence, bool set, std::string proof)
 {
 	bool attributeChanged = false;
-
 	m_PlayerList.ModifyPlayer(player, [&](PlayerListData& data)
 		{
 			PlayerAttributesList& attribs = [&]() -> PlayerAttributesList&
@@ -1107,6 +1121,9 @@ bool ModeratorLogic::SetPlayerAttribute(const SteamID& player, std::string name,
 			return ModifyPlayerAction::Modified;
 		});
 
+	if (attributeChanged)
+		m_FriendsGraphDirtyMarks.insert(player);
+
 	return attributeChanged;
 }
 
@@ -1189,54 +1206,124 @@ void ModeratorLogic::SetUserRunningTool(const SteamID& id, bool isRunningTool)
 // this code isnt ready though LMAO
 MarkedFriends ModeratorLogic::GetMarkedFriendsCount(IPlayer& player) const
 {
-	auto& data = player.GetOrCreateData<PlayerExtraData>();
-	if (data.m_FriendsProcessed) {
-		return data.m_MarkedFriends;
+	MarkedFriends retVal;
+
+	// steamapi didn't get friends data yet, or UpdateFriendsGraph hasn't picked it up yet
+	const FriendsMarkCounts* countsPtr = m_FriendsGraph.GetMarkCounts(player.GetSteamID());
+	if (!countsPtr)
+		return retVal;
+
+	const FriendsMarkCounts& counts = *countsPtr;
+	for (size_t i = 0; i < counts.m_Attributes.size(); i++)
+		retVal.m_MarkedFriendsCount.emplace(PlayerAttribute(i), counts.m_Attributes[i]);
+
+	retVal.m_MarkedFriendsCountTotal = counts.m_Marked;
+	retVal.m_FriendsCountTotal = counts.m_Friends;
+	return retVal;
+}
+
+const FriendsCluster* ModeratorLogic::FindFriendsCluster(const SteamID& id) const
+{
+	for (const FriendsCluster& cluster : m_FriendsClusters)
+	{
+		if (std::find(cluster.m_Members.begin(), cluster.m_Members.end(), id) != cluster.m_Members.end())
+			return &cluster;
 	}
 
-	auto friendsInfo = player.GetFriendsInfo();
+	return nullptr;
+}
+
+void ModeratorLogic::UpdateFriendsGraph()
+{
+	// Cheap unless something changed, and marks should show up right away
+	RefreshFriendsGraphMarks();
+
+	const auto now = tfbd_clock_t::now();
+	if ((now - m_LastFriendsGraphUpdate) < 1s)
+		return;
+
+	m_LastFriendsGraphUpdate = now;
+
+	std::unordered_set<SteamID> knownPlayers;
+	std::vector<SteamID> connectedPlayers;
+	for (const IPlayer& player : std::as_const(*m_World).GetPlayers())
+	{
+		const SteamID steamID = player.GetSteamID();
+		knownPlayers.insert(steamID);
+
+		// Only index what has already been fetched for the scoreboard (or prefetched), this
+		// runs for everyone every second and shouldn't be what decides to fetch friends lists
+		if (!m_FriendsGraph.HasFriends(steamID))
+		{
+			if (const auto friendsInfo = player.TryGetFriendsInfo())
+				m_FriendsGraph.SetFriends(steamID, friendsInfo->m_Friends);
+		}
 
-	// steamapi didn't get friends data yet; exit the function and this function will run again next loop.
-	if (!friendsInfo.has_value()) {
-		Log(player.GetSteamID().str() + " waiting until we receive friends list data for this player.");
-		return data.m_MarkedFriends;
+		if (player.GetTimeSinceLastStatusUpdate() <= 20s)
+			connectedPlayers.push_back(steamID);
 	}
 
-	uint32_t totalCount = 0;
-	uint32_t cheaterCount = 0;
-	uint32_t suspiciousCount = 0;
-	uint32_t exploiterCount = 0;
-	uint32_t racistCount = 0;
+	// Once the world forgets about someone, so do we
+	std::vector<SteamID> forgottenPlayers;
+	m_FriendsGraph.ForEachPlayer([&](const SteamID& steamID)
+		{
+			if (!knownPlayers.contains(steamID))
+				forgottenPlayers.push_back(steamID);
+		});
 
-	for (const SteamID& id : friendsInfo.value().m_Friends) {
-		auto playerAttributes = GetPlayerAttributes(id);
+	for (const SteamID& steamID : forgottenPlayers)
+		m_FriendsGraph.RemoveFriends(steamID);
 
-		if (!playerAttributes.empty())
+	m_FriendsClusters.clear();
+	for (auto& members : m_FriendsGraph.FindClusters(connectedPlayers))
+	{
+		FriendsCluster& cluster = m_FriendsClusters.emplace_back();
+		for (const SteamID& member : members)
 		{
-			// TODO: dont do this ig
-			if (playerAttributes.Has(PlayerAttribute::Cheater))
-				cheaterCount++;
-			if (playerAttributes.Has(PlayerAttribute::Suspicious))
-				suspiciousCount++;
-			if (playerAttributes.Has(PlayerAttribute::Exploiter))
-				exploiterCount++;
-			if (playerAttributes.Has(PlayerAttribute::Racist))
-				racistCount++;
-
-			totalCount++;
+			if (m_FriendsGraph.GetPlayerMarks(member))
+				cluster.m_MarkedMembers++;
 		}
+
+		cluster.m_Members = std::move(members);
 	}
+}
 
-	data.m_MarkedFriends.m_FriendsCountTotal = static_cast<uint32_t>(friendsInfo.value().m_Friends.size());
+void ModeratorLogic::RefreshFriendsGraphMarks()
+{
+	const auto revision = m_PlayerList.GetLoadRevision();
+	if (m_FriendsGraphLoadRevision == revision)
+	{
+		for (const SteamID& steamID : m_FriendsGraphDirtyMarks)
+			m_FriendsGraph.SetPlayerMarks(steamID, GetCombinedAttributes(steamID));
 
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Cheater, cheaterCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Suspicious, suspiciousCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Exploiter, exploiterCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Racist, racistCount));
-	data.m_MarkedFriends.m_MarkedFriendsCountTotal = totalCount;
-	data.m_FriendsProcessed = true;
+		m_FriendsGraphDirtyMarks.clear();
+		return;
+	}
+
+	// Lists were (re)loaded, so anyone could have changed
+	m_FriendsGraphDirtyMarks.clear();
+
+	std::unordered_map<SteamID, PlayerAttributesList> combined;
+	for (const auto& [fileName, data] : m_PlayerList.GetAllPlayerData())
+		combined[data.GetSteamID()] |= data.GetAttributes();
+
+	// GetPlayerAttributes never reports the local player as marked, so neither do we
+	combined.erase(m_Settings->GetLocalSteamID());
+
+	m_FriendsGraph.SetAllMarks({ combined.begin(), combined.end() });
+	m_FriendsGraphLoadRevision = revision;
+}
+
+PlayerAttributesList ModeratorLogic::GetCombinedAttributes(const SteamID& id) const
+{
+	PlayerAttributesList retVal;
+	if (id == m_Settings->GetLocalSteamID())
+		return retVal;
 
-	return data.m_MarkedFriends;
+	for (const auto& [fileName, attributes] : m_PlayerList.FindPlayerAttributes(id))
+		retVal |= attributes;
+
+	return retVal;
 }
 
 void ModeratorLogic::ReloadConfigFiles()
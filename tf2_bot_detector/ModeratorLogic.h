@@ -1,11 +1,14 @@
 #pragma once
 
+#include "SteamID.h"
+
 #include <mh/reflection/enum.hpp>
 
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace tf2_bot_detector
 {
@@ -19,7 +22,6 @@ namespace tf2_bot_detector
 	struct PlayerMarks;
 	class RCONActionManager;
 	class Settings;
-	class SteamID;
 	class IWorldState;
 	class PlayerListJSON;
 
@@ -39,6 +41,12 @@ namespace tf2_bot_detector
 		uint32_t m_FriendsCountTotal = 0;
 	};
 
+	struct FriendsCluster
+	{
+		std::vector<SteamID> m_Members;
+		uint32_t m_MarkedMembers = 0;
+	};
+
 	class IModeratorLogic
 	{
 	public:
@@ -69,6 +77,12 @@ namespace tf2_bot_detector
 
 		virtual MarkedFriends GetMarkedFriendsCount(IPlayer& id) const = 0;
 
+		// Groups of players on the server that are friends with each other (directly, or through
+		// someone else in the group), biggest first. An unmarked player hanging out with a group
+		// of marked ones is a pretty good hint they're part of the same bot network.
+		virtual const std::vector<FriendsCluster>& GetFriendsClusters() const = 0;
+		virtual const FriendsCluster* FindFriendsCluster(const SteamID& id) const = 0;
+
 		virtual void ReloadConfigFiles() = 0;
 
 		virtual PlayerListJSON* GetPlayerList() = 0;
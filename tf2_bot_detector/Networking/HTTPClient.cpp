@@ -9,6 +9,7 @@
 #include "GlobalDispatcher.h"
 #include "HTTPClient.h"
 #include "HTTPHelpers.h"
+#include "UpdateScheduler.h"
 
 #pragma warning(push, 1)
 #include <cpprest/http_client.h>
@@ -184,6 +185,9 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 				const auto duration = tfbd_clock_t::now() - startTime;
 				DebugLog("[{}ms] HTTP GET #{}: {}", std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(), requestIndex, url);
 
+				// Whoever is waiting on this is probably polling from the main thread. Continuations
+				// that move over to it themselves go through SwitchToMainThread() instead.
+				UpdateScheduler::Get().Wake();
 				co_return std::move(stringResponse);
 			}
 			catch (...)
@@ -241,11 +245,13 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 catch (const http_error&)
 {
 	DebugLogException("{}", url);
+	UpdateScheduler::Get().Wake();
 	throw;
 }
 catch (...)
 {
 	LogException("{}", url);
+	UpdateScheduler::Get().Wake();
 	throw;
 }
 
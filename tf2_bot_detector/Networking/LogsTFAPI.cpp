@@ -1,19 +1,305 @@
 #include "LogsTFAPI.h"
 #include "HTTPClient.h"
 #include "HTTPHelpers.h"
+#include "DB/TempDB.h"
+#include "GenericErrors.h"
+#include "Log.h"
+#include "UpdateScheduler.h"
 
-#include <nlohmann/json.hpp>
+#include <cctype>
+#include <charconv>
+#include <stdexcept>
 
+using namespace std::string_view_literals;
 using namespace tf2_bot_detector;
 
 mh::task<LogsTFAPI::PlayerLogsInfo> LogsTFAPI::GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id)
 {
 	const std::string string = co_await client->GetStringAsync(mh::format("https://logs.tf/api/v1/log?player={}&limit=0", id.ID64));
 
-	const nlohmann::json json = nlohmann::json::parse(string);
+	const auto total = ParseLogsTotal(string);
+	if (!total)
+		throw std::runtime_error(mh::format("Couldn't find \"total\" in the logs.tf response for {}", id));
 
 	PlayerLogsInfo info{};
 	info.m_ID = id;
-	json.at("total").get_to(info.m_LogsCount);
+	info.m_LogsCount = *total;
 	co_return info;
 }
+
+std::optional<uint32_t> LogsTFAPI::ParseLogsTotal(const std::string_view& response)
+{
+	// {"success": true, "results": 0, "total": 1234, "parameters": {...}, "logs": []}
+	// None of the other keys or values can contain "total" in quotes, so no need to track nesting.
+	constexpr auto KEY = "\"total\""sv;
+
+	const auto IsSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+
+	for (size_t keyPos = response.find(KEY); keyPos != response.npos; keyPos = response.find(KEY, keyPos + 1))
+	{
+		size_t pos = keyPos + KEY.size();
+		while (pos < response.size() && IsSpace(response[pos]))
+			pos++;
+
+		// "total" was a value, not a key
+		if (pos >= response.size() || response[pos] != ':')
+			continue;
+
+		pos++;
+		while (pos < response.size() && IsSpace(response[pos]))
+			pos++;
+
+		uint32_t total{};
+		const auto begin = response.data() + pos;
+		const auto end = response.data() + response.size();
+		if (auto [ptr, ec] = std::from_chars(begin, end, total); ec == std::errc{} && ptr != begin)
+			return total;
+
+		return std::nullopt;
+	}
+
+	return std::nullopt;
+}
+
+LogsTFAPI::PlayerLogsQueue::PlayerLogsQueue(ResultFunc onResult) :
+	m_OnResult(std::move(onResult))
+{
+}
+
+void LogsTFAPI::PlayerLogsQueue::Queue(const SteamID& id, RequestPriority priority)
+{
+	for (const auto& request : m_InFlight)
+	{
+		if (request.m_ID == id)
+			return;
+	}
+
+	if (auto found = m_Queued.find(id); found != m_Queued.end())
+		found->second.m_Priority = std::max(found->second.m_Priority, priority);
+	else
+		m_Queued.emplace(id, QueuedRequest{ priority, m_NextOrder++ });
+}
+
+bool LogsTFAPI::PlayerLogsQueue::IsQueued(const SteamID& id) const
+{
+	if (m_Queued.contains(id))
+		return true;
+
+	for (const auto& request : m_InFlight)
+	{
+		if (request.m_ID == id)
+			return true;
+	}
+
+	return false;
+}
+
+void LogsTFAPI::PlayerLogsQueue::Update(const std::shared_ptr<const IHTTPClient>& client, DB::ITempDB* cache)
+{
+	std::erase_if(m_PendingStores, [](mh::task<>& task) { return task.is_ready(); });
+
+	CompleteCacheLookups();
+	CompleteRequests(cache);
+
+	if (!client)
+	{
+		// Internet got turned off while these were waiting. They'll be queued again if someone still wants them.
+		auto queued = std::move(m_Queued);
+		m_Queued.clear();
+
+		for (const auto& [id, request] : queued)
+			m_OnResult(id, ErrorCode::InternetConnectivityDisabled);
+
+		return;
+	}
+
+	if (cache)
+		StartCacheLookups(*cache);
+
+	StartRequests(client, !!cache);
+}
+
+time_point_t LogsTFAPI::PlayerLogsQueue::GetNextUpdateTime() const
+{
+	if (m_InFlight.size() < MAX_IN_FLIGHT)
+	{
+		for (const auto& [id, request] : m_Queued)
+		{
+			if (!request.m_CacheLookupStarted || request.m_CacheMissed)
+				return tfbd_clock_t::now();
+		}
+	}
+
+	if (!m_InFlight.empty() || !m_CacheLookups.empty() || !m_PendingStores.empty())
+		return tfbd_clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL;
+
+	return time_point_t::max();
+}
+
+namespace
+{
+	mh::task<std::optional<LogsTFAPI::PlayerLogsInfo>> TryGetCachedAsync(const DB::ITempDB& cache, SteamID id)
+	{
+		co_await DB::ITempDB::GetIOPool().co_add_task();
+
+		DB::LogsTFCacheInfo cacheInfo{};
+		cacheInfo.m_ID = id;
+		if (cache.TryGet(cacheInfo) &&
+			(tfbd_clock_t::now() - cacheInfo.m_LastCacheUpdateTime) <= cacheInfo.GetCacheLiveTime())
+		{
+			co_return std::optional<LogsTFAPI::PlayerLogsInfo>(static_cast<const LogsTFAPI::PlayerLogsInfo&>(cacheInfo));
+		}
+
+		co_return std::nullopt;
+	}
+
+	mh::task<> StoreCachedAsync(DB::ITempDB& cache, LogsTFAPI::PlayerLogsInfo info)
+	{
+		co_await DB::ITempDB::GetIOPool().co_add_task();
+
+		try
+		{
+			DB::LogsTFCacheInfo cacheInfo{};
+			cacheInfo = info;
+			cacheInfo.m_LastCacheUpdateTime = tfbd_clock_t::now();
+			cache.Store(cacheInfo);
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to cache logs.tf info for {}", info.m_ID);
+		}
+	}
+}
+
+void LogsTFAPI::PlayerLogsQueue::CompleteCacheLookups()
+{
+	for (auto it = m_CacheLookups.begin(); it != m_CacheLookups.end(); )
+	{
+		if (!it->m_Task.is_ready())
+		{
+			++it;
+			continue;
+		}
+
+		std::optional<PlayerLogsInfo> cached;
+		try
+		{
+			cached = it->m_Task.get();
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to check the logs.tf cache for {}", it->m_ID);
+		}
+
+		const SteamID id = it->m_ID;
+		it = m_CacheLookups.erase(it);
+
+		// Might have been dropped in the meantime (internet turned off)
+		auto queued = m_Queued.find(id);
+		if (queued == m_Queued.end())
+			continue;
+
+		if (cached)
+		{
+			m_Queued.erase(queued);
+			m_OnResult(id, *cached);
+		}
+		else
+		{
+			queued->second.m_CacheMissed = true;
+		}
+	}
+}
+
+void LogsTFAPI::PlayerLogsQueue::CompleteRequests(DB::ITempDB* cache)
+{
+	for (auto it = m_InFlight.begin(); it != m_InFlight.end(); )
+	{
+		if (!it->m_Task.is_ready())
+		{
+			++it;
+			continue;
+		}
+
+		mh::expected<PlayerLogsInfo> result;
+		try
+		{
+			result = it->m_Task.get();
+		}
+		catch (const std::system_error& e)
+		{
+			DebugLogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to get logs.tf info for {}", it->m_ID);
+			result = e.code().default_error_condition();
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to get logs.tf info for {}", it->m_ID);
+			result = ErrorCode::UnknownError;
+		}
+
+		if (cache && result)
+		{
+			try
+			{
+				m_PendingStores.push_back(StoreCachedAsync(*cache, result.value()));
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to cache logs.tf info for {}", it->m_ID);
+			}
+		}
+
+		const SteamID id = it->m_ID;
+		it = m_InFlight.erase(it);
+		m_OnResult(id, result);
+	}
+}
+
+void LogsTFAPI::PlayerLogsQueue::StartCacheLookups(DB::ITempDB& cache)
+{
+	// Cache lookups don't take up a request slot, everyone gets theirs started right away
+	for (auto& [id, request] : m_Queued)
+	{
+		if (request.m_CacheLookupStarted)
+			continue;
+
+		request.m_CacheLookupStarted = true;
+		m_CacheLookups.push_back({ id, TryGetCachedAsync(cache, id) });
+	}
+}
+
+void LogsTFAPI::PlayerLogsQueue::StartRequests(const std::shared_ptr<const IHTTPClient>& client, bool cacheMissesOnly)
+{
+	while (m_InFlight.size() < MAX_IN_FLIGHT)
+	{
+		const auto id = PopNext(cacheMissesOnly);
+		if (!id)
+			break;
+
+		m_InFlight.push_back({ *id, GetPlayerLogsInfoAsync(client, *id) });
+	}
+}
+
+std::optional<SteamID> LogsTFAPI::PlayerLogsQueue::PopNext(bool cacheMissesOnly)
+{
+	auto best = m_Queued.end();
+	for (auto it = m_Queued.begin(); it != m_Queued.end(); ++it)
+	{
+		if (cacheMissesOnly && !it->second.m_CacheMissed)
+			continue;
+
+		if (best == m_Queued.end() ||
+			it->second.m_Priority > best->second.m_Priority ||
+			(it->second.m_Priority == best->second.m_Priority && it->second.m_Order < best->second.m_Order))
+		{
+			best = it;
+		}
+	}
+
+	if (best == m_Queued.end())
+		return std::nullopt;
+
+	const SteamID id = best->first;
+	m_Queued.erase(best);
+	return id;
+}
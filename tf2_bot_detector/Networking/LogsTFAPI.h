@@ -1,14 +1,26 @@
 #pragma once
 
+#include "Clock.h"
 #include "SteamID.h"
 
 #include <mh/coroutine/task.hpp>
+#include <mh/error/expected.hpp>
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace tf2_bot_detector
 {
 	class IHTTPClient;
+
+	namespace DB
+	{
+		class ITempDB;
+	}
 }
 
 namespace tf2_bot_detector::LogsTFAPI
@@ -20,4 +32,75 @@ namespace tf2_bot_detector::LogsTFAPI
 	};
 
 	mh::task<PlayerLogsInfo> GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id);
+
+	// Pulls "total" out of a /api/v1/log response without building a json DOM for the rest of it.
+	std::optional<uint32_t> ParseLogsTotal(const std::string_view& response);
+
+	enum class RequestPriority
+	{
+		Background,  // Prefetching for players nobody is looking at yet
+		Visible,     // Someone is looking at this player right now
+	};
+
+	/// <summary>
+	/// Every logs.tf lookup goes through here. logs.tf only takes one player per request,
+	/// so instead of batching them into a single request like the Steam API ones, this
+	/// only asks once per player, serves whatever it can from the TempDB cache without a
+	/// request at all, and keeps only a few requests in flight at once, visible players first.
+	/// Cache reads and writes happen on ITempDB::GetIOPool(), never in Update().
+	/// </summary>
+	class PlayerLogsQueue final
+	{
+	public:
+		// Called from Update(), on the main thread.
+		using ResultFunc = std::function<void(const SteamID& id, const mh::expected<PlayerLogsInfo>& result)>;
+
+		explicit PlayerLogsQueue(ResultFunc onResult);
+
+		static constexpr size_t MAX_IN_FLIGHT = 2;
+
+		// Queueing someone that is already queued only ever raises their priority.
+		void Queue(const SteamID& id, RequestPriority priority);
+		bool IsQueued(const SteamID& id) const;
+
+		// cache can be null. If it isn't, it has to outlive this queue.
+		void Update(const std::shared_ptr<const IHTTPClient>& client, DB::ITempDB* cache);
+		time_point_t GetNextUpdateTime() const;
+
+	private:
+		ResultFunc m_OnResult;
+
+		struct QueuedRequest
+		{
+			RequestPriority m_Priority;
+			uint64_t m_Order;  // Oldest first within the same priority
+
+			bool m_CacheLookupStarted = false;
+			bool m_CacheMissed = false;  // Only these get requested (when there is a cache)
+		};
+		std::unordered_map<SteamID, QueuedRequest> m_Queued;
+		uint64_t m_NextOrder = 0;
+
+		struct CacheLookup
+		{
+			SteamID m_ID;
+			mh::task<std::optional<PlayerLogsInfo>> m_Task;
+		};
+		std::vector<CacheLookup> m_CacheLookups;
+
+		struct InFlightRequest
+		{
+			SteamID m_ID;
+			mh::task<PlayerLogsInfo> m_Task;
+		};
+		std::vector<InFlightRequest> m_InFlight;
+
+		std::vector<mh::task<>> m_PendingStores;
+
+		void CompleteCacheLookups();
+		void CompleteRequests(DB::ITempDB* cache);
+		void StartCacheLookups(DB::ITempDB& cache);
+		void StartRequests(const std::shared_ptr<const IHTTPClient>& client, bool cacheMissesOnly);
+		std::optional<SteamID> PopNext(bool cacheMissesOnly);
+	};
 }
@@ -1,7 +1,7 @@
 #include "SteamAPI.h"
 #include "Config/Settings.h"
+#include "DB/BlobStore.h"
 #include "Util/JSONUtils.h"
-#include "Util/PathUtils.h"
 #include "HTTPClient.h"
 #include "HTTPHelpers.h"
 #include "Log.h"
@@ -17,6 +17,10 @@
 #include <stb_image.h>
 
 #include <fstream>
+#include <list>
+#include <mutex>
+#include <span>
+#include <unordered_map>
 #include <regex>
 
 using namespace std::chrono_literals;
@@ -36,55 +40,148 @@ namespace
 	class AvatarCacheManager final
 	{
 	public:
-		AvatarCacheManager()
+		AvatarCacheManager() :
+			m_CacheDir(IFilesystem::Get().GetTempDir() / "Steam Avatar Cache"),
+			m_Store(m_CacheDir / "avatars.blob", MAX_STORED_AVATAR_BYTES, 24h * 7)
 		{
-			m_CacheDir = IFilesystem::Get().GetTempDir() / "Steam Avatar Cache";
-			std::filesystem::create_directories(m_CacheDir);
-			DeleteOldFiles(m_CacheDir, 24h * 7);
+			DeleteLegacyFiles();
 		}
 
-		mh::task<Bitmap> GetAvatarBitmap(const HTTPClient* client,
-			const std::string url, const std::string hash) const
+		// Takes everything by value, this is a coroutine and the caller's copies are gone after the first co_await
+		mh::task<std::shared_ptr<const Bitmap>> GetAvatarBitmap(std::shared_ptr<const HTTPClient> client,
+			const std::string url, const std::string hash)
 		{
-			const std::filesystem::path cachedPath = m_CacheDir / mh::fmtstr<128>("{}.jpg", hash).view();
+			// Lots of players share the same (default) avatar, and the same players
+			// show up over and over, so keep recently decoded ones around.
+			if (auto decoded = FindDecoded(hash))
+				co_return decoded;
+
+			// Don't hit the disk or decode on whatever thread called us (usually the main thread)
+			co_await m_DecodePool.co_add_task();
+
+			std::shared_ptr<const Bitmap> bitmap;
 
 			// See if we're already stored in the cache
+			BlobStore::Blob blob;
+			try
+			{
+				blob = m_Store.Find(hash);
+			}
+			catch (const std::exception& e)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to read cached avatar {}, re-fetching...", hash);
+			}
+
+			if (blob)
 			{
-				std::lock_guard lock(m_CacheMutex);
 				try
 				{
-					if (std::filesystem::exists(cachedPath))
-						co_return Bitmap(cachedPath);
+					bitmap = std::make_shared<const Bitmap>(blob.m_Data);
 				}
 				catch (const std::exception& e)
 				{
-					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to load cached avatar from {}, re-fetching...", cachedPath);
+					// Don't keep tripping over it every time this avatar shows up
+					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to decode cached avatar {}, re-fetching...", hash);
+					blob = {};
+					m_Store.Remove(hash);
 				}
 			}
 
-			if (client)
+			if (!bitmap && client)
 			{
-				auto clientPtr = client->shared_from_this();
-
 				// We're not stored in the cache, download now
-				std::string data = co_await clientPtr->GetStringAsync(url);
+				const std::string data = co_await client->GetStringAsync(url);
+
+				// Get off the HTTP thread before touching the store or decoding
+				co_await m_DecodePool.co_add_task();
+
+				// Only cache what we know we can decode
+				const auto encoded = std::as_bytes(std::span(data));
+				bitmap = std::make_shared<const Bitmap>(encoded);
 
-				std::lock_guard lock(m_CacheMutex);
+				try
 				{
-					std::ofstream file(cachedPath, std::ios::trunc | std::ios::binary);
-					file << data;
+					m_Store.Store(hash, encoded);
+				}
+				catch (const std::exception& e)
+				{
+					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to store avatar {} in the cache", hash);
 				}
-				co_return Bitmap(cachedPath);
 			}
 
 			// No HTTPClient and we're not in the cache, so just give up
-			co_return Bitmap{};
+			if (!bitmap)
+				co_return std::make_shared<const Bitmap>();
+
+			StoreDecoded(hash, bitmap);
+			co_return bitmap;
 		}
 
 	private:
+		static constexpr uint64_t MAX_STORED_AVATAR_BYTES = 64 * 1024 * 1024;
+
 		std::filesystem::path m_CacheDir;
-		mutable std::mutex m_CacheMutex;
+		BlobStore m_Store;
+		mh::thread_pool m_DecodePool{ 2 };
+
+		// Avatars used to be stored as one jpg per hash, they live in m_Store now. There can be
+		// thousands of them, so only walk the directory once and leave a marker behind.
+		void DeleteLegacyFiles() try
+		{
+			const auto markerPath = m_CacheDir / "legacy_files_deleted";
+			if (std::filesystem::exists(markerPath))
+				return;
+
+			std::error_code ec;
+			for (const auto& entry : std::filesystem::directory_iterator(m_CacheDir, ec))
+			{
+				if (entry.path().extension() == ".jpg" || entry.path().extension() == ".tmp")
+					std::filesystem::remove(entry.path(), ec);
+			}
+
+			if (!ec)
+				std::ofstream(markerPath, std::ios::trunc);
+		}
+		catch (const std::exception& e)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to clean up old avatar files in {}", m_CacheDir);
+		}
+
+		// Most recently used at the front
+		static constexpr size_t MAX_DECODED_AVATARS = 64;
+		using DecodedList = std::list<std::pair<std::string, std::shared_ptr<const Bitmap>>>;
+		DecodedList m_Decoded;
+		std::unordered_map<std::string_view, DecodedList::iterator> m_DecodedLookup;
+		std::mutex m_DecodedMutex;
+
+		std::shared_ptr<const Bitmap> FindDecoded(const std::string& hash)
+		{
+			std::lock_guard lock(m_DecodedMutex);
+
+			auto found = m_DecodedLookup.find(hash);
+			if (found == m_DecodedLookup.end())
+				return nullptr;
+
+			m_Decoded.splice(m_Decoded.begin(), m_Decoded, found->second);
+			return found->second->second;
+		}
+
+		void StoreDecoded(const std::string& hash, std::shared_ptr<const Bitmap> bitmap)
+		{
+			std::lock_guard lock(m_DecodedMutex);
+
+			if (m_DecodedLookup.contains(hash))
+				return; // someone else beat us to it
+
+			m_Decoded.emplace_front(hash, std::move(bitmap));
+			m_DecodedLookup.emplace(m_Decoded.front().first, m_Decoded.begin());
 
+			while (m_Decoded.size() > MAX_DECODED_AVATARS)
+			{
+				m_DecodedLookup.erase(m_Decoded.back().first);
+				m_Decoded.pop_back();
+			}
+		}
 	};
 
 	static AvatarCacheManager& GetAvatarCacheManager()
@@ -127,9 +224,9 @@ std::string PlayerSummary::GetAvatarURL(AvatarQuality quality) const
 		m_AvatarHash, qualityStr);
 }
 
-mh::task<Bitmap> PlayerSummary::GetAvatarBitmap(std::shared_ptr<const HTTPClient> client, AvatarQuality quality) const
+mh::task<std::shared_ptr<const Bitmap>> PlayerSummary::GetAvatarBitmap(std::shared_ptr<const HTTPClient> client, AvatarQuality quality) const
 {
-	return GetAvatarCacheManager().GetAvatarBitmap(client.get(), GetAvatarURL(quality), m_AvatarHash);
+	return GetAvatarCacheManager().GetAvatarBitmap(std::move(client), GetAvatarURL(quality), m_AvatarHash);
 }
 
 std::string_view PlayerSummary::GetVanityURL() const
@@ -196,14 +293,7 @@ std::string tf2_bot_detector::SteamAPI::GenerateSteamIDsQueryParam(const std::ve
 		LogError(location, "Attempted to fetch {} steamIDs at once (max {}). Clamping to {}.", steamIDs.size(), max, max);
 
 	std::string steamIDsString = "?steamids=";
-	for (size_t i = 0; i < std::min<size_t>(steamIDs.size(), max); i++)
-	{
-		if (i != 0)
-			steamIDsString << ',';
-
-		steamIDsString << steamIDs[i].ID64;
-	}
-
+	AppendSteamID64s(steamIDsString, std::span(steamIDs.data(), std::min<size_t>(steamIDs.size(), max)));
 	return steamIDsString;
 }
 
@@ -219,24 +309,7 @@ mh::task<std::vector<PlayerSummary>> tf2_bot_detector::SteamAPI::GetPlayerSummar
 	auto clientPtr = client.shared_from_this();
 	const std::string data = co_await clientPtr->GetStringAsync(url);
 
-	nlohmann::json json;
-	try
-	{
-		json = nlohmann::json::parse(data);
-	}
-	catch (...)
-	{
-		throw SteamAPIError(ErrorCode::JSONParseError);
-	}
-
-	try
-	{
-		co_return json.at("response").at("players").get<std::vector<PlayerSummary>>();
-	}
-	catch (...)
-	{
-		throw SteamAPIError(ErrorCode::JSONDeserializeError);
-	}
+	co_return ParsePlayerSummaries(data);
 }
 
 void tf2_bot_detector::SteamAPI::from_json(const nlohmann::json& j, PlayerBans& d)
@@ -282,24 +355,7 @@ mh::task<std::vector<PlayerBans>> tf2_bot_detector::SteamAPI::GetPlayerBansAsync
 		throw SteamAPIError(ErrorCode::GenericHttpError);
 	}
 
-	nlohmann::json json;
-	try
-	{
-		json = nlohmann::json::parse(response);
-	}
-	catch (const std::exception&)
-	{
-		throw SteamAPIError(ErrorCode::JSONParseError);
-	}
-
-	try
-	{
-		co_return json.at("players").get<std::vector<PlayerBans>>();
-	}
-	catch (...)
-	{
-		throw SteamAPIError(ErrorCode::JSONDeserializeError);
-	}
+	co_return ParsePlayerBans(response);
 }
 
 mh::task<duration_t> tf2_bot_detector::SteamAPI::GetTF2PlaytimeAsync(
@@ -425,19 +481,9 @@ mh::task<std::unordered_set<SteamID>> tf2_bot_detector::SteamAPI::GetFriendList(
 	auto url = GenerateSteamAPIURL(apiSettings, "/ISteamUser/GetFriendList/v0001", mh::format("?steamid={}", steamID.ID64));
 
 	auto clientPtr = client.shared_from_this();
-	std::string data = co_await clientPtr->GetStringAsync(url);
-
-	const auto json = nlohmann::json::parse(data);
-
-	std::unordered_set<SteamID> retVal;
-
-	auto& friendsList = json.at("friendslist");
-	auto& friends = friendsList.at("friends");
-
-	for (const auto& friendEntry : friends)
-		retVal.insert(SteamID(friendEntry.at("steamid").get<std::string_view>()));
+	const std::string data = co_await clientPtr->GetStringAsync(url);
 
-	co_return retVal;
+	co_return ParseFriendList(data);
 }
 
 tf2_bot_detector::SteamAPI::SteamAPIError::SteamAPIError(
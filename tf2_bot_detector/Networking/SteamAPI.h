@@ -8,6 +8,7 @@
 #include <mh/error/error_code_exception.hpp>
 #include <nlohmann/json_fwd.hpp>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_set>
@@ -99,13 +100,17 @@ namespace tf2_bot_detector::SteamAPI
 		std::optional<duration_t> GetAccountAge() const;
 
 		std::string GetAvatarURL(AvatarQuality quality = AvatarQuality::Large) const;
-		mh::task<Bitmap> GetAvatarBitmap(std::shared_ptr<const IHTTPClient> client,
+		mh::task<std::shared_ptr<const Bitmap>> GetAvatarBitmap(std::shared_ptr<const IHTTPClient> client,
 			AvatarQuality quality = AvatarQuality::Large) const;
 
 		std::string_view GetVanityURL() const;
 	};
 	void from_json(const nlohmann::json& j, PlayerSummary& d);
 
+	// Parses a GetPlayerSummaries response straight into PlayerSummaries, without building a
+	// json DOM first. Throws SteamAPIError (JSONParseError/JSONDeserializeError).
+	std::vector<PlayerSummary> ParsePlayerSummaries(const std::string_view& json);
+
 	mh::task<std::vector<PlayerSummary>> GetPlayerSummariesAsync(const ISteamAPISettings& apiSettings,
 		const std::vector<SteamID>& steamIDs, const IHTTPClient& client);
 
@@ -131,6 +136,9 @@ namespace tf2_bot_detector::SteamAPI
 	};
 	void from_json(const nlohmann::json& j, PlayerBans& d);
 
+	// Same as ParsePlayerSummaries, for GetPlayerBans responses.
+	std::vector<PlayerBans> ParsePlayerBans(const std::string_view& json);
+
 	mh::task<std::vector<PlayerBans>> GetPlayerBansAsync(const ISteamAPISettings& apiSettings,
 		const std::vector<SteamID>& steamIDs, const IHTTPClient& client);
 
@@ -148,6 +156,9 @@ namespace tf2_bot_detector::SteamAPI
 		// uint32_t m_MarkedFriendsTotal = 0;
 	};
 
+	// Same as ParsePlayerSummaries, for GetFriendList responses.
+	std::unordered_set<SteamID> ParseFriendList(const std::string_view& json);
+
 	mh::task<std::unordered_set<SteamID>> GetFriendList(const ISteamAPISettings& apiSettings,
 		const SteamID& steamID, const IHTTPClient& client);
 
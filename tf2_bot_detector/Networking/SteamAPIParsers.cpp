@@ -0,0 +1,421 @@
+#include "SteamAPI.h"
+#include "Log.h"
+
+#include <mh/text/string_insertion.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <iomanip>
+#include <variant>
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::SteamAPI;
+
+namespace
+{
+	/// <summary>
+	/// Walks a json document without building a DOM, keeping track of which containers we're
+	/// in so derived classes can pick out just the values they care about and write them
+	/// straight into their structs.
+	/// </summary>
+	class StreamingParser : public nlohmann::json_sax<nlohmann::json>
+	{
+	public:
+		void Parse(const std::string_view& json)
+		{
+			// The sax callbacks are only public through the base class
+			nlohmann::json::sax_parse(json, static_cast<nlohmann::json_sax<nlohmann::json>*>(this));
+		}
+
+	protected:
+		using Value = std::variant<std::nullptr_t, bool, int64_t, uint64_t, double, std::string>;
+
+		// Called after entering/before leaving an object, with m_Path already including it.
+		virtual void OnStartObject() {}
+		virtual void OnEndObject() {}
+		virtual void OnStartArray() {}
+
+		// Strings can be moved out of value
+		virtual void OnValue(const std::string_view& key, Value& value) = 0;
+
+		// Is m_Path exactly this? The root and array elements have empty names.
+		template<typename TRange> bool IsAt(const TRange& path) const
+		{
+			return std::equal(m_Path.begin(), m_Path.end(), std::begin(path), std::end(path));
+		}
+		bool IsAt(const std::initializer_list<std::string_view>& path) const
+		{
+			return IsAt<std::initializer_list<std::string_view>>(path);
+		}
+
+		static uint64_t GetUnsigned(const Value& value)
+		{
+			if (auto uintVal = std::get_if<uint64_t>(&value))
+				return *uintVal;
+			if (auto intVal = std::get_if<int64_t>(&value); intVal && *intVal >= 0)
+				return uint64_t(*intVal);
+
+			throw SteamAPIError(ErrorCode::JSONDeserializeError, "Expected an unsigned integer");
+		}
+
+		static bool GetBool(const Value& value)
+		{
+			if (auto boolVal = std::get_if<bool>(&value))
+				return *boolVal;
+
+			throw SteamAPIError(ErrorCode::JSONDeserializeError, "Expected a bool");
+		}
+
+		static std::string TakeString(Value& value)
+		{
+			if (auto strVal = std::get_if<std::string>(&value))
+				return std::move(*strVal);
+
+			throw SteamAPIError(ErrorCode::JSONDeserializeError, "Expected a string");
+		}
+
+		static SteamID GetSteamID(const Value& value)
+		{
+			const auto strVal = std::get_if<std::string>(&value);
+			if (!strVal)
+				throw SteamAPIError(ErrorCode::JSONDeserializeError, "Expected a SteamID string");
+
+			try
+			{
+				return SteamID(*strVal);
+			}
+			catch (const std::exception& e)
+			{
+				throw SteamAPIError(ErrorCode::JSONDeserializeError, "Invalid SteamID "s << std::quoted(*strVal) << ": " << e.what());
+			}
+		}
+
+	private:
+		std::vector<std::string> m_Path;
+		std::vector<bool> m_IsArray;
+		std::string m_Key;
+
+		bool EmitValue(Value value)
+		{
+			OnValue(IsInArray() ? std::string_view{} : std::string_view(m_Key), value);
+			return true;
+		}
+
+		bool IsInArray() const { return !m_IsArray.empty() && m_IsArray.back(); }
+
+		void Push(bool isArray)
+		{
+			m_Path.push_back(IsInArray() ? std::string{} : std::move(m_Key));
+			m_IsArray.push_back(isArray);
+		}
+		void Pop()
+		{
+			m_Path.pop_back();
+			m_IsArray.pop_back();
+		}
+
+		bool null() override { return EmitValue(nullptr); }
+		bool boolean(bool val) override { return EmitValue(val); }
+		bool number_integer(number_integer_t val) override { return EmitValue(int64_t(val)); }
+		bool number_unsigned(number_unsigned_t val) override { return EmitValue(uint64_t(val)); }
+		bool number_float(number_float_t val, const string_t&) override { return EmitValue(double(val)); }
+		bool string(string_t& val) override { return EmitValue(std::move(val)); }
+		bool binary(binary_t&) override { return EmitValue(nullptr); }
+
+		bool start_object(std::size_t) override
+		{
+			Push(false);
+			OnStartObject();
+			return true;
+		}
+		bool end_object() override
+		{
+			OnEndObject();
+			Pop();
+			return true;
+		}
+		bool start_array(std::size_t) override
+		{
+			Push(true);
+			OnStartArray();
+			return true;
+		}
+		bool end_array() override
+		{
+			Pop();
+			return true;
+		}
+
+		bool key(string_t& val) override
+		{
+			m_Key = std::move(val);
+			return true;
+		}
+
+		bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+		{
+			throw SteamAPIError(ErrorCode::JSONParseError, ex.what());
+		}
+	};
+
+	// {"response":{"players":[{"steamid":"...", ...}, ...]}}
+	class PlayerSummariesParser final : public StreamingParser
+	{
+	public:
+		std::vector<PlayerSummary> m_Results;
+		bool m_FoundPlayers = false;
+
+	private:
+		static constexpr std::array PLAYER_PATH{ ""sv, "response"sv, "players"sv, ""sv };
+
+		enum RequiredField
+		{
+			SteamIDField,
+			NicknameField,
+			StatusField,
+			VisibilityField,
+			AvatarHashField,
+			ProfileURLField,
+
+			RequiredFieldCount,
+		};
+		std::bitset<RequiredFieldCount> m_FoundFields;
+
+		void OnStartArray() override
+		{
+			if (IsAt({ ""sv, "response"sv, "players"sv }))
+				m_FoundPlayers = true;
+		}
+
+		void OnStartObject() override
+		{
+			if (!IsAt(PLAYER_PATH))
+				return;
+
+			m_Results.emplace_back();
+			m_FoundFields.reset();
+		}
+
+		void OnEndObject() override
+		{
+			if (IsAt(PLAYER_PATH) && !m_FoundFields.all())
+				throw SteamAPIError(ErrorCode::JSONDeserializeError, "Player summary is missing required fields");
+		}
+
+		void OnValue(const std::string_view& key, Value& value) override
+		{
+			if (!IsAt(PLAYER_PATH))
+				return;
+
+			PlayerSummary& d = m_Results.back();
+			if (key == "steamid"sv)
+			{
+				d.m_SteamID = GetSteamID(value);
+				m_FoundFields.set(SteamIDField);
+			}
+			else if (key == "realname"sv)
+			{
+				// Sometimes null instead of just missing
+				if (std::holds_alternative<std::nullptr_t>(value))
+					d.m_RealName.clear();
+				else
+					d.m_RealName = TakeString(value);
+			}
+			else if (key == "personaname"sv)
+			{
+				d.m_Nickname = TakeString(value);
+				m_FoundFields.set(NicknameField);
+			}
+			else if (key == "personastate"sv)
+			{
+				d.m_Status = PersonaState(GetUnsigned(value));
+				m_FoundFields.set(StatusField);
+			}
+			else if (key == "communityvisibilitystate"sv)
+			{
+				d.m_Visibility = CommunityVisibilityState(GetUnsigned(value));
+				m_FoundFields.set(VisibilityField);
+			}
+			else if (key == "avatarhash"sv)
+			{
+				d.m_AvatarHash = TakeString(value);
+				m_FoundFields.set(AvatarHashField);
+			}
+			else if (key == "profileurl"sv)
+			{
+				d.m_ProfileURL = TakeString(value);
+				m_FoundFields.set(ProfileURLField);
+			}
+			else if (key == "lastlogoff"sv)
+			{
+				d.m_LastLogOff = std::chrono::system_clock::time_point(std::chrono::seconds(GetUnsigned(value)));
+			}
+			else if (key == "profilestate"sv)
+			{
+				d.m_ProfileConfigured = GetUnsigned(value) != 0;
+			}
+			else if (key == "commentpermission"sv)
+			{
+				d.m_CommentPermissions = GetUnsigned(value) != 0;
+			}
+			else if (key == "timecreated"sv)
+			{
+				d.m_CreationTime = std::chrono::system_clock::time_point(std::chrono::seconds(GetUnsigned(value)));
+			}
+		}
+	};
+
+	// {"players":[{"SteamId":"...", ...}, ...]}
+	class PlayerBansParser final : public StreamingParser
+	{
+	public:
+		std::vector<PlayerBans> m_Results;
+		bool m_FoundPlayers = false;
+
+	private:
+		static constexpr std::array PLAYER_PATH{ ""sv, "players"sv, ""sv };
+
+		enum RequiredField
+		{
+			SteamIDField,
+			CommunityBannedField,
+			VACBanCountField,
+			GameBanCountField,
+			DaysSinceLastBanField,
+			EconomyBanField,
+
+			RequiredFieldCount,
+		};
+		std::bitset<RequiredFieldCount> m_FoundFields;
+
+		void OnStartArray() override
+		{
+			if (IsAt({ ""sv, "players"sv }))
+				m_FoundPlayers = true;
+		}
+
+		void OnStartObject() override
+		{
+			if (!IsAt(PLAYER_PATH))
+				return;
+
+			m_Results.emplace_back();
+			m_FoundFields.reset();
+		}
+
+		void OnEndObject() override
+		{
+			if (IsAt(PLAYER_PATH) && !m_FoundFields.all())
+				throw SteamAPIError(ErrorCode::JSONDeserializeError, "Player bans are missing required fields");
+		}
+
+		void OnValue(const std::string_view& key, Value& value) override
+		{
+			if (!IsAt(PLAYER_PATH))
+				return;
+
+			PlayerBans& d = m_Results.back();
+			if (key == "SteamId"sv)
+			{
+				d.m_SteamID = GetSteamID(value);
+				m_FoundFields.set(SteamIDField);
+			}
+			else if (key == "CommunityBanned"sv)
+			{
+				d.m_CommunityBanned = GetBool(value);
+				m_FoundFields.set(CommunityBannedField);
+			}
+			else if (key == "NumberOfVACBans"sv)
+			{
+				d.m_VACBanCount = unsigned(GetUnsigned(value));
+				m_FoundFields.set(VACBanCountField);
+			}
+			else if (key == "NumberOfGameBans"sv)
+			{
+				d.m_GameBanCount = unsigned(GetUnsigned(value));
+				m_FoundFields.set(GameBanCountField);
+			}
+			else if (key == "DaysSinceLastBan"sv)
+			{
+				d.m_TimeSinceLastBan = 24h * uint32_t(GetUnsigned(value));
+				m_FoundFields.set(DaysSinceLastBanField);
+			}
+			else if (key == "EconomyBan"sv)
+			{
+				const std::string economyBan = TakeString(value);
+				if (economyBan == "none"sv)
+					d.m_EconomyBan = PlayerEconomyBan::None;
+				else if (economyBan == "banned"sv)
+					d.m_EconomyBan = PlayerEconomyBan::Banned;
+				else if (economyBan == "probation"sv)
+					d.m_EconomyBan = PlayerEconomyBan::Probation;
+				else
+				{
+					LogError(MH_SOURCE_LOCATION_CURRENT(), "Unknown EconomyBan value "s << std::quoted(economyBan));
+					d.m_EconomyBan = PlayerEconomyBan::Unknown;
+				}
+
+				m_FoundFields.set(EconomyBanField);
+			}
+		}
+	};
+
+	// {"friendslist":{"friends":[{"steamid":"...","relationship":"friend","friend_since":0}, ...]}}
+	class FriendListParser final : public StreamingParser
+	{
+	public:
+		std::unordered_set<SteamID> m_Results;
+		bool m_FoundFriends = false;
+
+	private:
+		void OnStartArray() override
+		{
+			if (IsAt({ ""sv, "friendslist"sv, "friends"sv }))
+				m_FoundFriends = true;
+		}
+
+		void OnValue(const std::string_view& key, Value& value) override
+		{
+			if (key == "steamid"sv && IsAt({ ""sv, "friendslist"sv, "friends"sv, ""sv }))
+				m_Results.insert(GetSteamID(value));
+		}
+	};
+}
+
+std::vector<PlayerSummary> tf2_bot_detector::SteamAPI::ParsePlayerSummaries(const std::string_view& json)
+{
+	PlayerSummariesParser parser;
+	parser.Parse(json);
+
+	if (!parser.m_FoundPlayers)
+		throw SteamAPIError(ErrorCode::JSONDeserializeError, "Missing response.players");
+
+	return std::move(parser.m_Results);
+}
+
+std::vector<PlayerBans> tf2_bot_detector::SteamAPI::ParsePlayerBans(const std::string_view& json)
+{
+	PlayerBansParser parser;
+	parser.Parse(json);
+
+	if (!parser.m_FoundPlayers)
+		throw SteamAPIError(ErrorCode::JSONDeserializeError, "Missing players");
+
+	return std::move(parser.m_Results);
+}
+
+std::unordered_set<SteamID> tf2_bot_detector::SteamAPI::ParseFriendList(const std::string_view& json)
+{
+	FriendListParser parser;
+	parser.Parse(json);
+
+	if (!parser.m_FoundFriends)
+		throw SteamAPIError(ErrorCode::JSONDeserializeError, "Missing friendslist.friends");
+
+	return std::move(parser.m_Results);
+}
@@ -3,9 +3,12 @@
 
 
 #include "HTTPHelpers.h"
+#include "Log.h"
 
 #include <nlohmann/json.hpp>
 
+#include <stdexcept>
+
 /// <summary>
 /// gets sourcebans from XVF's steamhistory site.
 ///
@@ -15,7 +18,7 @@
 /// <param name="steamIDs"></param>
 /// <param name="client"></param>
 /// <returns></returns>
-mh::task<tf2_bot_detector::SteamHistoryAPI::PlayerSourceBansResponse>
+mh::task<tf2_bot_detector::SteamHistoryAPI::PlayerSourceBansResult>
 	tf2_bot_detector::SteamHistoryAPI::GetPlayerSourceBansAsync(
 		const std::string& apiKey,
 		const std::vector<SteamID>& steamIDs,
@@ -38,17 +41,45 @@ mh::task<tf2_bot_detector::SteamHistoryAPI::PlayerSourceBansResponse>
 	auto clientPtr = client.shared_from_this();
 	const std::string data = co_await clientPtr->GetStringAsync(requestURL);
 
+	co_return ParsePlayerSourceBansResult(data);
+}
+
+auto tf2_bot_detector::SteamHistoryAPI::ParsePlayerSourceBansResult(const std::string_view& data) -> PlayerSourceBansResult
+{
+	PlayerSourceBansResult result;
+
 	nlohmann::json json;
 	try
 	{
 		json = nlohmann::json::parse(data);
 	}
-	catch (...)
+	catch (const std::exception& e)
 	{
-		// TODO
+		throw std::runtime_error(mh::format("Failed to parse the steamhistory.net response: {}", e.what()));
 	}
 
-	co_return json.at("response").get<PlayerSourceBansResponse>();
+	const auto response = json.find("response");
+	if (response == json.end() || !response->is_object())
+		throw std::runtime_error(mh::format("steamhistory.net response is missing its bans: {}", data));
+
+	result.m_IsComplete = true;
+	for (const auto& item : response->items())
+	{
+		try
+		{
+			result.m_Bans.insert_or_assign(SteamID(item.key()), item.value().get<PlayerSourceBans>());
+		}
+		catch (...)
+		{
+			LogException("Failed to parse the steamhistory.net bans for {}", item.key());
+			result.m_IsComplete = false;
+		}
+	}
+
+	if (!result.m_IsComplete && result.m_Bans.empty())
+		throw std::runtime_error("None of the bans in the steamhistory.net response could be parsed");
+
+	return result;
 }
 
 
@@ -108,3 +139,33 @@ void tf2_bot_detector::SteamHistoryAPI::from_json(const nlohmann::json& j, Playe
 		d.insert(std::make_pair(SteamID(iter.key()), bans));
 	}
 }
+
+void tf2_bot_detector::SteamHistoryAPI::to_json(nlohmann::json& j, const BanState& d) {
+	switch (d) {
+	case BanState::Permanent:
+		j = "Permanent";
+		break;
+	case BanState::Current:
+		j = "Temp-Ban";
+		break;
+	case BanState::Unbanned:
+		j = "Unbanned";
+		break;
+	default:
+		j = "Expired";
+		break;
+	}
+}
+
+void tf2_bot_detector::SteamHistoryAPI::to_json(nlohmann::json& j, const PlayerSourceBan& d) {
+	j = {
+		{ "SteamID", d.m_ID },
+		{ "Name", d.m_UserName },
+		{ "CurrentState", d.m_BanState },
+		{ "BanReason", d.m_BanReason },
+		{ "UnbanReason", d.m_UnbanReason },
+		{ "BanTimestamp", std::chrono::duration_cast<std::chrono::seconds>(d.m_BanTimestamp.time_since_epoch()).count() },
+		{ "UnbanTimestamp", std::chrono::duration_cast<std::chrono::seconds>(d.m_UnbanTimestamp.time_since_epoch()).count() },
+		{ "Server", d.m_Server },
+	};
+}
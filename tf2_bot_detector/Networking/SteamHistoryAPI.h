@@ -8,6 +8,7 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace tf2_bot_detector
@@ -55,11 +56,32 @@ namespace tf2_bot_detector::SteamHistoryAPI
 
 	typedef std::unordered_map<std::string, PlayerSourceBan> PlayerSourceBanState;
 
+	struct PlayerSourceBansResult
+	{
+		PlayerSourceBansResponse m_Bans;
+
+		/// <summary>
+		/// steamhistory.net only returns keys for players that have bans. Only when the whole
+		/// response was understood does a missing key really mean "no bans".
+		/// </summary>
+		bool m_IsComplete = false;
+	};
+
 	void from_json(const nlohmann::json& j, BanState& d);
 	void from_json(const nlohmann::json& j, PlayerSourceBan& d);
 	void from_json(const nlohmann::json& j, PlayerSourceBansResponse& d);
 
-	mh::task<PlayerSourceBansResponse> GetPlayerSourceBansAsync(const std::string& apiKey, const std::vector<SteamID>& steamIDs, const HTTPClient& client);
+	// Same shape as the steamhistory.net response, so cached bans go back through from_json
+	void to_json(nlohmann::json& j, const BanState& d);
+	void to_json(nlohmann::json& j, const PlayerSourceBan& d);
+
+	/// <summary>
+	/// Anything that fails to parse is skipped and leaves the result incomplete. Throws if
+	/// nothing could be parsed at all, so the whole batch stays queued and is requested again.
+	/// </summary>
+	PlayerSourceBansResult ParsePlayerSourceBansResult(const std::string_view& data);
+
+	mh::task<PlayerSourceBansResult> GetPlayerSourceBansAsync(const std::string& apiKey, const std::vector<SteamID>& steamIDs, const HTTPClient& client);
 }
 
 // for our logging functions.
@@ -0,0 +1,77 @@
+#include "FileWatcher.h"
+
+#include <optional>
+#include <system_error>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class PollingFileWatcher final : public IFileWatcher
+	{
+	public:
+		PollingFileWatcher(std::filesystem::path path) : m_Path(std::move(path))
+		{
+			m_LastState = GetState();
+		}
+
+		FileChange ConsumeChanges() override
+		{
+			const auto state = GetState();
+			const auto change = Compare(m_LastState, state);
+			m_LastState = state;
+			return change;
+		}
+
+		bool HasPendingChanges() const override
+		{
+			return Compare(m_LastState, GetState()) != FileChange::None;
+		}
+
+		bool IsEventDriven() const override { return false; }
+		const std::filesystem::path& GetPath() const override { return m_Path; }
+
+	private:
+		struct FileState
+		{
+			uintmax_t m_Size{};
+			std::filesystem::file_time_type m_WriteTime{};
+		};
+
+		std::optional<FileState> GetState() const
+		{
+			std::error_code ec;
+			FileState state;
+
+			state.m_Size = std::filesystem::file_size(m_Path, ec);
+			if (ec)
+				return std::nullopt;
+
+			state.m_WriteTime = std::filesystem::last_write_time(m_Path, ec);
+			if (ec)
+				return std::nullopt;
+
+			return state;
+		}
+
+		static FileChange Compare(const std::optional<FileState>& prev, const std::optional<FileState>& cur)
+		{
+			if (prev.has_value() != cur.has_value())
+				return FileChange::Replaced;
+			if (!cur.has_value())
+				return FileChange::None;
+			if (prev->m_Size != cur->m_Size || prev->m_WriteTime != cur->m_WriteTime)
+				return FileChange::Modified;
+
+			return FileChange::None;
+		}
+
+		std::filesystem::path m_Path;
+		std::optional<FileState> m_LastState;
+	};
+}
+
+std::unique_ptr<IFileWatcher> IFileWatcher::CreatePolling(std::filesystem::path path)
+{
+	return std::make_unique<PollingFileWatcher>(std::move(path));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+namespace tf2_bot_detector
+{
+	enum class FileChange
+	{
+		None,
+
+		// The file grew, shrank, or its contents were touched.
+		Modified,
+
+		// The file was deleted, moved away, or (re)created. Any open handles are stale.
+		Replaced,
+	};
+
+	/// <summary>
+	/// Tells us when a single file changes, so we don't have to keep reading it to find out.
+	/// </summary>
+	class IFileWatcher
+	{
+	public:
+		virtual ~IFileWatcher() = default;
+
+		// Uses the best backend available on the current platform, falling back to polling.
+		static std::unique_ptr<IFileWatcher> Create(std::filesystem::path path);
+		static std::unique_ptr<IFileWatcher> CreatePolling(std::filesystem::path path);
+
+		// Returns (and clears) the most significant change since the last call.
+		[[nodiscard]] virtual FileChange ConsumeChanges() = 0;
+
+		// Are there any changes waiting to be consumed? Does not clear them.
+		virtual bool HasPendingChanges() const = 0;
+
+		// If false, we're stat()ing the file every time we're asked.
+		virtual bool IsEventDriven() const = 0;
+
+		virtual const std::filesystem::path& GetPath() const = 0;
+	};
+}
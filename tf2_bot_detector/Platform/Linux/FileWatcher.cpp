@@ -0,0 +1,132 @@
+#include "Platform/FileWatcher.h"
+#include "Log.h"
+
+#include <mh/text/formatters/error_code.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <string_view>
+#include <utility>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class InotifyFileWatcher final : public IFileWatcher
+	{
+	public:
+		InotifyFileWatcher(std::filesystem::path path, int fd, int wd) :
+			m_Path(std::move(path)), m_FileName(m_Path.filename().string()), m_FD(fd), m_WD(wd)
+		{
+		}
+
+		~InotifyFileWatcher()
+		{
+			inotify_rm_watch(m_FD, m_WD);
+			close(m_FD);
+		}
+
+		FileChange ConsumeChanges() override
+		{
+			DrainEvents();
+			return std::exchange(m_Pending, FileChange::None);
+		}
+
+		bool HasPendingChanges() const override
+		{
+			DrainEvents();
+			return m_Pending != FileChange::None;
+		}
+
+		bool IsEventDriven() const override { return true; }
+		const std::filesystem::path& GetPath() const override { return m_Path; }
+
+	private:
+		void DrainEvents() const
+		{
+			alignas(inotify_event) char buf[4096];
+
+			while (true)
+			{
+				const ssize_t length = read(m_FD, buf, sizeof(buf));
+				if (length <= 0)
+				{
+					if (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+					{
+						LogError("Failed to read inotify events for {}: {}", m_Path,
+							std::error_code(errno, std::generic_category()));
+
+						// we don't know what we missed
+						m_Pending = FileChange::Replaced;
+					}
+
+					return;
+				}
+
+				for (const char* ptr = buf; ptr < buf + length; )
+				{
+					const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+					ptr += sizeof(inotify_event) + event->len;
+
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						m_Pending = FileChange::Replaced;
+						continue;
+					}
+
+					if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+					{
+						// the directory itself went away, nothing more will be reported on this watch.
+						m_Pending = FileChange::Replaced;
+						continue;
+					}
+
+					if (event->len == 0 || std::string_view(event->name) != m_FileName)
+						continue;
+
+					if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO))
+						m_Pending = FileChange::Replaced;
+					else
+						m_Pending = std::max(m_Pending, FileChange::Modified);
+				}
+			}
+		}
+
+		std::filesystem::path m_Path;
+		std::string m_FileName;
+		int m_FD = -1;
+		int m_WD = -1;
+		mutable FileChange m_Pending = FileChange::None;
+	};
+}
+
+std::unique_ptr<IFileWatcher> IFileWatcher::Create(std::filesystem::path path)
+{
+	const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0)
+	{
+		LogWarning("inotify_init1() failed, falling back to polling {}: {}", path,
+			std::error_code(errno, std::generic_category()));
+		return CreatePolling(std::move(path));
+	}
+
+	// Watch the directory rather than the file, so we find out about the file being created/rotated.
+	const auto dir = path.parent_path();
+	const int wd = inotify_add_watch(fd, dir.c_str(),
+		IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+		IN_DELETE_SELF | IN_MOVE_SELF);
+
+	if (wd < 0)
+	{
+		LogWarning("Failed to watch {}, falling back to polling {}: {}", dir, path,
+			std::error_code(errno, std::generic_category()));
+		close(fd);
+		return CreatePolling(std::move(path));
+	}
+
+	return std::make_unique<InotifyFileWatcher>(std::move(path), fd, wd);
+}
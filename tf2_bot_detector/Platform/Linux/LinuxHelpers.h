@@ -4,6 +4,11 @@
 #include <string_view>
 #include <unordered_map>
 #include <filesystem>
+#include <vector>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 
 #include <unistd.h>
 #include <dirent.h>
@@ -13,58 +18,69 @@
 
 namespace tf2_bot_detector::Linux
 {
-    // PID cache
-    static std::unordered_map<std::string_view, pid_t> processPids;
-
-    // chatgpt generated code cuz lazy
-    pid_t getPidFromProcessName(const std::string &processName)
+    // Walks /proc once, and returns the pid of the first process whose argv[0] contains
+    // each of processNames (in the same order), or -1 if it wasn't found.
+    inline std::vector<pid_t> ScanProcessNames(const std::vector<std::string_view>& processNames)
     {
+        std::vector<pid_t> pids(processNames.size(), -1);
+        size_t remaining = processNames.size();
+
         DIR *dir = opendir("/proc");
-        if (dir != nullptr)
+        if (dir == nullptr)
+            return pids;
+
+        struct dirent *entry;
+        while (remaining > 0 && (entry = readdir(dir)) != nullptr)
         {
-            struct dirent *entry;
-            while ((entry = readdir(dir)) != nullptr)
+            // Check if the entry is a directory and its name is a number (PID)
+            if (entry->d_type != DT_DIR || !std::isdigit(static_cast<unsigned char>(entry->d_name[0])))
+                continue;
+
+            char cmdlinePath[64];
+            snprintf(cmdlinePath, sizeof(cmdlinePath), "/proc/%s/cmdline", entry->d_name);
+
+            FILE *cmdlineFile = fopen(cmdlinePath, "r");
+            if (cmdlineFile == nullptr)
+                continue;
+
+            char cmdline[1024]{};
+            fgets(cmdline, sizeof(cmdline), cmdlineFile);
+            fclose(cmdlineFile);
+
+            const std::string_view argv0(cmdline);
+            for (size_t i = 0; i < processNames.size(); i++)
             {
-                // Check if the entry is a directory and its name is a number (PID)
-                if (entry->d_type == DT_DIR && std::isdigit(entry->d_name[0]))
+                if (pids[i] == -1 && argv0.find(processNames[i]) != argv0.npos)
                 {
-                    // Open the cmdline file to read the process name
-                    std::filesystem::path cmdlinePath = std::filesystem::current_path().root_directory() / "proc" / entry->d_name / "cmdline";
-                    FILE *cmdlineFile = fopen(cmdlinePath.c_str(), "r");
-                    if (cmdlineFile != nullptr)
-                    {
-                        char cmdline[1024];
-                        fgets(cmdline, sizeof(cmdline), cmdlineFile);
-                        fclose(cmdlineFile);
-
-                        // Compare the process name with the given name
-                        if (strstr(cmdline, processName.c_str()) != nullptr)
-                        {
-                            closedir(dir);
-                            return atoi(entry->d_name); // Convert directory name to PID
-                        }
-                    }
+                    pids[i] = atoi(entry->d_name); // Convert directory name to PID
+                    remaining--;
                 }
             }
-            closedir(dir);
         }
-        return -1; // Return -1 if the process name is not found
+
+        closedir(dir);
+        return pids;
+    }
+
+    inline pid_t getPidFromProcessName(const std::string &processName)
+    {
+        return ScanProcessNames({ processName }).front();
     }
 
     // if you dont have ~/.steam/steam.pid, this will fail
     // but i dont really understand why you won't have .steam/steam.pid
     // TODO if /.steam/steam.pid fails, grab it from getPidFromProcessName()
-    pid_t GetSteamPID()
+    inline pid_t GetSteamPID()
     {
         std::filesystem::path steam_pid_path = std::filesystem::path(getenv("HOME")) / ".steam" / "steam.pid";
         std::ifstream steam_pid_file(steam_pid_path);
 
-        pid_t ret;
+        pid_t ret = -1;
         steam_pid_file >> ret;
         return ret;
     }
 
-    bool IsProcessRunningPid(pid_t pid)
+    inline bool IsProcessRunningPid(pid_t pid)
     {
         if (pid == -1)
         {
@@ -0,0 +1,71 @@
+#include "Platform/MappedFile.h"
+
+#include <mh/text/string_insertion.hpp>
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std::string_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class LinuxMappedFile final : public IMappedFile
+	{
+	public:
+		LinuxMappedFile(const std::filesystem::path& path)
+		{
+			const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+				throw std::system_error(errno, std::generic_category(), "Failed to open "s << path);
+
+			struct stat st{};
+			if (fstat(fd, &st) != 0)
+			{
+				const int err = errno;
+				close(fd);
+				throw std::system_error(err, std::generic_category(), "Failed to stat "s << path);
+			}
+
+			m_Size = size_t(st.st_size);
+			if (m_Size > 0)
+			{
+				m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (m_Data == MAP_FAILED)
+				{
+					const int err = errno;
+					close(fd);
+					throw std::system_error(err, std::generic_category(), "Failed to mmap "s << path);
+				}
+			}
+
+			// The mapping keeps its own reference to the file
+			close(fd);
+		}
+
+		~LinuxMappedFile()
+		{
+			if (m_Data)
+				munmap(m_Data, m_Size);
+		}
+
+		std::span<const std::byte> GetData() const override
+		{
+			return { static_cast<const std::byte*>(m_Data), m_Size };
+		}
+
+	private:
+		void* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+}
+
+std::shared_ptr<const IMappedFile> IMappedFile::Open(const std::filesystem::path& path)
+{
+	return std::make_shared<LinuxMappedFile>(path);
+}
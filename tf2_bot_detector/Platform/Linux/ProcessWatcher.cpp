@@ -0,0 +1,260 @@
+#include "ProcessWatcher.h"
+#include "LinuxHelpers.h"
+#include "Log.h"
+#include "UpdateScheduler.h"
+
+#include <mh/text/formatters/error_code.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::Linux;
+
+// TODO: 64bit binaries
+static const std::vector<std::string_view> TF2_PROCESS_NAMES = { "hl2_linux", "tf_linux64" };
+
+static int OpenPIDFD(pid_t pid)
+{
+	// requires linux 5.3+, we fall back to polling kill(pid, 0) if this fails.
+	return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+}
+
+ProcessWatcher& ProcessWatcher::Get()
+{
+	static ProcessWatcher s_Watcher;
+	return s_Watcher;
+}
+
+ProcessWatcher::ProcessWatcher() :
+	m_WakeFD(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+	// do the first scan synchronously, so IsTF2Running()/IsSteamRunning() are correct the first time they're called
+	ScanForTF2();
+	ScanForSteam();
+
+	// the first scan isn't a "start" event
+	m_Events.clear();
+
+	m_Thread = std::thread(&ProcessWatcher::ThreadFunc, this);
+}
+
+ProcessWatcher::~ProcessWatcher()
+{
+	m_Quit = true;
+
+	if (m_WakeFD != -1)
+	{
+		const uint64_t value = 1;
+		[[maybe_unused]] auto written = write(m_WakeFD, &value, sizeof(value));
+	}
+
+	if (m_Thread.joinable())
+		m_Thread.join();
+
+	for (WatchedPID* watched : { &m_TF2, &m_Steam })
+	{
+		if (watched->m_PIDFD != -1)
+			close(watched->m_PIDFD);
+	}
+
+	if (m_WakeFD != -1)
+		close(m_WakeFD);
+}
+
+auto ProcessWatcher::GetWatched(Processes::WatchedProcess process) -> WatchedPID&
+{
+	return const_cast<WatchedPID&>(std::as_const(*this).GetWatched(process));
+}
+
+auto ProcessWatcher::GetWatched(Processes::WatchedProcess process) const -> const WatchedPID&
+{
+	switch (process)
+	{
+	case Processes::WatchedProcess::TF2:
+		return m_TF2;
+	default:
+		LogError("Unknown WatchedProcess {}", mh::enum_fmt(process));
+		[[fallthrough]];
+	case Processes::WatchedProcess::Steam:
+		return m_Steam;
+	}
+}
+
+pid_t ProcessWatcher::GetPID(Processes::WatchedProcess process) const
+{
+	return GetWatched(process).m_PID;
+}
+
+bool ProcessWatcher::IsProcessRunning(const std::string_view& processName) const
+{
+	if (std::find(TF2_PROCESS_NAMES.begin(), TF2_PROCESS_NAMES.end(), processName) != TF2_PROCESS_NAMES.end())
+		return IsRunning(Processes::WatchedProcess::TF2);
+	if (processName == "steam")
+		return IsRunning(Processes::WatchedProcess::Steam);
+
+	return ScanProcessNames({ processName }).front() != -1;
+}
+
+std::vector<Processes::ProcessEvent> ProcessWatcher::PollEvents()
+{
+	std::lock_guard lock(m_EventsMutex);
+	return std::exchange(m_Events, {});
+}
+
+bool ProcessWatcher::HasPendingEvents() const
+{
+	std::lock_guard lock(m_EventsMutex);
+	return !m_Events.empty();
+}
+
+void ProcessWatcher::ScanForTF2()
+{
+	for (pid_t pid : ScanProcessNames(TF2_PROCESS_NAMES))
+	{
+		if (pid != -1)
+		{
+			SetRunning(Processes::WatchedProcess::TF2, pid);
+			return;
+		}
+	}
+}
+
+void ProcessWatcher::ScanForSteam()
+{
+	// reading steam.pid is way cheaper than walking /proc.
+	if (const pid_t pid = GetSteamPID(); IsProcessRunningPid(pid))
+		SetRunning(Processes::WatchedProcess::Steam, pid);
+}
+
+void ProcessWatcher::SetRunning(Processes::WatchedProcess process, pid_t pid)
+{
+	WatchedPID& watched = GetWatched(process);
+	watched.m_PIDFD = OpenPIDFD(pid);
+	watched.m_PID = pid;
+
+	DebugLog("[ProcessWatcher] {} started (pid {})", mh::enum_fmt(process), pid);
+
+	{
+		std::lock_guard lock(m_EventsMutex);
+		m_Events.push_back({ process, true });
+	}
+
+	UpdateScheduler::Get().Wake();
+}
+
+void ProcessWatcher::SetExited(Processes::WatchedProcess process)
+{
+	WatchedPID& watched = GetWatched(process);
+	if (watched.m_PIDFD != -1)
+	{
+		close(watched.m_PIDFD);
+		watched.m_PIDFD = -1;
+	}
+
+	DebugLog("[ProcessWatcher] {} exited (pid {})", mh::enum_fmt(process), watched.m_PID.load());
+	watched.m_PID = -1;
+
+	{
+		std::lock_guard lock(m_EventsMutex);
+		m_Events.push_back({ process, false });
+	}
+
+	UpdateScheduler::Get().Wake();
+}
+
+void ProcessWatcher::ThreadFunc()
+{
+	const std::pair<Processes::WatchedProcess, WatchedPID*> watchedProcesses[] =
+	{
+		{ Processes::WatchedProcess::TF2, &m_TF2 },
+		{ Processes::WatchedProcess::Steam, &m_Steam },
+	};
+
+	while (!m_Quit)
+	{
+		if (m_TF2.m_PID == -1)
+			ScanForTF2();
+		if (m_Steam.m_PID == -1)
+			ScanForSteam();
+
+		pollfd fds[1 + std::size(watchedProcesses)]{};
+		nfds_t fdCount = 0;
+		bool needsRescan = false;
+
+		if (m_WakeFD != -1)
+			fds[fdCount++] = { m_WakeFD, POLLIN, 0 };
+
+		for (const auto& [process, watched] : watchedProcesses)
+		{
+			if (watched->m_PIDFD != -1)
+				fds[fdCount++] = { watched->m_PIDFD, POLLIN, 0 };
+			else
+				needsRescan = true; // not running, or no pidfd support
+		}
+
+		const int timeout = needsRescan ? int(std::chrono::milliseconds(RESCAN_INTERVAL).count()) : -1;
+		if (poll(fds, fdCount, timeout) < 0 && errno != EINTR)
+		{
+			LogError("[ProcessWatcher] poll() failed: {}", std::error_code(errno, std::generic_category()));
+			std::this_thread::sleep_for(RESCAN_INTERVAL);
+		}
+
+		if (m_Quit)
+			break;
+
+		for (const auto& [process, watched] : watchedProcesses)
+		{
+			if (watched->m_PID == -1)
+				continue;
+
+			bool exited = false;
+			if (watched->m_PIDFD != -1)
+			{
+				// a pidfd becomes readable when the process exits
+				for (nfds_t i = 0; i < fdCount; i++)
+				{
+					if (fds[i].fd == watched->m_PIDFD && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+						exited = true;
+				}
+			}
+			else
+			{
+				exited = !IsProcessRunningPid(watched->m_PID);
+			}
+
+			if (exited)
+				SetExited(process);
+		}
+	}
+}
+
+bool tf2_bot_detector::Processes::IsTF2Running()
+{
+	return ProcessWatcher::Get().IsRunning(WatchedProcess::TF2);
+}
+
+bool tf2_bot_detector::Processes::IsSteamRunning()
+{
+	return ProcessWatcher::Get().IsRunning(WatchedProcess::Steam);
+}
+
+auto tf2_bot_detector::Processes::PollProcessEvents() -> std::vector<ProcessEvent>
+{
+	return ProcessWatcher::Get().PollEvents();
+}
+
+bool tf2_bot_detector::Processes::HasPendingProcessEvents()
+{
+	return ProcessWatcher::Get().HasPendingEvents();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Platform/Platform.h"
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace tf2_bot_detector::Linux
+{
+	/// <summary>
+	/// Watches for TF2 and Steam starting/exiting on a background thread.
+	///
+	/// /proc is only walked (once, for every TF2 binary name at the same time) while TF2 is not running.
+	/// Once a process has been found, we wait for it to exit through a pidfd instead of re-scanning.
+	/// </summary>
+	class ProcessWatcher final
+	{
+	public:
+		static ProcessWatcher& Get();
+
+		~ProcessWatcher();
+
+		bool IsRunning(Processes::WatchedProcess process) const { return GetPID(process) != -1; }
+
+		// Answered from the watched state for TF2/Steam, anything else still has to walk /proc
+		bool IsProcessRunning(const std::string_view& processName) const;
+		pid_t GetPID(Processes::WatchedProcess process) const;
+
+		std::vector<Processes::ProcessEvent> PollEvents();
+		bool HasPendingEvents() const;
+
+	private:
+		ProcessWatcher();
+
+		static constexpr auto RESCAN_INTERVAL = std::chrono::seconds(2);
+
+		struct WatchedPID
+		{
+			std::atomic<pid_t> m_PID = -1;
+			int m_PIDFD = -1;
+		};
+		WatchedPID m_TF2;
+		WatchedPID m_Steam;
+
+		WatchedPID& GetWatched(Processes::WatchedProcess process);
+		const WatchedPID& GetWatched(Processes::WatchedProcess process) const;
+
+		void ThreadFunc();
+		void ScanForTF2();
+		void ScanForSteam();
+		void SetRunning(Processes::WatchedProcess process, pid_t pid);
+		void SetExited(Processes::WatchedProcess process);
+
+		mutable std::mutex m_EventsMutex;
+		std::vector<Processes::ProcessEvent> m_Events;
+
+		int m_WakeFD = -1;
+		std::atomic_bool m_Quit = false;
+		std::thread m_Thread;
+	};
+}
@@ -26,41 +26,11 @@
 #include <signal.h>
 
 #include "LinuxHelpers.h"
-
-// TODO: 64bit binaries
-bool tf2_bot_detector::Processes::IsTF2Running()
-{
-	static mh::cached_variable hl2_exe(std::chrono::seconds(2), []() { return IsProcessRunning("hl2_linux"); });
-	static mh::cached_variable tf64_exe(std::chrono::seconds(2), []() { return IsProcessRunning("tf_linux64"); });   
-	return tf64_exe.get() || hl2_exe.get();
-}
-
-bool tf2_bot_detector::Processes::IsSteamRunning()
-{
-	static mh::cached_variable steam_pid(std::chrono::seconds(2), []() { return Linux::GetSteamPID(); });
-    static mh::cached_variable steam_running(std::chrono::seconds(1), []() { return Linux::IsProcessRunningPid(steam_pid.get()); });
-	return steam_running.get();
-}
+#include "ProcessWatcher.h"
 
 bool tf2_bot_detector::Processes::IsProcessRunning(const std::string_view& processName)
 {
-    pid_t pid; 
-    
-    if (Linux::processPids.contains(processName)) {
-        pid = Linux::processPids.at(processName);
-    }
-    else {
-        pid = Linux::getPidFromProcessName(std::string(processName));
-        Linux::processPids.insert(std::pair<std::string_view, pid_t>(processName, pid));
-    }
-
-    bool value = Linux::IsProcessRunningPid(pid);
-
-    if (!value) {
-        Linux::processPids.erase(processName);
-    }
-
-    return value;
+    return Linux::ProcessWatcher::Get().IsProcessRunning(processName);
 }
 
 void tf2_bot_detector::Processes::Launch(const std::filesystem::path& executable,
@@ -101,17 +71,9 @@ size_t tf2_bot_detector::Processes::GetCurrentRAMUsage()
 
 mh::task<std::vector<std::string>> tf2_bot_detector::Processes::GetTF2CommandLineArgsAsync()
 {
-    pid_t tf2_pid = 0;
-
-    if (Linux::processPids.contains("hl2_linux")) {
-        tf2_pid = Linux::processPids.at("hl2_linux");
-    }
-    
-    if (!tf2_pid && Linux::processPids.contains("tf_linux64")) {
-        tf2_pid = Linux::processPids.at("tf_linux64");
-    }
+    const pid_t tf2_pid = Linux::ProcessWatcher::Get().GetPID(WatchedProcess::TF2);
 
-    if (!tf2_pid) {
+    if (tf2_pid == -1) {
         return mh::make_ready_task<std::vector<std::string>>();
     }
 
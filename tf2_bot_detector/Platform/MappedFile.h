@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// A read-only memory mapping of an entire file, as big as the file was when it was opened.
+	/// Anything appended to the file afterwards needs a new mapping to be seen.
+	/// </summary>
+	class IMappedFile
+	{
+	public:
+		virtual ~IMappedFile() = default;
+
+		// Throws std::system_error on failure. Empty files are fine, they just have no data.
+		static std::shared_ptr<const IMappedFile> Open(const std::filesystem::path& path);
+
+		virtual std::span<const std::byte> GetData() const = 0;
+	};
+}
@@ -11,6 +11,7 @@
 #include <future>
 #include <string>
 #include <variant>
+#include <vector>
 
 #ifdef _WIN32
 #define PLATFORM_EXECUTABLE(n) n ".exe"
@@ -86,6 +87,22 @@ namespace tf2_bot_detector
 			bool IsSteamRunning();
 			bool IsProcessRunning(const std::string_view& processName);
 
+			enum class WatchedProcess
+			{
+				TF2,
+				Steam,
+			};
+
+			struct ProcessEvent
+			{
+				WatchedProcess m_Process;
+				bool m_Running;
+			};
+
+			// Returns TF2/Steam start and exit events observed since the last call. Main thread only.
+			std::vector<ProcessEvent> PollProcessEvents();
+			bool HasPendingProcessEvents();
+
 			void Launch(const std::filesystem::path& executable, const std::vector<std::string>& args = {},
 				bool elevated = false);
 			void Launch(const std::filesystem::path& executable, const std::string_view& args = {},
@@ -118,6 +135,11 @@ MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::Platform::OS)
 	MH_ENUM_REFLECT_VALUE(Linux)
 MH_ENUM_REFLECT_END()
 
+MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::Platform::Processes::WatchedProcess)
+	MH_ENUM_REFLECT_VALUE(TF2)
+	MH_ENUM_REFLECT_VALUE(Steam)
+MH_ENUM_REFLECT_END()
+
 MH_ENUM_REFLECT_BEGIN(tf2_bot_detector::Platform::Arch)
 	MH_ENUM_REFLECT_VALUE(x86)
 	MH_ENUM_REFLECT_VALUE(x64)
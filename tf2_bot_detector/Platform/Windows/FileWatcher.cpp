@@ -0,0 +1,12 @@
+#include "Platform/FileWatcher.h"
+
+using namespace tf2_bot_detector;
+
+// ReadDirectoryChangesW isn't used on purpose. NTFS only updates the directory entry of a file
+// that is held open and appended to (which is exactly what TF2 does with -condebug) lazily,
+// so FILE_NOTIFY_CHANGE_SIZE/LAST_WRITE can go quiet for as long as the game is running.
+// Polling the size is cheap and doesn't miss anything.
+std::unique_ptr<IFileWatcher> IFileWatcher::Create(std::filesystem::path path)
+{
+	return CreatePolling(std::move(path));
+}
@@ -0,0 +1,81 @@
+#include "Platform/MappedFile.h"
+#include "WindowsHelpers.h"
+
+#include <mh/text/string_insertion.hpp>
+
+#include <system_error>
+
+using namespace std::string_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class WindowsMappedFile final : public IMappedFile
+	{
+	public:
+		WindowsMappedFile(const std::filesystem::path& path)
+		{
+			// Share everything, whoever owns the file keeps appending to it while we're mapped
+			const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ,
+				FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (file == INVALID_HANDLE_VALUE)
+				throw std::system_error(Windows::GetLastErrorCode(), "Failed to open "s << path);
+
+			LARGE_INTEGER size{};
+			if (!GetFileSizeEx(file, &size))
+			{
+				const auto err = Windows::GetLastErrorCode();
+				CloseHandle(file);
+				throw std::system_error(err, "Failed to get the size of "s << path);
+			}
+
+			m_Size = size_t(size.QuadPart);
+			if (m_Size > 0)
+			{
+				const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (!mapping)
+				{
+					const auto err = Windows::GetLastErrorCode();
+					CloseHandle(file);
+					throw std::system_error(err, "Failed to create file mapping for "s << path);
+				}
+
+				m_Data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, m_Size);
+				const auto err = Windows::GetLastErrorCode();
+
+				// The view keeps the mapping (and the file) alive on its own
+				CloseHandle(mapping);
+				CloseHandle(file);
+
+				if (!m_Data)
+					throw std::system_error(err, "Failed to map a view of "s << path);
+			}
+			else
+			{
+				CloseHandle(file);
+			}
+		}
+
+		~WindowsMappedFile()
+		{
+			if (m_Data)
+				UnmapViewOfFile(m_Data);
+		}
+
+		std::span<const std::byte> GetData() const override
+		{
+			return { static_cast<const std::byte*>(m_Data), m_Size };
+		}
+
+	private:
+		void* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+}
+
+std::shared_ptr<const IMappedFile> IMappedFile::Open(const std::filesystem::path& path)
+{
+	return std::make_shared<WindowsMappedFile>(path);
+}
@@ -240,6 +240,54 @@ bool tf2_bot_detector::Processes::IsSteamRunning()
 	return m_CachedValue.get();
 }
 
+namespace
+{
+	// Windows doesn't have a process watcher (yet), so just edge-detect the cached checks above.
+	struct ProcessEventPoller
+	{
+		bool m_TF2Running = tf2_bot_detector::Processes::IsTF2Running();
+		bool m_SteamRunning = tf2_bot_detector::Processes::IsSteamRunning();
+
+		std::vector<tf2_bot_detector::Processes::ProcessEvent> m_Events;
+
+		void Update()
+		{
+			using namespace tf2_bot_detector::Processes;
+
+			if (const bool running = IsTF2Running(); running != m_TF2Running)
+			{
+				m_TF2Running = running;
+				m_Events.push_back({ WatchedProcess::TF2, running });
+			}
+			if (const bool running = IsSteamRunning(); running != m_SteamRunning)
+			{
+				m_SteamRunning = running;
+				m_Events.push_back({ WatchedProcess::Steam, running });
+			}
+		}
+
+		static ProcessEventPoller& Get()
+		{
+			static ProcessEventPoller s_Poller;
+			return s_Poller;
+		}
+	};
+}
+
+auto tf2_bot_detector::Processes::PollProcessEvents() -> std::vector<ProcessEvent>
+{
+	auto& poller = ProcessEventPoller::Get();
+	poller.Update();
+	return std::exchange(poller.m_Events, {});
+}
+
+bool tf2_bot_detector::Processes::HasPendingProcessEvents()
+{
+	auto& poller = ProcessEventPoller::Get();
+	poller.Update();
+	return !poller.m_Events.empty();
+}
+
 // optimization, instead of going through CreateToolhelp32Snapshot over and over again, just open a handle and check exit code.
 static std::unordered_map<std::string, HANDLE> processHandles;
 
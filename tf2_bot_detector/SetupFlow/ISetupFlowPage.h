@@ -8,6 +8,14 @@ namespace tf2_bot_detector
 	class IUpdateManager;
 	class Settings;
 
+	inline namespace Platform
+	{
+		namespace Processes
+		{
+			struct ProcessEvent;
+		}
+	}
+
 	enum class SetupFlowPage
 	{
 		Invalid = -1,
@@ -75,6 +83,10 @@ namespace tf2_bot_detector
 			IUpdateManager* m_UpdateManager = nullptr;
 		};
 		virtual void Commit(const CommitState& cs) = 0;
+
+		// TF2 or Steam started/exited.
+		virtual void OnProcessEvent(const Processes::ProcessEvent& event) {}
+
 		virtual bool WantsSetupText() const { return true; }
 		virtual bool WantsContinueButton() const { return true; }
 
@@ -151,6 +151,14 @@ bool SetupFlow::OnDraw(Settings& settings, const ISetupFlowPage::DrawState& ds)
 	return drewPage || (m_ActivePage != INVALID_PAGE);
 }
 
+void SetupFlow::OnProcessEvent(const Processes::ProcessEvent& event)
+{
+	DebugLog("[SetupFlow] {} {}", mh::enum_fmt(event.m_Process), event.m_Running ? "started" : "exited");
+
+	for (const auto& page : m_Pages)
+		page->OnProcessEvent(event);
+}
+
 SetupFlowPage SetupFlow::GetCurrentPage() const
 {
 	if (m_ActivePage == INVALID_PAGE)
@@ -17,6 +17,7 @@ namespace tf2_bot_detector
 		// Returns true if the setup flow needs to draw.
 		[[nodiscard]] bool OnUpdate(const Settings& settings);
 		[[nodiscard]] bool OnDraw(Settings& settings, const ISetupFlowPage::DrawState& ds);
+		void OnProcessEvent(const Processes::ProcessEvent& event);
 
 		bool ShouldDraw() const { return m_ShouldDraw; }
 
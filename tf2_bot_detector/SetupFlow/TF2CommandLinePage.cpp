@@ -72,6 +72,17 @@ void TF2CommandLinePage::Data::TryUpdateCmdlineArgs()
 	}
 }
 
+void TF2CommandLinePage::OnProcessEvent(const Processes::ProcessEvent& event)
+{
+	if (event.m_Process != Processes::WatchedProcess::TF2)
+		return;
+
+	// Don't wait for CL_UPDATE_INTERVAL, the command line is either available now or gone.
+	m_Data.m_LastCLUpdate = {};
+	if (!event.m_Running)
+		m_Data.m_CommandLineArgs.reset();
+}
+
 auto TF2CommandLinePage::ValidateSettings(const Settings& settings) const -> ValidateSettingsResult
 {
 	if (!Processes::IsTF2Running()) {
@@ -23,6 +23,7 @@ namespace tf2_bot_detector
 		void Init(const InitState& is) override;
 		bool CanCommit() const override { return true; }
 		void Commit(const CommitState& cs) override;
+		void OnProcessEvent(const Processes::ProcessEvent& event) override;
 
 		bool WantsSetupText() const override { return false; }
 		bool WantsContinueButton() const override { return false; }
@@ -1,10 +1,9 @@
 #include "SteamID.h"
-#include "Util/RegexUtils.h"
 
 #include <mh/text/format.hpp>
 #include <nlohmann/json.hpp>
 
-#include <regex>
+#include <charconv>
 #include <stdexcept>
 
 using namespace std::string_literals;
@@ -14,85 +13,37 @@ SteamID::SteamID(const std::string_view& str)
 {
 	ID64 = 0;
 
-	// Steam3
-	static std::regex s_SteamID3Regex(R"regex(\[([a-zA-Z]):(\d):(\d+)(?::(\d+))?\])regex", std::regex::optimize);
-	if (std::match_results<std::string_view::const_iterator> result;
-		std::regex_match(str.begin(), str.end(), result, s_SteamID3Regex))
-	{
-		const char firstChar = *result[1].first;
-		switch (firstChar)
-		{
-		case 'U': Type = SteamAccountType::Individual; break;
-		case 'M': Type = SteamAccountType::Multiseat; break;
-		case 'G': Type = SteamAccountType::GameServer; break;
-		case 'A': Type = SteamAccountType::AnonGameServer; break;
-		case 'P': Type = SteamAccountType::Pending; break;
-		case 'C': Type = SteamAccountType::ContentServer; break;
-		case 'g': Type = SteamAccountType::Clan; break;
-		case 'a': Type = SteamAccountType::AnonUser; break;
-
-		case 'T':
-		case 'L':
-		case 'c':
-			Type = SteamAccountType::Chat; break;
-
-		case 'I':
-			Type = SteamAccountType::Invalid;
-			return; // We're totally done trying to parse
-
-		default:
-			throw std::invalid_argument(mh::format("Invalid SteamID3: Unknown SteamAccountType '{}'", firstChar));
-		}
-
-		{
-			uint32_t universe;
-			if (auto parseResult = from_chars(result[2], universe); !parseResult)
-				throw std::invalid_argument(mh::format("Out-of-range value for SteamID3 universe: {}", result[2].str()));
-
-			Universe = static_cast<SteamAccountUniverse>(universe);
-		}
-
-		{
-			uint32_t id;
-			if (auto parseResult = from_chars(result[3], id); !parseResult)
-				throw std::invalid_argument(mh::format("Out-of-range value for SteamID3 ID: {}", result[3].str()));
-
-			ID = id;
-		}
-
-		if (result[4].matched)
-		{
-			uint32_t instance;
-			if (auto parseResult = from_chars(result[4], instance); !parseResult)
-				throw std::invalid_argument(mh::format("Out-of-range value for SteamID3 account instance: {}", result[4].str()));
+	if (auto steamID3 = TryParseSteamID3(str))
+		*this = *steamID3;
+	else if (auto steamID64 = TryParseSteamID64(str))
+		*this = *steamID64;
+	else if (auto steamID2 = TryParseSteamID2(str))
+		*this = *steamID2;
+	else
+		throw std::invalid_argument("SteamID string does not match any known formats");
+}
 
-			Instance = static_cast<SteamAccountInstance>(instance);
-		}
-		else
-		{
-			Instance = SteamAccountInstance::Desktop;
-		}
+std::string SteamID::str() const
+{
+	char buf[STEAMID3_MAX_LENGTH];
+	const auto result = to_chars(buf, buf + STEAMID3_MAX_LENGTH, *this);
+	return std::string(buf, result.ptr);
+}
 
-		return;
-	}
+void tf2_bot_detector::AppendSteamID64s(std::string& str, const std::span<const SteamID>& ids, char separator)
+{
+	// 20 digits for UINT64_MAX, plus the separator
+	str.reserve(str.size() + ids.size() * 21);
 
-	// Steam64
-	if (std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(c) || std::isspace(c); }))
+	char buf[20];
+	for (size_t i = 0; i < ids.size(); i++)
 	{
-		uint64_t result;
-		if (auto parseResult = mh::from_chars(str, result); !parseResult)
-			throw std::invalid_argument(mh::format("Out-of-range SteamID64: {}", str));
+		if (i != 0)
+			str.push_back(separator);
 
-		ID64 = result;
-		return;
+		const auto result = std::to_chars(buf, buf + sizeof(buf), ids[i].ID64);
+		str.append(buf, result.ptr);
 	}
-
-	throw std::invalid_argument("SteamID string does not match any known formats");
-}
-
-std::string SteamID::str() const
-{
-	return mh::format("{}", *this);
 }
 
 void tf2_bot_detector::to_json(nlohmann::json& j, const SteamID& d)
@@ -3,10 +3,17 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <cassert>
+#include <charconv>
 #include <compare>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <type_traits>
 
 namespace tf2_bot_detector
 {
@@ -94,33 +101,284 @@ namespace tf2_bot_detector
 	void to_json(nlohmann::json& j, const SteamID& d);
 	void from_json(const nlohmann::json& j, SteamID& d);
 
-	template<typename CharT, typename Traits>
-	std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const tf2_bot_detector::SteamID& id)
+	namespace detail::SteamID_h
+	{
+		constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+		// Everything from pos up to the first non-digit. Empty if there weren't any.
+		constexpr std::string_view TakeDigits(const std::string_view& str, size_t& pos)
+		{
+			const size_t begin = pos;
+			while (pos < str.size() && IsDigit(str[pos]))
+				pos++;
+
+			return str.substr(begin, pos - begin);
+		}
+
+		constexpr uint32_t ParseUInt32(const std::string_view& digits, const char* outOfRangeMsg)
+		{
+			uint64_t value = 0;
+			for (char c : digits)
+			{
+				value = (value * 10) + (c - '0');
+				if (value > UINT32_MAX)
+					throw std::invalid_argument(outOfRangeMsg);
+			}
+
+			return static_cast<uint32_t>(value);
+		}
+
+		constexpr uint64_t ParseUInt64(const std::string_view& digits, const char* outOfRangeMsg)
+		{
+			uint64_t value = 0;
+			for (char c : digits)
+			{
+				const uint64_t digit = c - '0';
+				if (value > (UINT64_MAX - digit) / 10)
+					throw std::invalid_argument(outOfRangeMsg);
+
+				value = (value * 10) + digit;
+			}
+
+			return value;
+		}
+
+		constexpr bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+		}
+
+		constexpr char* WriteUInt(char* first, char* last, uint64_t value)
+		{
+			char digits[20]{};
+			size_t count = 0;
+			do
+			{
+				digits[count++] = char('0' + (value % 10));
+				value /= 10;
+			} while (value != 0);
+
+			if (size_t(last - first) < count)
+				return nullptr;
+
+			while (count > 0)
+				*first++ = digits[--count];
+
+			return first;
+		}
+
+		constexpr char* WriteString(char* first, char* last, const std::string_view& str)
+		{
+			if (size_t(last - first) < str.size())
+				return nullptr;
+
+			for (char c : str)
+				*first++ = c;
+
+			return first;
+		}
+	}
+
+	/// <summary>
+	/// Parses "[U:1:1234]" or "[U:1:1234:1]" without a regex. Returns nullopt if str isn't
+	/// shaped like a Steam3 ID at all, and throws std::invalid_argument for unknown account
+	/// types and out of range numbers (like the SteamID(string_view) constructor).
+	/// </summary>
+	constexpr std::optional<SteamID> TryParseSteamID3(const std::string_view& str)
+	{
+		using namespace detail::SteamID_h;
+
+		// [T:U:
+		if (str.size() < 7 || str[0] != '[' || str[2] != ':' || !IsDigit(str[3]) || str[4] != ':' || str.back() != ']')
+			return std::nullopt;
+
+		const char typeChar = str[1];
+		if (!((typeChar >= 'a' && typeChar <= 'z') || (typeChar >= 'A' && typeChar <= 'Z')))
+			return std::nullopt;
+
+		size_t pos = 5;
+		const auto id = TakeDigits(str, pos);
+		if (id.empty())
+			return std::nullopt;
+
+		std::string_view instance;
+		if (pos < str.size() && str[pos] == ':')
+		{
+			pos++;
+			instance = TakeDigits(str, pos);
+			if (instance.empty())
+				return std::nullopt;
+		}
+
+		if (pos != str.size() - 1)
+			return std::nullopt;
+
+		SteamAccountType type{};
+		switch (typeChar)
+		{
+		case 'U': type = SteamAccountType::Individual; break;
+		case 'M': type = SteamAccountType::Multiseat; break;
+		case 'G': type = SteamAccountType::GameServer; break;
+		case 'A': type = SteamAccountType::AnonGameServer; break;
+		case 'P': type = SteamAccountType::Pending; break;
+		case 'C': type = SteamAccountType::ContentServer; break;
+		case 'g': type = SteamAccountType::Clan; break;
+		case 'a': type = SteamAccountType::AnonUser; break;
+
+		case 'T':
+		case 'L':
+		case 'c':
+			type = SteamAccountType::Chat; break;
+
+		case 'I':
+			return SteamID{}; // We're totally done trying to parse
+
+		default:
+			throw std::invalid_argument("Invalid SteamID3: Unknown SteamAccountType");
+		}
+
+		return SteamID(
+			ParseUInt32(id, "Out-of-range value for SteamID3 ID"),
+			type,
+			static_cast<SteamAccountUniverse>(str[3] - '0'),
+			instance.empty() ? SteamAccountInstance::Desktop :
+				static_cast<SteamAccountInstance>(ParseUInt32(instance, "Out-of-range value for SteamID3 account instance")));
+	}
+
+	/// <summary>
+	/// Parses a SteamID64 like "76561198003911389", ignoring any surrounding whitespace.
+	/// Returns nullopt if there is anything besides digits, and throws std::invalid_argument
+	/// if it doesn't fit in 64 bits.
+	/// </summary>
+	constexpr std::optional<SteamID> TryParseSteamID64(std::string_view str)
+	{
+		using namespace detail::SteamID_h;
+
+		while (!str.empty() && IsSpace(str.front()))
+			str.remove_prefix(1);
+		while (!str.empty() && IsSpace(str.back()))
+			str.remove_suffix(1);
+
+		size_t pos = 0;
+		const auto digits = TakeDigits(str, pos);
+		if (digits.empty() || pos != str.size())
+			return std::nullopt;
+
+		return SteamID(ParseUInt64(digits, "Out-of-range SteamID64"));
+	}
+
+	/// <summary>
+	/// Parses a legacy "STEAM_0:1:1234" ID. These are always individual accounts, and
+	/// universe 0 is treated as public like Source games do. Returns nullopt if str isn't
+	/// shaped like a Steam2 ID, and throws std::invalid_argument for out of range numbers.
+	/// </summary>
+	constexpr std::optional<SteamID> TryParseSteamID2(const std::string_view& str)
+	{
+		using namespace detail::SteamID_h;
+
+		constexpr std::string_view PREFIX = "STEAM_";
+		if (!str.starts_with(PREFIX))
+			return std::nullopt;
+
+		size_t pos = PREFIX.size();
+		const auto universe = TakeDigits(str, pos);
+		if (universe.empty() || pos >= str.size() || str[pos++] != ':')
+			return std::nullopt;
+
+		if (pos + 1 >= str.size() || (str[pos] != '0' && str[pos] != '1') || str[pos + 1] != ':')
+			return std::nullopt;
+
+		const uint32_t lowBit = str[pos] - '0';
+		pos += 2;
+
+		const auto accountNumber = TakeDigits(str, pos);
+		if (accountNumber.empty() || pos != str.size())
+			return std::nullopt;
+
+		const uint32_t universeValue = ParseUInt32(universe, "Out-of-range value for SteamID2 universe");
+		const uint64_t id = (uint64_t(ParseUInt32(accountNumber, "Out-of-range value for SteamID2 account number")) << 1) | lowBit;
+		if (id > UINT32_MAX || universeValue > 0xFF)
+			throw std::invalid_argument("Out-of-range SteamID2");
+
+		return SteamID(uint32_t(id), SteamAccountType::Individual,
+			universeValue == 0 ? SteamAccountUniverse::Public : static_cast<SteamAccountUniverse>(universeValue));
+	}
+
+	// Enough for "[P2PSuperSeeder:255:4294967295]"
+	inline constexpr size_t STEAMID3_MAX_LENGTH = 31;
+
+	/// <summary>
+	/// Writes id as a Steam3 ID, the same way operator<< does. Like std::to_chars, nothing
+	/// is null terminated and ec is std::errc::value_too_large if [first, last) is too small.
+	/// </summary>
+	constexpr std::to_chars_result to_chars(char* first, char* last, const SteamID& id)
 	{
-		using namespace tf2_bot_detector;
+		using namespace detail::SteamID_h;
 
-		const char* c;
+		std::string_view type;
 		switch (id.Type)
 		{
-		case SteamAccountType::P2PSuperSeeder: c = "P2PSuperSeeder"; break;
+		case SteamAccountType::P2PSuperSeeder: type = "P2PSuperSeeder"; break;
 
-		case SteamAccountType::Individual:     c = "U"; break;
-		case SteamAccountType::Multiseat:      c = "M"; break;
-		case SteamAccountType::GameServer:     c = "G"; break;
-		case SteamAccountType::AnonGameServer: c = "A"; break;
-		case SteamAccountType::Pending:        c = "P"; break;
-		case SteamAccountType::ContentServer:  c = "C"; break;
-		case SteamAccountType::Clan:           c = "g"; break;
-		case SteamAccountType::AnonUser:       c = "a"; break;
-		case SteamAccountType::Chat:           c = "c"; break;
+		case SteamAccountType::Individual:     type = "U"; break;
+		case SteamAccountType::Multiseat:      type = "M"; break;
+		case SteamAccountType::GameServer:     type = "G"; break;
+		case SteamAccountType::AnonGameServer: type = "A"; break;
+		case SteamAccountType::Pending:        type = "P"; break;
+		case SteamAccountType::ContentServer:  type = "C"; break;
+		case SteamAccountType::Clan:           type = "g"; break;
+		case SteamAccountType::AnonUser:       type = "a"; break;
+		case SteamAccountType::Chat:           type = "c"; break;
 
 		default:
 			assert(!"Invalid value when serializing SteamID");
 			[[fallthrough]];
-		case SteamAccountType::Invalid:        c = "I"; break;
+		case SteamAccountType::Invalid:        type = "I"; break;
+		}
+
+		char* it = WriteString(first, last, "[");
+		if (it)
+			it = WriteString(it, last, type);
+		if (it)
+			it = WriteString(it, last, ":");
+		if (it)
+			it = WriteUInt(it, last, static_cast<uint64_t>(id.Universe));
+		if (it)
+			it = WriteString(it, last, ":");
+		if (it)
+			it = WriteUInt(it, last, id.ID);
+		if (it)
+			it = WriteString(it, last, "]");
+
+		if (!it)
+			return { last, std::errc::value_too_large };
+
+		return { it, std::errc{} };
+	}
+
+	/// <summary>
+	/// Appends the SteamID64 of each id to str, with separator in between.
+	/// </summary>
+	void AppendSteamID64s(std::string& str, const std::span<const SteamID>& ids, char separator = ',');
+
+	template<typename CharT, typename Traits>
+	std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const tf2_bot_detector::SteamID& id)
+	{
+		char buf[STEAMID3_MAX_LENGTH];
+		const auto result = to_chars(buf, buf + STEAMID3_MAX_LENGTH, id);
+		assert(result.ec == std::errc{});
+
+		if constexpr (std::is_same_v<CharT, char>)
+		{
+			os.write(buf, result.ptr - buf);
+		}
+		else
+		{
+			for (const char* it = buf; it != result.ptr; ++it)
+				os << os.widen(*it);
 		}
 
-		return os << '[' << c << ':' << static_cast<int>(id.Universe) << ':' << id.ID << ']';
+		return os;
 	}
 }
 
@@ -0,0 +1,215 @@
+#include "TeamStats.h"
+#include "ConsoleLog/ConsoleLines/KillNotificationLine.h"
+#include "Config/PlayerListJSON.h"
+#include "GameData/IPlayer.h"
+#include "Log.h"
+#include "ModeratorLogic.h"
+#include "WorldState.h"
+
+using namespace tf2_bot_detector;
+
+std::chrono::seconds TeamStats::GetAccountAgeSum() const
+{
+	const auto now = std::chrono::duration_cast<std::chrono::seconds>(clock_t::now().time_since_epoch());
+	return (now * m_AccountAgeCount) - m_AccountCreationTimeSum;
+}
+
+TeamStatsTracker::TeamStatsTracker(IWorldState& world, IModeratorLogic& modLogic) :
+	AutoWorldEventListener(world),
+	AutoConsoleLineListener(world),
+	m_World(world),
+	m_ModLogic(modLogic)
+{
+}
+
+void TeamStatsTracker::OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player)
+{
+	m_DirtyPlayers.insert(player.GetSteamID());
+}
+
+void TeamStatsTracker::OnPlayerDroppedFromServer(IWorldState& world, IPlayer& player, const std::string_view& reason)
+{
+	m_DirtyPlayers.insert(player.GetSteamID());
+}
+
+void TeamStatsTracker::OnConsoleLineParsed(IWorldState& world, IConsoleLine& line)
+{
+	switch (line.GetType())
+	{
+	case ConsoleLineType::KillNotification:
+	{
+		auto& killLine = static_cast<const KillNotificationLine&>(line);
+		if (auto attacker = world.FindSteamIDForName(killLine.GetAttackerName()))
+			m_DirtyPlayers.insert(*attacker);
+		if (auto victim = world.FindSteamIDForName(killLine.GetVictimName()))
+			m_DirtyPlayers.insert(*victim);
+
+		break;
+	}
+
+	// Everyone's team (or scores) might have changed
+	case ConsoleLineType::LobbyHeader:
+	case ConsoleLineType::LobbyMember:
+	case ConsoleLineType::LobbyChanged:
+	case ConsoleLineType::LobbyStatusFailed:
+	case ConsoleLineType::HostNewGame:
+	case ConsoleLineType::Connecting:
+	case ConsoleLineType::ClientReachedServerSpawn:
+		m_NeedsRebuild = true;
+		break;
+
+	default:
+		break;
+	}
+}
+
+void TeamStatsTracker::Refresh()
+{
+	if (auto playerList = m_ModLogic.GetPlayerList())
+	{
+		if (const auto revision = playerList->GetRevision(); revision != m_PlayerListRevision)
+		{
+			m_PlayerListRevision = revision;
+			m_NeedsRebuild = true;
+		}
+	}
+
+	if (const IPlayer* localPlayer = m_World.LocalPlayer())
+	{
+		if (auto localTeam = m_World.FindLobbyMemberTeam(localPlayer->GetSteamID()); localTeam != m_LocalTeam)
+		{
+			m_LocalTeam = localTeam;
+			m_NeedsRebuild = true;
+		}
+	}
+
+	if (m_NeedsRebuild)
+	{
+		Rebuild();
+		return;
+	}
+
+	if (m_HasPendingSummaries)
+	{
+		// Steam API data doesn't come with an event, so keep an eye on anyone we only have an estimate for
+		m_HasPendingSummaries = false;
+		for (const auto& [steamID, contribution] : m_Contributions)
+		{
+			if (!contribution.m_IsSummaryPending)
+				continue;
+
+			const IPlayer* player = m_World.FindPlayer(steamID);
+			if (player && !player->GetPlayerSummary() &&
+				player->GetPlayerSummary().error() == std::errc::operation_in_progress)
+			{
+				m_HasPendingSummaries = true;
+			}
+			else
+			{
+				m_DirtyPlayers.insert(steamID);
+			}
+		}
+	}
+
+	for (const SteamID& steamID : m_DirtyPlayers)
+	{
+		if (const IPlayer* player = m_World.FindPlayer(steamID))
+			UpdatePlayer(*player);
+	}
+
+	m_DirtyPlayers.clear();
+}
+
+void TeamStatsTracker::Rebuild()
+{
+	m_NeedsRebuild = false;
+	m_HasPendingSummaries = false;
+	m_DirtyPlayers.clear();
+	m_Contributions.clear();
+	m_Teams[0] = {};
+	m_Teams[1] = {};
+
+	for (const IPlayer& player : std::as_const(m_World).GetPlayers())
+		UpdatePlayer(player);
+}
+
+void TeamStatsTracker::UpdatePlayer(const IPlayer& player)
+{
+	Contribution newContribution = CalculateContribution(player);
+	m_HasPendingSummaries |= newContribution.m_IsSummaryPending;
+
+	auto& contribution = m_Contributions[player.GetSteamID()];
+	Apply(contribution, false);
+	contribution = newContribution;
+	Apply(contribution, true);
+}
+
+auto TeamStatsTracker::CalculateContribution(const IPlayer& player) -> Contribution
+{
+	Contribution retVal;
+
+	switch (m_World.GetTeamShareResult(player))
+	{
+	case TeamShareResult::SameTeams:
+		retVal.m_Team = &m_Teams[0];
+		break;
+	case TeamShareResult::OppositeTeams:
+		retVal.m_Team = &m_Teams[1];
+		break;
+	default:
+		LogError("Unknown TeamShareResult");
+		[[fallthrough]];
+	case TeamShareResult::Neither:
+		return retVal;
+	}
+
+	retVal.m_IsActive = player.GetConnectionState() == PlayerStatusState::Active;
+	retVal.m_Kills = player.GetScores().m_Kills;
+	retVal.m_Deaths = player.GetScores().m_Deaths;
+
+	if (auto playerList = m_ModLogic.GetPlayerList())
+		retVal.m_IsMarked = !playerList->GetPlayerAttributes(player).empty();
+
+	const auto& summary = player.GetPlayerSummary();
+	retVal.m_IsSummaryPending = !summary && summary.error() == std::errc::operation_in_progress;
+	retVal.m_AccountCreationTime = player.GetEstimatedAccountCreationTime();
+
+	return retVal;
+}
+
+void TeamStatsTracker::Apply(const Contribution& contribution, bool add)
+{
+	TeamStats* team = contribution.m_Team;
+	if (!team)
+		return;
+
+	// unsigned wraparound makes subtracting exactly undo adding
+	const auto Accumulate = [add](auto& total, auto value)
+	{
+		if (add)
+			total += value;
+		else
+			total -= value;
+	};
+
+	Accumulate(team->m_PlayerCount, uint8_t(1));
+	Accumulate(team->m_Kills, contribution.m_Kills);
+	Accumulate(team->m_Deaths, contribution.m_Deaths);
+
+	if (contribution.m_IsActive)
+		Accumulate(team->m_PlayerCountActive, uint8_t(1));
+
+	if (contribution.m_IsMarked)
+	{
+		Accumulate(team->m_MarkedCount, 1u);
+		if (contribution.m_IsActive)
+			Accumulate(team->m_MarkedCountActive, 1u);
+	}
+
+	if (contribution.m_AccountCreationTime)
+	{
+		Accumulate(team->m_AccountAgeCount, 1u);
+		Accumulate(team->m_AccountCreationTimeSum,
+			std::chrono::duration_cast<std::chrono::seconds>(contribution.m_AccountCreationTime->time_since_epoch()));
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Clock.h"
+#include "LobbyMember.h"
+#include "ConsoleLog/ConsoleLineListener.h"
+#include "SteamID.h"
+#include "WorldEventListener.h"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tf2_bot_detector
+{
+	class IModeratorLogic;
+	class IPlayer;
+
+	struct TeamStats
+	{
+		uint8_t m_PlayerCount = 0;
+		uint8_t m_PlayerCountActive = 0;
+		uint32_t m_Kills = 0;
+		uint32_t m_Deaths = 0;
+		uint32_t m_MarkedCount = 0;
+		uint32_t m_MarkedCountActive = 0;
+
+		// Number of players we know (or can estimate) the account age of
+		uint32_t m_AccountAgeCount = 0;
+
+		// Sum of the account ages of the players counted in m_AccountAgeCount
+		// (seconds, because nanoseconds overflow after a couple dozen players)
+		std::chrono::seconds GetAccountAgeSum() const;
+
+	private:
+		friend class TeamStatsTracker;
+
+		// Ages keep growing, creation times don't, so this is what we actually keep track of
+		std::chrono::seconds m_AccountCreationTimeSum{};
+	};
+
+	/// <summary>
+	/// Player/kill/mark counts for the friendly and enemy teams.
+	///
+	/// Each player's contribution is remembered, so status updates and kills only have to
+	/// touch the players involved. Lobby changes, playerlist changes and the local player
+	/// changing teams rebuild everything.
+	/// </summary>
+	class TeamStatsTracker final : AutoWorldEventListener, AutoConsoleLineListener
+	{
+	public:
+		TeamStatsTracker(IWorldState& world, IModeratorLogic& modLogic);
+
+		const TeamStats& GetFriendlyTeam() { Refresh(); return m_Teams[0]; }
+		const TeamStats& GetEnemyTeam() { Refresh(); return m_Teams[1]; }
+
+	private:
+		IWorldState& m_World;
+		IModeratorLogic& m_ModLogic;
+
+		struct Contribution
+		{
+			TeamStats* m_Team = nullptr;  // nullptr if not on either team
+			bool m_IsActive = false;
+			bool m_IsMarked = false;
+			uint32_t m_Kills = 0;
+			uint32_t m_Deaths = 0;
+			std::optional<time_point_t> m_AccountCreationTime;
+
+			// Their steam summary was still loading, so m_AccountCreationTime is only an estimate
+			bool m_IsSummaryPending = false;
+		};
+
+		TeamStats m_Teams[2];
+		std::unordered_map<SteamID, Contribution> m_Contributions;
+		std::unordered_set<SteamID> m_DirtyPlayers;
+		bool m_NeedsRebuild = true;
+		bool m_HasPendingSummaries = false;
+		uint64_t m_PlayerListRevision = 0;
+
+		// Which side everyone else is on is relative to us
+		std::optional<LobbyMemberTeam> m_LocalTeam;
+
+		void Refresh();
+		void Rebuild();
+		void UpdatePlayer(const IPlayer& player);
+		Contribution CalculateContribution(const IPlayer& player);
+		static void Apply(const Contribution& contribution, bool add);
+
+		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) override;
+		void OnPlayerDroppedFromServer(IWorldState& world, IPlayer& player, const std::string_view& reason) override;
+		void OnLocalPlayerInitialized(IWorldState& world, bool initialized) override { m_NeedsRebuild = true; }
+		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override;
+	};
+}
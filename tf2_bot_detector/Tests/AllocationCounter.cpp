@@ -0,0 +1,66 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	std::atomic<uint64_t> s_AllocationCount = 0;
+	std::atomic<uint64_t> s_AllocatedBytes = 0;
+
+	void* CountedAlloc(std::size_t size)
+	{
+		s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+		s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		if (size == 0)
+			size = 1;
+
+		while (true)
+		{
+			if (void* ptr = std::malloc(size))
+				return ptr;
+
+			if (auto handler = std::get_new_handler())
+				handler();
+			else
+				throw std::bad_alloc();
+		}
+	}
+}
+
+AllocationCounts tf2_bot_detector::GetAllocationCounts()
+{
+	return { s_AllocationCount.load(std::memory_order_relaxed), s_AllocatedBytes.load(std::memory_order_relaxed) };
+}
+
+// The nothrow versions of these forward here by default. The aligned ones are left alone,
+// they're rare enough to not matter and come with their own matching deletes.
+void* operator new(std::size_t size)
+{
+	return CountedAlloc(size);
+}
+void* operator new[](std::size_t size)
+{
+	return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
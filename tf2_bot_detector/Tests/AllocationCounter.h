@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tf2_bot_detector
+{
+	struct AllocationCounts
+	{
+		uint64_t m_Count = 0;
+		uint64_t m_Bytes = 0;
+
+		AllocationCounts operator-(const AllocationCounts& other) const
+		{
+			return { m_Count - other.m_Count, m_Bytes - other.m_Bytes };
+		}
+	};
+
+	// Every call to the global operator new/new[] so far, on any thread. Only available
+	// when the tests are compiled in (they replace the global allocation functions).
+	AllocationCounts GetAllocationCounts();
+}
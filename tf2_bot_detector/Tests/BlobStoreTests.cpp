@@ -0,0 +1,169 @@
+#include "DB/BlobStore.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	std::span<const std::byte> AsBytes(const std::string_view& str)
+	{
+		return std::as_bytes(std::span(str.data(), str.size()));
+	}
+
+	std::string_view AsString(const BlobStore::Blob& blob)
+	{
+		return std::string_view(reinterpret_cast<const char*>(blob.m_Data.data()), blob.m_Data.size());
+	}
+}
+
+TEST_CASE("tf2bd_blobstore_roundtrip", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_blobstore_tests");
+	const auto path = dir / "test.blob";
+
+	{
+		BlobStore store(path, 1024 * 1024, 24h);
+		REQUIRE(!store.Find("a"));
+
+		store.Store("a", AsBytes("first"));
+		store.Store("b", AsBytes("second"));
+		store.Store("a", AsBytes("replaced"));
+
+		REQUIRE(AsString(store.Find("a")) == "replaced");
+		REQUIRE(AsString(store.Find("b")) == "second");
+		REQUIRE(store.GetBlobCount() == 2);
+	}
+
+	// Everything survives a reopen
+	{
+		BlobStore store(path, 1024 * 1024, 24h);
+		REQUIRE(store.GetBlobCount() == 2);
+		REQUIRE(AsString(store.Find("b")) == "second");
+	}
+
+	// ...even without the index
+	std::filesystem::remove(std::filesystem::path(path) += ".idx");
+	{
+		BlobStore store(path, 1024 * 1024, 24h);
+		REQUIRE(store.GetBlobCount() == 2);
+		REQUIRE(AsString(store.Find("a")) == "replaced");
+	}
+}
+
+TEST_CASE("tf2bd_blobstore_remove", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_blobstore_tests");
+	const auto path = dir / "test.blob";
+
+	{
+		BlobStore store(path, 1024 * 1024, 24h);
+		store.Store("a", AsBytes("garbage"));
+		store.Store("b", AsBytes("second"));
+
+		store.Remove("a");
+		store.Remove("doesn't exist");
+		REQUIRE(!store.Find("a"));
+		REQUIRE(store.GetBlobCount() == 1);
+		REQUIRE(store.GetLiveBytes() < store.GetDataFileSize());
+	}
+
+	// Stays gone, and the space is reclaimed
+	{
+		BlobStore store(path, 1024 * 1024, 24h);
+		REQUIRE(!store.Find("a"));
+		REQUIRE(AsString(store.Find("b")) == "second");
+		REQUIRE(store.GetDataFileSize() == store.GetLiveBytes());
+
+		// Re-fetched after being removed
+		store.Store("a", AsBytes("good"));
+		REQUIRE(AsString(store.Find("a")) == "good");
+	}
+}
+
+TEST_CASE("tf2bd_blobstore_eviction", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_blobstore_tests");
+	const auto path = dir / "test.blob";
+	const std::string payload(100, 'x');
+
+	{
+		// Room for about three of these
+		BlobStore store(path, 400, 24h);
+
+		// Make sure every access gets a distinct timestamp
+		const auto Tick = [] { std::this_thread::sleep_for(2ms); };
+
+		store.Store("a", AsBytes(payload));
+		Tick();
+		store.Store("b", AsBytes(payload));
+		Tick();
+		store.Store("c", AsBytes(payload));
+		Tick();
+
+		REQUIRE(store.Find("a")); // a is now more recently used than b
+		Tick();
+		store.Store("d", AsBytes(payload));
+
+		REQUIRE(store.GetBlobCount() == 3);
+		REQUIRE(store.Find("a"));
+		REQUIRE(!store.Find("b"));
+		REQUIRE(store.Find("d"));
+		REQUIRE(store.GetDataFileSize() > store.GetLiveBytes());
+	}
+
+	// Dead space is reclaimed on open
+	{
+		BlobStore store(path, 400, 24h);
+		REQUIRE(store.GetBlobCount() == 3);
+		REQUIRE(store.GetDataFileSize() == store.GetLiveBytes());
+		REQUIRE(AsString(store.Find("d")) == payload);
+	}
+}
+
+TEST_CASE("tf2bd_blobstore_rebuild", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_blobstore_tests");
+	const auto path = dir / "test.blob";
+	const auto indexPath = std::filesystem::path(path) += ".idx";
+	const std::string payload(100, 'x');
+
+	{
+		BlobStore store(path, 400, 24h);
+		store.Store("a", AsBytes(payload));
+		std::this_thread::sleep_for(2ms);
+		store.Store("b", AsBytes(payload));
+		store.Store("c", AsBytes(payload));
+		store.Store("d", AsBytes(payload)); // evicts a
+		store.Remove("b");
+		REQUIRE(store.GetBlobCount() == 2);
+	}
+
+	// Removed and evicted blobs stay gone when the index has to be rebuilt
+	std::filesystem::remove(indexPath);
+	{
+		BlobStore store(path, 400, 24h);
+		REQUIRE(store.GetBlobCount() == 2);
+		REQUIRE(!store.Find("a"));
+		REQUIRE(!store.Find("b"));
+		REQUIRE(AsString(store.Find("c")) == payload);
+		REQUIRE(AsString(store.Find("d")) == payload);
+	}
+
+	// A rebuilt index remembers when blobs were stored, instead of treating them all as new.
+	// Stored times only have second precision.
+	std::this_thread::sleep_for(1100ms);
+	std::filesystem::remove(indexPath);
+	{
+		BlobStore store(path, 400, 1s);
+		REQUIRE(store.GetBlobCount() == 0);
+	}
+}
@@ -70,8 +70,13 @@ namespace Catch
 	}
 }
 
-int tf2_bot_detector::RunTests()
+int tf2_bot_detector::RunTests(int argc, const char* const* argv)
 {
 	DebugLog(MH_SOURCE_LOCATION_CURRENT());
-	return Catch::Session().run();
+
+	Catch::Session session;
+	if (argc > 0)
+		return session.run(argc, argv);
+
+	return session.run();
 }
@@ -0,0 +1,78 @@
+#include "Config/ConfigSaveScheduler.h"
+#include "Filesystem.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <filesystem>
+
+using namespace tf2_bot_detector;
+
+TEST_CASE("tf2bd_config_save_coalesce", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_config_save_tests");
+	const auto path = dir / "test.json";
+	auto& scheduler = IConfigSaveScheduler::Get();
+
+	std::atomic<int> serializeCount = 0;
+	std::atomic<int> savedCount = 0;
+
+	for (int i = 0; i < 10; i++)
+	{
+		scheduler.QueueSave(path,
+			[&, i](nlohmann::json& json) -> std::error_condition
+			{
+				serializeCount++;
+				json = { { "value", i } };
+				return {};
+			},
+			[&](const std::error_condition& result)
+			{
+				// Save thread, no REQUIRE here
+				if (!result)
+					savedCount++;
+			});
+	}
+
+	// Still inside the window
+	REQUIRE(scheduler.IsPending(path));
+
+	scheduler.Flush(path);
+	REQUIRE(!scheduler.IsPending(path));
+
+	// Only the newest one was written, but everyone heard about it
+	REQUIRE(serializeCount == 1);
+	REQUIRE(savedCount == 10);
+
+	const auto json = nlohmann::json::parse(IFilesystem::Get().ReadFile(path));
+	REQUIRE(json.at("value") == 9);
+
+	// Nothing left behind from the temp file + rename
+	size_t fileCount = 0;
+	for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(path.parent_path()))
+		fileCount++;
+
+	REQUIRE(fileCount == 1);
+}
+
+TEST_CASE("tf2bd_config_save_failed_serialize", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_config_save_tests");
+	const auto path = dir / "test.json";
+	auto& scheduler = IConfigSaveScheduler::Get();
+
+	std::error_condition savedResult;
+	scheduler.QueueSave(path,
+		[](nlohmann::json& json) -> std::error_condition
+		{
+			return std::errc::invalid_argument;
+		},
+		[&](const std::error_condition& result) { savedResult = result; });
+
+	scheduler.Flush();
+
+	REQUIRE(savedResult == std::errc::invalid_argument);
+	REQUIRE(!std::filesystem::exists(path));
+}
@@ -0,0 +1,172 @@
+#include "ConsoleLog/IConsoleLine.h"
+#include "ConsoleLog/ConsoleLines/ClientReachedServerSpawnLine.h"
+#include "AllocationCounter.h"
+#include "DummyWorldState.h"
+#include "Log.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	DummyWorldState s_DummyWorldState;
+
+	// A few thousand lines in roughly the proportions they show up in a real console.log:
+	// mostly spam nobody parses, then killfeed, status dumps, chat and net_status output.
+	std::vector<std::string> LoadCorpus()
+	{
+		const auto path = std::filesystem::path(TF2BD_TEST_DATA_DIR) / "ConsoleLines" / "mixed.txt";
+		std::ifstream file(path, std::ios::binary);
+		REQUIRE(file.good());
+
+		std::vector<std::string> lines;
+		for (std::string line; std::getline(file, line); )
+			lines.push_back(std::move(line));
+
+		return lines;
+	}
+
+	std::string GetTypeName(const std::type_info& type)
+	{
+#ifdef __GNUC__
+		int status = 0;
+		std::unique_ptr<char, decltype(&std::free)> demangled(
+			abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), &std::free);
+		std::string name = (status == 0 && demangled) ? demangled.get() : type.name();
+#else
+		std::string name = type.name(); // "class tf2_bot_detector::KillNotificationLine"
+#endif
+
+		if (auto lastSeparator = name.rfind("::"); lastSeparator != name.npos)
+			name.erase(0, lastSeparator + 2);
+
+		return name;
+	}
+}
+
+TEST_CASE("tf2bd_cl_corpus", "[ConsoleLines]")
+{
+	const auto lines = LoadCorpus();
+	const auto timestamp = tfbd_clock_t::now();
+
+	std::map<ConsoleLineType, size_t> counts;
+	for (const auto& line : lines)
+	{
+		if (auto parsed = IConsoleLine::ParseConsoleLine(line, timestamp, s_DummyWorldState))
+			counts[parsed->GetType()]++;
+	}
+
+	// Make sure the corpus actually exercises the parsers we care about
+	REQUIRE(counts[ConsoleLineType::PlayerStatus] > 0);
+	REQUIRE(counts[ConsoleLineType::PlayerStatusShort] > 0);
+	REQUIRE(counts[ConsoleLineType::PlayerStatusHostName] > 0);
+	REQUIRE(counts[ConsoleLineType::KillNotification] > 0);
+	REQUIRE(counts[ConsoleLineType::Ping] > 0);
+	REQUIRE(counts[ConsoleLineType::NetStatusConfig] > 0);
+	REQUIRE(counts[ConsoleLineType::NetChannelLatencyLoss] > 0);
+	REQUIRE(counts[ConsoleLineType::NetDataPerClient] > 0);
+}
+
+// Run with --run-tests "[!benchmark]" (the tf2bd_benchmarks target does this)
+TEST_CASE("tf2bd_cl_allocations", "[ConsoleLines][!benchmark]")
+{
+	const auto lines = LoadCorpus();
+	const auto timestamp = tfbd_clock_t::now();
+
+	// The line objects on their own, before (make_shared) and after (pooled) ConsoleLineAllocator
+	{
+		ClientReachedServerSpawnLine::Create(timestamp).reset();  // Make sure the pool has a chunk already
+
+		const auto pooledBegin = GetAllocationCounts();
+		for (size_t i = 0; i < 10000; i++)
+			ClientReachedServerSpawnLine::Create(timestamp).reset();
+		const auto pooled = GetAllocationCounts() - pooledBegin;
+
+		const auto makeSharedBegin = GetAllocationCounts();
+		for (size_t i = 0; i < 10000; i++)
+			std::make_shared<ClientReachedServerSpawnLine>(timestamp).reset();
+		const auto makeShared = GetAllocationCounts() - makeSharedBegin;
+
+		Log("[ConsoleLines] 10000 line objects: make_shared {} allocations ({} bytes), pooled {} allocations ({} bytes)",
+			makeShared.m_Count, makeShared.m_Bytes, pooled.m_Count, pooled.m_Bytes);
+
+		CHECK(makeShared.m_Count == 10000);
+		CHECK(pooled.m_Count == 0);
+	}
+
+	const auto ParseLines = [&](size_t count)
+	{
+		size_t parsedCount = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (IConsoleLine::ParseConsoleLine(lines[i % lines.size()], timestamp, s_DummyWorldState))
+				parsedCount++;
+		}
+
+		return parsedCount;
+	};
+
+	ParseLines(lines.size());  // Warm up the line pools and any static regexes
+
+	const auto begin = GetAllocationCounts();
+	const size_t parsedCount = ParseLines(10000);
+	const auto allocations = GetAllocationCounts() - begin;
+
+	// Most of what's left is std::regex and the strings inside the lines themselves
+	Log("[ConsoleLines] 10000 lines ({} parsed): {} allocations ({} bytes)",
+		parsedCount, allocations.m_Count, allocations.m_Bytes);
+
+	REQUIRE(parsedCount > 0);
+}
+
+// Run with --run-tests "[!benchmark]" --reporter xml --out <file> (the tf2bd_benchmarks target
+// does this) to get results that can be compared across versions.
+TEST_CASE("tf2bd_cl_benchmark", "[ConsoleLines][!benchmark]")
+{
+	const auto lines = LoadCorpus();
+	const auto timestamp = tfbd_clock_t::now();
+
+	BENCHMARK("ParseConsoleLine")
+	{
+		size_t parsedCount = 0;
+		for (const auto& line : lines)
+		{
+			if (IConsoleLine::ParseConsoleLine(line, timestamp, s_DummyWorldState))
+				parsedCount++;
+		}
+
+		return parsedCount;
+	};
+
+	// Every type against every line, same as the worst case for ParseConsoleLine
+	for (const auto& type : IConsoleLine::GetRegisteredTypes())
+	{
+		BENCHMARK(mh::format("TryParse: {}", GetTypeName(*type.m_TypeInfo)))
+		{
+			size_t parsedCount = 0;
+			for (const auto& line : lines)
+			{
+				const ConsoleLineTryParseArgs args{ line, timestamp, s_DummyWorldState };
+				if (type.m_TryParseFunc(args))
+					parsedCount++;
+			}
+
+			return parsedCount;
+		};
+	}
+}
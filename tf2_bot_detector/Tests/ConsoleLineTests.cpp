@@ -1,116 +1,72 @@
-#include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/ConsoleLines/ChatConsoleLine.h"
+#include "ConsoleLog/ConsoleLines/ClientReachedServerSpawnLine.h"
+#include "ConsoleLog/ConsoleLines/ServerStatusPlayerLine.h"
+#include "AllocationCounter.h"
+#include "DummyWorldState.h"
 #include "SteamID.h"
-#include "WorldState.h"
+#include "Util/RegexUtils.h"
 
 #include <catch2/catch.hpp>
-#include <mh/error/not_implemented_error.hpp>
+
+#include <optional>
+#include <random>
+#include <regex>
+#include <string>
+#include <type_traits>
 
 using namespace std::chrono_literals;
 using namespace tf2_bot_detector;
 
 namespace
 {
-	class DummyWorldState : public IWorldState
+	DummyWorldState s_DummyWorldState;
+
+	// What ServerStatusPlayerLine::TryParse used to do, before it had its own tokenizer
+	std::optional<PlayerStatus> ParseStatusLineRegex(const std::string_view& text, time_point_t timestamp)
 	{
-		// Inherited via IWorldState
-		virtual IConsoleLineListener& GetConsoleLineListenerBroadcaster() override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void UpdateTimestamp(const ConsoleLogParser& parser) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void Update() override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual time_point_t GetCurrentTime() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual time_point_t GetLastStatusUpdateTime() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddWorldEventListener(IWorldEventListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void RemoveWorldEventListener(IWorldEventListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddConsoleLineListener(IConsoleLineListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void RemoveConsoleLineListener(IConsoleLineListener* listener) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual void AddConsoleOutputChunk(const std::string_view& chunk) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::task<> AddConsoleOutputLine(std::string line) override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<SteamID> FindSteamIDForName(const std::string_view& playerName) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<LobbyMemberTeam> FindLobbyMemberTeam(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual std::optional<UserID_t> FindUserID(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const SteamID& id0, const SteamID& id1) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual TeamShareResult GetTeamShareResult(const std::optional<LobbyMemberTeam>& team0, const SteamID& id1) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual const IPlayer* FindPlayer(const SteamID& id) const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual size_t GetApproxLobbyMemberCount() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::generator<const IPlayer&> GetLobbyMembers() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual mh::generator<const IPlayer&> GetPlayers() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual bool IsLocalPlayerInitialized() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual bool IsVoteInProgress() const override
-		{
-			throw mh::not_implemented_error();
-		}
-		virtual const IAccountAges& GetAccountAges() const override
-		{
-			throw mh::not_implemented_error();
-		}
+		static const std::regex s_Regex(R"regex(#\s+(\d+)\s+"((?:.)+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(.*))?)regex", std::regex::optimize);
+
+		svmatch result;
+		if (!std::regex_match(text.begin(), text.end(), result, s_Regex))
+			return std::nullopt;
+
+		PlayerStatus status{};
+
+		from_chars_throw(result[1], status.m_UserID);
+		status.m_Name = result[2].str();
+		status.m_SteamID = SteamID(to_string_view(result[3]));
+
+		uint32_t connectedHours = 0;
+		uint32_t connectedMins;
+		uint32_t connectedSecs;
+
+		if (result[4].matched)
+			from_chars_throw(result[4], connectedHours);
 
-	} static s_DummyWorldState;
+		from_chars_throw(result[5], connectedMins);
+		from_chars_throw(result[6], connectedSecs);
+
+		status.m_ConnectionTime = timestamp - ((connectedHours * 1h) + (connectedMins * 1min) + connectedSecs * 1s);
+
+		from_chars_throw(result[7], status.m_Ping);
+		from_chars_throw(result[8], status.m_Loss);
+
+		const auto state = to_string_view(result[9]);
+		if (state == "active")
+			status.m_State = PlayerStatusState::Active;
+		else if (state == "spawning")
+			status.m_State = PlayerStatusState::Spawning;
+		else if (state == "connecting")
+			status.m_State = PlayerStatusState::Connecting;
+		else if (state == "challenging")
+			status.m_State = PlayerStatusState::Challenging;
+		else
+			throw std::runtime_error("Unknown player status state");
+
+		status.m_Address = result[10].str();
+
+		return status;
+	}
 }
 
 TEST_CASE("tf2bd_cl_status", "[ConsoleLines]")
@@ -172,3 +128,148 @@ TEST_CASE("tf2bd_cl_status", "[ConsoleLines]")
 		REQUIRE(playerStatus.m_State == test.m_ExpectedState);
 	}
 }
+
+TEST_CASE("tf2bd_cl_status_fuzz", "[ConsoleLines]")
+{
+	// Mutations of these are run through both the tokenizer and the old regex, and have to come out the same
+	constexpr std::string_view SEEDS[] =
+	{
+		"#    672 \"Pazer\"   [U:1:123456]   01:23   60    0 active",
+		"#    672 \"Pazer\"   [U:1:123456]   1:01:23   60    0 active 192.168.1.1:27005",
+		"#      3 \"a \"quoted\" name\" [U:1:99] 12:00 75 0 spawning",
+		"#    348 \"[U:1:5] 1:00 0 0 active\" [U:1:1118537734] 00:51  157    0 connecting",
+		"#      7 \"x\" [A:1:2:3] 00:01 0 0 challenging loopback",
+		"#    348 \"\" 0 0\" [U:1:1] 1:2 3 4 active  ] x\"",
+	};
+
+	// No line breaks, std::regex implementations don't agree on whether . matches \r
+	constexpr std::string_view ALPHABET = " \t\"[]:#_0123456789aUIgxactive";
+
+	const auto timestamp = tfbd_clock_t::now();
+
+	std::mt19937 random(1234);
+	size_t parsedCount = 0;
+	for (size_t i = 0; i < 20000; i++)
+	{
+		std::string line(SEEDS[random() % std::size(SEEDS)]);
+		for (size_t mutations = 1 + random() % 4; mutations > 0 && !line.empty(); mutations--)
+		{
+			const size_t pos = random() % line.size();
+			const char c = ALPHABET[random() % ALPHABET.size()];
+			switch (random() % 3)
+			{
+			case 0: line.insert(line.begin() + pos, c); break;
+			case 1: line.erase(pos, 1); break;
+			case 2: line[pos] = c; break;
+			}
+		}
+
+		CAPTURE(line);
+
+		std::optional<PlayerStatus> expected;
+		bool expectedThrew = false;
+		try
+		{
+			expected = ParseStatusLineRegex(line, timestamp);
+		}
+		catch (...)
+		{
+			expectedThrew = true;
+		}
+
+		std::shared_ptr<IConsoleLine> parsed;
+		bool threw = false;
+		try
+		{
+			parsed = ServerStatusPlayerLine::TryParse({ line, timestamp, s_DummyWorldState });
+		}
+		catch (...)
+		{
+			threw = true;
+		}
+
+		REQUIRE(threw == expectedThrew);
+		if (threw)
+			continue;
+
+		REQUIRE(!!parsed == expected.has_value());
+		if (!parsed)
+			continue;
+
+		parsedCount++;
+		const PlayerStatus& status = static_cast<const ServerStatusPlayerLine&>(*parsed).GetPlayerStatus();
+		REQUIRE(status.m_UserID == expected->m_UserID);
+		REQUIRE(status.m_Name == expected->m_Name);
+		REQUIRE(status.m_SteamID == expected->m_SteamID);
+		REQUIRE(status.m_ConnectionTime == expected->m_ConnectionTime);
+		REQUIRE(status.m_Ping == expected->m_Ping);
+		REQUIRE(status.m_Loss == expected->m_Loss);
+		REQUIRE(status.m_State == expected->m_State);
+		REQUIRE(status.m_Address == expected->m_Address);
+	}
+
+	// Make sure the mutations aren't so aggressive that nothing ever parses
+	REQUIRE(parsedCount > 1000);
+}
+
+TEST_CASE("tf2bd_cl_chat_take_ownership", "[ConsoleLines]")
+{
+	std::string buf = "<playername>hello world";
+	const std::string_view bufView(buf);
+
+	ChatConsoleLine line(ChatConsoleLine::borrow_t{}, tfbd_clock_t::now(), bufView.substr(0, 12), bufView.substr(12),
+		false, true, false, TeamShareResult::SameTeams, SteamID{});
+
+	// No copies until someone needs one
+	REQUIRE(line.GetPlayerName().data() == buf.data());
+	REQUIRE(line.GetMessage().data() == buf.data() + 12);
+
+	line.TakeOwnership();
+	buf.assign(buf.size(), 'x');
+
+	REQUIRE(line.GetPlayerName() == "<playername>");
+	REQUIRE(line.GetMessage() == "hello world");
+	REQUIRE(line.IsTeam());
+
+	line.TakeOwnership();
+	REQUIRE(line.GetMessage() == "hello world");
+
+	// Owns its text from the start, in the same single buffer
+	ChatConsoleLine owning(tfbd_clock_t::now(), "a long enough player name to not fit in SSO", "gg", false, false, false, TeamShareResult::SameTeams, SteamID{});
+	REQUIRE(owning.GetPlayerName() == "a long enough player name to not fit in SSO");
+	REQUIRE(owning.GetMessage() == "gg");
+	REQUIRE(owning.GetMessage().data() == owning.GetPlayerName().data() + owning.GetPlayerName().size());
+
+	static_assert(!std::is_copy_constructible_v<ChatConsoleLine>);
+	static_assert(!std::is_move_constructible_v<ChatConsoleLine>);
+}
+
+TEST_CASE("tf2bd_cl_pool", "[ConsoleLines]")
+{
+	const auto timestamp = tfbd_clock_t::now();
+	ClientReachedServerSpawnLine::Create(timestamp).reset();  // Make sure the pool has a chunk already
+
+	std::shared_ptr<IConsoleLine> kept;
+	const auto pooledBegin = GetAllocationCounts();
+	for (size_t i = 0; i < 10000; i++)
+	{
+		auto line = ClientReachedServerSpawnLine::Create(timestamp);
+		if (i == 0)
+			kept = line->shared_from_this();
+	}
+	const auto pooled = GetAllocationCounts() - pooledBegin;
+
+	const auto unpooledBegin = GetAllocationCounts();
+	for (size_t i = 0; i < 10000; i++)
+	{
+		auto line = std::make_shared<ClientReachedServerSpawnLine>(timestamp);
+	}
+	const auto unpooled = GetAllocationCounts() - unpooledBegin;
+
+	CHECK(pooled.m_Count == 0);
+	CHECK(unpooled.m_Count == 10000);
+
+	REQUIRE(kept);
+	REQUIRE(kept->GetType() == ConsoleLineType::ClientReachedServerSpawn);
+	REQUIRE(kept->GetTimestamp() == timestamp);
+}
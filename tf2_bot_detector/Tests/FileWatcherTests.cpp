@@ -0,0 +1,73 @@
+#include "Platform/FileWatcher.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	void Append(const std::filesystem::path& path, const char* text)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::app);
+		file << text;
+	}
+
+	void CheckWatcher(IFileWatcher& watcher, const std::filesystem::path& path)
+	{
+		REQUIRE(watcher.GetPath() == path);
+		REQUIRE(!watcher.HasPendingChanges());
+		REQUIRE(watcher.ConsumeChanges() == FileChange::None);
+
+		// Appearing out of nowhere
+		Append(path, "first line\n");
+		REQUIRE(watcher.HasPendingChanges());
+		REQUIRE(watcher.ConsumeChanges() == FileChange::Replaced);
+		REQUIRE(watcher.ConsumeChanges() == FileChange::None);
+
+		// Growing
+		Append(path, "second line\n");
+		REQUIRE(watcher.HasPendingChanges());
+		REQUIRE(watcher.ConsumeChanges() == FileChange::Modified);
+		REQUIRE(!watcher.HasPendingChanges());
+
+		// Rotated away and recreated before we got a chance to look. Polling can only tell that
+		// the size changed, ConsoleLogParser rewinds if the file got shorter than our position.
+		std::filesystem::rename(path, std::filesystem::path(path) += ".old");
+		Append(path, "new file\n");
+		const auto rotated = watcher.ConsumeChanges();
+		if (watcher.IsEventDriven())
+			REQUIRE(rotated == FileChange::Replaced);
+		else
+			REQUIRE(rotated == FileChange::Modified);
+
+		// Deleted
+		std::filesystem::remove(path);
+		REQUIRE(watcher.ConsumeChanges() == FileChange::Replaced);
+		REQUIRE(watcher.ConsumeChanges() == FileChange::None);
+	}
+}
+
+TEST_CASE("tf2bd_filewatcher_polling", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_filewatcher_tests");
+	const auto path = dir / "console.log";
+
+	const auto watcher = IFileWatcher::CreatePolling(path);
+	REQUIRE(!watcher->IsEventDriven());
+	CheckWatcher(*watcher, path);
+}
+
+TEST_CASE("tf2bd_filewatcher_default", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_filewatcher_tests");
+	const auto path = dir / "console.log";
+
+	// Whatever this platform gives us has to behave the same as polling
+	const auto watcher = IFileWatcher::Create(path);
+	CheckWatcher(*watcher, path);
+}
@@ -0,0 +1,64 @@
+#include "FriendsGraph.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+using namespace tf2_bot_detector;
+
+TEST_CASE("tf2bd_friendsgraph_counts", "[tf2bd]")
+{
+	FriendsGraph graph;
+	graph.SetAllMarks({
+		{ MakeSteamID(1), PlayerAttribute::Cheater },
+		{ MakeSteamID(2), PlayerAttribute::Cheater | PlayerAttribute::Racist },
+		{ MakeSteamID(3), PlayerAttribute::Suspicious },
+		{ MakeSteamID(1), PlayerAttribute::Exploiter }, // same player, another list
+	});
+
+	graph.SetFriends(MakeSteamID(100), { MakeSteamID(1), MakeSteamID(2), MakeSteamID(4), MakeSteamID(5) });
+
+	const FriendsMarkCounts* counts = graph.GetMarkCounts(MakeSteamID(100));
+	REQUIRE(counts);
+	REQUIRE(counts->m_Friends == 4);
+	REQUIRE(counts->m_Marked == 2);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Cheater)] == 2);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Exploiter)] == 1);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Racist)] == 1);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Suspicious)] == 0);
+
+	// Marking a friend only touches the players that have them as a friend
+	graph.SetPlayerMarks(MakeSteamID(4), PlayerAttribute::Suspicious);
+	REQUIRE(counts->m_Marked == 3);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Suspicious)] == 1);
+
+	graph.SetPlayerMarks(MakeSteamID(2), PlayerAttribute::Racist);
+	REQUIRE(counts->m_Marked == 3);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Cheater)] == 1);
+
+	graph.SetPlayerMarks(MakeSteamID(1), {});
+	REQUIRE(counts->m_Marked == 2);
+	REQUIRE(counts->m_Attributes[size_t(PlayerAttribute::Exploiter)] == 0);
+
+	REQUIRE(!graph.GetMarkCounts(MakeSteamID(101)));
+}
+
+TEST_CASE("tf2bd_friendsgraph_clusters", "[tf2bd]")
+{
+	FriendsGraph graph;
+
+	// 1 - 2 - 3 are a chain, 4 - 5 are friends (but only 5's list is public), 6 is alone
+	graph.SetFriends(MakeSteamID(1), { MakeSteamID(2), MakeSteamID(50) });
+	graph.SetFriends(MakeSteamID(2), { MakeSteamID(1), MakeSteamID(3) });
+	graph.SetFriends(MakeSteamID(5), { MakeSteamID(4) });
+	graph.SetFriends(MakeSteamID(6), { MakeSteamID(51) });
+
+	REQUIRE(graph.AreFriends(MakeSteamID(4), MakeSteamID(5)));
+	REQUIRE(!graph.AreFriends(MakeSteamID(1), MakeSteamID(3)));
+
+	const auto clusters = graph.FindClusters({
+		MakeSteamID(1), MakeSteamID(2), MakeSteamID(3), MakeSteamID(4), MakeSteamID(5), MakeSteamID(6) });
+
+	REQUIRE(clusters.size() == 2);
+	REQUIRE(clusters[0].size() == 3);
+	REQUIRE(clusters[1].size() == 2);
+}
@@ -0,0 +1,239 @@
+#include "Networking/LogsTFAPI.h"
+#include "Networking/HTTPClient.h"
+#include "Networking/HTTPHelpers.h"
+#include "DB/TempDB.h"
+#include "GenericErrors.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::LogsTFAPI;
+
+namespace
+{
+	// Answers every logs.tf request straight away with the player's account ID as their log count
+	class StubHTTPClient final : public IHTTPClient
+	{
+	public:
+		std::string GetString(const URL& url) const override
+		{
+			const std::string str = url.ToString();
+			const auto pos = str.find("player=");
+			REQUIRE(pos != str.npos);
+
+			uint64_t id64{};
+			std::from_chars(str.data() + pos + 7, str.data() + str.size(), id64);
+
+			const SteamID id(id64);
+			m_Requested.push_back(id);
+			return mh::format(R"({{"success": true, "results": 0, "total": {}, "parameters": {{}}, "logs": []}})", id.ID);
+		}
+
+		mh::task<std::string> GetStringAsync(URL url) const override
+		{
+			co_return GetString(url);
+		}
+
+		RequestCounts GetRequestCounts() const override { return {}; }
+
+		mutable std::vector<SteamID> m_Requested;
+	};
+
+	// Only the logs.tf table. Gets called from the TempDB I/O thread.
+	class FakeTempDB final : public DB::ITempDB
+	{
+	public:
+		void Store(const DB::LogsTFCacheInfo& info) override
+		{
+			std::lock_guard lock(m_Mutex);
+			m_LogsTF.insert_or_assign(info.m_ID, info);
+		}
+		bool TryGet(DB::LogsTFCacheInfo& info) const override
+		{
+			std::lock_guard lock(m_Mutex);
+			auto found = m_LogsTF.find(info.m_ID);
+			if (found == m_LogsTF.end())
+				return false;
+
+			info = found->second;
+			return true;
+		}
+		std::optional<DB::LogsTFCacheInfo> Find(const SteamID& id) const
+		{
+			DB::LogsTFCacheInfo info{};
+			info.m_ID = id;
+			return TryGet(info) ? std::optional(info) : std::nullopt;
+		}
+
+		void Store(const DB::AccountAgeInfo&) override {}
+		bool TryGet(DB::AccountAgeInfo&) const override { return false; }
+		void GetNearestAccountAgeInfos(SteamID, std::optional<DB::AccountAgeInfo>&, std::optional<DB::AccountAgeInfo>&) const override {}
+		void Store(const DB::AccountInventorySizeInfo&) override {}
+		bool TryGet(DB::AccountInventorySizeInfo&) const override { return false; }
+		void Store(const DB::SourceBansCacheInfo&) override {}
+		bool TryGet(DB::SourceBansCacheInfo&) const override { return false; }
+		void Store(const std::vector<DB::SessionHistoryInfo>&) override {}
+		bool TryGet(DB::SessionHistoryInfo&) const override { return false; }
+		std::vector<DB::SessionHistoryInfo> GetSessionHistory(time_point_t, size_t) const override { return {}; }
+
+	private:
+		mutable std::mutex m_Mutex;
+		std::map<SteamID, DB::LogsTFCacheInfo> m_LogsTF;
+	};
+
+	struct Results
+	{
+		std::vector<std::pair<SteamID, mh::expected<PlayerLogsInfo>>> m_Results;
+
+		PlayerLogsQueue::ResultFunc GetFunc()
+		{
+			return [this](const SteamID& id, const mh::expected<PlayerLogsInfo>& result)
+			{
+				m_Results.emplace_back(id, result);
+			};
+		}
+	};
+}
+
+TEST_CASE("tf2bd_logstf_parse_total", "[tf2bd][logstf]")
+{
+	REQUIRE(ParseLogsTotal(R"({"success":true,"results":0,"total":1234,"parameters":{"player":"76561197960287930"},"logs":[]})") == 1234u);
+	REQUIRE(ParseLogsTotal(R"({ "success": true, "total" :
+		0, "logs": [] })") == 0u);
+
+	// "total" as a value shouldn't be mistaken for the key
+	REQUIRE(ParseLogsTotal(R"({"title":"total","total":7})") == 7u);
+
+	REQUIRE(!ParseLogsTotal(""));
+	REQUIRE(!ParseLogsTotal(R"({"success":false,"error":"Invalid player"})"));
+	REQUIRE(!ParseLogsTotal(R"({"total":"abc"})"));
+	REQUIRE(!ParseLogsTotal(R"({"total":)"));
+	REQUIRE(!ParseLogsTotal(R"({"total":99999999999})"));
+}
+
+TEST_CASE("tf2bd_logstf_queue_priority", "[tf2bd][logstf]")
+{
+	static_assert(PlayerLogsQueue::MAX_IN_FLIGHT == 2);
+
+	auto client = std::make_shared<StubHTTPClient>();
+	Results results;
+	PlayerLogsQueue queue(results.GetFunc());
+
+	REQUIRE(queue.GetNextUpdateTime() == time_point_t::max());
+
+	queue.Queue(MakeSteamID(1), RequestPriority::Background);
+	queue.Queue(MakeSteamID(2), RequestPriority::Background);
+	queue.Queue(MakeSteamID(3), RequestPriority::Background);
+	queue.Queue(MakeSteamID(4), RequestPriority::Visible);
+	queue.Queue(MakeSteamID(3), RequestPriority::Visible);   // Raised
+	queue.Queue(MakeSteamID(4), RequestPriority::Background); // Never lowered
+	queue.Queue(MakeSteamID(1), RequestPriority::Background); // Deduped
+
+	REQUIRE(queue.GetNextUpdateTime() <= tfbd_clock_t::now());
+
+	queue.Update(client, nullptr);
+	REQUIRE(client->m_Requested == std::vector{ MakeSteamID(3), MakeSteamID(4) });
+	REQUIRE(results.m_Results.empty());
+
+	// Already in flight
+	queue.Queue(MakeSteamID(3), RequestPriority::Visible);
+	REQUIRE(queue.IsQueued(MakeSteamID(3)));
+
+	queue.Update(client, nullptr);
+	REQUIRE(client->m_Requested.size() == 4);
+	REQUIRE(client->m_Requested[2] == MakeSteamID(1));
+	REQUIRE(client->m_Requested[3] == MakeSteamID(2));
+	REQUIRE(results.m_Results.size() == 2);
+
+	queue.Update(client, nullptr);
+	REQUIRE(client->m_Requested.size() == 4);
+	REQUIRE(results.m_Results.size() == 4);
+	REQUIRE(queue.GetNextUpdateTime() == time_point_t::max());
+
+	for (const auto& [id, result] : results.m_Results)
+	{
+		REQUIRE(!queue.IsQueued(id));
+		REQUIRE(result);
+		REQUIRE(result.value().m_ID == id);
+		REQUIRE(result.value().m_LogsCount == id.ID);
+	}
+}
+
+TEST_CASE("tf2bd_logstf_queue_no_internet", "[tf2bd][logstf]")
+{
+	Results results;
+	PlayerLogsQueue queue(results.GetFunc());
+
+	for (uint32_t i = 0; i < 5; i++)
+		queue.Queue(MakeSteamID(i), RequestPriority::Visible);
+
+	queue.Update(nullptr, nullptr);
+
+	REQUIRE(results.m_Results.size() == 5);
+	for (const auto& [id, result] : results.m_Results)
+	{
+		REQUIRE(!result);
+		REQUIRE(result.error() == ErrorCode::InternetConnectivityDisabled);
+	}
+
+	REQUIRE(queue.GetNextUpdateTime() == time_point_t::max());
+}
+
+TEST_CASE("tf2bd_logstf_queue_cache", "[tf2bd][logstf]")
+{
+	const auto MakeCacheInfo = [](uint32_t i, uint32_t logsCount, duration_t age)
+	{
+		DB::LogsTFCacheInfo info{};
+		info.m_ID = MakeSteamID(i);
+		info.m_LogsCount = logsCount;
+		info.m_LastCacheUpdateTime = tfbd_clock_t::now() - age;
+		return info;
+	};
+
+	FakeTempDB cache;
+	cache.Store(MakeCacheInfo(1, 111, 1h));        // Fresh
+	cache.Store(MakeCacheInfo(2, 222, 24h * 30));  // Expired
+
+	auto client = std::make_shared<StubHTTPClient>();
+	Results results;
+	PlayerLogsQueue queue(results.GetFunc());
+
+	for (uint32_t i = 1; i <= 3; i++)
+		queue.Queue(MakeSteamID(i), RequestPriority::Visible);
+
+	// The cache is read (and written) on another thread, so keep going until everything comes back
+	for (int i = 0; i < 5000 && queue.GetNextUpdateTime() != time_point_t::max(); i++)
+	{
+		queue.Update(client, &cache);
+		std::this_thread::sleep_for(1ms);
+	}
+
+	REQUIRE(queue.GetNextUpdateTime() == time_point_t::max());
+	REQUIRE(results.m_Results.size() == 3);
+
+	// Only the cache misses were requested
+	REQUIRE(client->m_Requested.size() == 2);
+	REQUIRE(std::find(client->m_Requested.begin(), client->m_Requested.end(), MakeSteamID(1)) == client->m_Requested.end());
+
+	for (const auto& [id, result] : results.m_Results)
+	{
+		REQUIRE(result);
+		REQUIRE(result.value().m_ID == id);
+		REQUIRE(result.value().m_LogsCount == (id == MakeSteamID(1) ? 111u : uint32_t(id.ID)));
+	}
+
+	// Fresh results went back into the cache
+	REQUIRE(cache.Find(MakeSteamID(1))->m_LogsCount == 111);
+	REQUIRE(cache.Find(MakeSteamID(2))->m_LogsCount == MakeSteamID(2).ID);
+	REQUIRE(cache.Find(MakeSteamID(3))->m_LogsCount == MakeSteamID(3).ID);
+	REQUIRE((tfbd_clock_t::now() - cache.Find(MakeSteamID(2))->m_LastCacheUpdateTime) < 1h);
+}
@@ -0,0 +1,75 @@
+#include "GameData/PlayerFetchScheduler.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	mh::task<> CompletedTask()
+	{
+		co_return;
+	}
+}
+
+TEST_CASE("tf2bd_player_fetch_scheduler", "[tf2bd]")
+{
+	std::unordered_map<SteamID, FetchPriority> priorities;
+	PlayerFetchScheduler scheduler(2, [&](const SteamID& id) -> std::optional<FetchPriority>
+		{
+			if (auto found = priorities.find(id); found != priorities.end())
+				return found->second;
+
+			return std::nullopt;
+		});
+
+	std::vector<SteamID> started;
+	std::vector<SteamID> cancelled;
+	const auto QueueFetch = [&](uint32_t i)
+	{
+		const SteamID id = MakeSteamID(i);
+		scheduler.Queue(id,
+			[&, id] { started.push_back(id); return CompletedTask(); },
+			[&, id] { cancelled.push_back(id); });
+	};
+
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		priorities[MakeSteamID(i)] = FetchPriority::Normal;
+		QueueFetch(i);
+	}
+
+	REQUIRE(scheduler.GetNextUpdateTime() <= tfbd_clock_t::now());
+	REQUIRE(scheduler.GetQueuedCount() == 6);
+
+	// Decided when a slot opens, not when queued
+	priorities[MakeSteamID(4)] = FetchPriority::Enemy;
+	priorities[MakeSteamID(3)] = FetchPriority::Hovered;
+	priorities.erase(MakeSteamID(0));  // Left the server
+
+	scheduler.Update();
+	REQUIRE(started == std::vector{ MakeSteamID(4), MakeSteamID(3) });
+	REQUIRE(cancelled == std::vector{ MakeSteamID(0) });
+	REQUIRE(scheduler.GetInFlightCount() == 2);
+	REQUIRE(scheduler.GetQueuedCount() == 3);
+
+	// Oldest first within the same priority
+	scheduler.Update();
+	REQUIRE(started.size() == 4);
+	REQUIRE(started[2] == MakeSteamID(1));
+	REQUIRE(started[3] == MakeSteamID(2));
+
+	scheduler.Update();
+	REQUIRE(started.size() == 5);
+	REQUIRE(started[4] == MakeSteamID(5));
+	REQUIRE(scheduler.GetQueuedCount() == 0);
+
+	scheduler.Update();
+	REQUIRE(scheduler.GetInFlightCount() == 0);
+	REQUIRE(scheduler.GetNextUpdateTime() == time_point_t::max());
+	REQUIRE(cancelled.size() == 1);
+}
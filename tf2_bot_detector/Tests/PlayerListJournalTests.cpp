@@ -0,0 +1,146 @@
+#include "Config/PlayerListJournal.h"
+#include "Config/PlayerListJSON.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	PlayerListData MakeData(uint32_t i, const PlayerAttributesList& attributes)
+	{
+		PlayerListData data(MakeSteamID(i));
+		data.m_SavedAttributes = attributes;
+		return data;
+	}
+
+	std::map<SteamID, PlayerAttributesList> ReplayAll(PlayerListJournal& journal, size_t& count)
+	{
+		std::map<SteamID, PlayerAttributesList> players;
+		count = journal.Replay([&](PlayerListData&& data)
+			{
+				players.insert_or_assign(data.GetSteamID(), data.m_SavedAttributes);
+			},
+			[&](const SteamID& id)
+			{
+				players.erase(id);
+			});
+
+		return players;
+	}
+}
+
+TEST_CASE("tf2bd_playerlist_journal_replay", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_playerlist_journal_tests");
+	const auto path = dir / "playerlist.journal";
+
+	{
+		PlayerListJournal journal(path);
+		journal.Append(MakeData(1, PlayerAttribute::Cheater));
+		journal.Append(MakeData(2, PlayerAttribute::Racist));
+		journal.Append(MakeData(1, {})); // unmarked
+		REQUIRE(journal.GetEntryCount() == 3);
+	}
+
+	PlayerListJournal journal(path);
+	size_t count = 0;
+	const auto players = ReplayAll(journal, count);
+
+	REQUIRE(count == 3);
+	REQUIRE(journal.GetEntryCount() == 3);
+	REQUIRE(players.at(MakeSteamID(1)).empty());
+	REQUIRE(players.at(MakeSteamID(2)) == PlayerAttributesList(PlayerAttribute::Racist));
+}
+
+TEST_CASE("tf2bd_playerlist_journal_removal", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_playerlist_journal_tests");
+	const auto path = dir / "playerlist.journal";
+
+	{
+		PlayerListJournal journal(path);
+		journal.Append(MakeData(1, PlayerAttribute::Cheater));
+		journal.Append(MakeData(2, PlayerAttribute::Racist));
+		journal.AppendRemoval(MakeSteamID(1));
+		journal.Rotate();
+
+		// Removed, then marked again
+		journal.AppendRemoval(MakeSteamID(2));
+		journal.Append(MakeData(2, PlayerAttribute::Exploiter));
+	}
+
+	PlayerListJournal journal(path);
+	size_t count = 0;
+	const auto players = ReplayAll(journal, count);
+
+	REQUIRE(count == 5);
+	REQUIRE(players.size() == 1);
+	REQUIRE(!players.contains(MakeSteamID(1)));
+	REQUIRE(players.at(MakeSteamID(2)) == PlayerAttributesList(PlayerAttribute::Exploiter));
+}
+
+TEST_CASE("tf2bd_playerlist_journal_rotate", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_playerlist_journal_tests");
+	const auto path = dir / "playerlist.journal";
+
+	PlayerListJournal journal(path);
+	journal.Append(MakeData(1, PlayerAttribute::Cheater));
+	journal.Rotate();
+
+	REQUIRE(journal.GetEntryCount() == 0);
+	REQUIRE(!std::filesystem::exists(path));
+	REQUIRE(std::filesystem::exists(journal.GetRotatedPath()));
+
+	// The rolled over entries are replayed first
+	journal.Append(MakeData(1, PlayerAttribute::Exploiter));
+
+	size_t count = 0;
+	auto players = ReplayAll(journal, count);
+	REQUIRE(count == 2);
+	REQUIRE(journal.GetEntryCount() == 1);
+	REQUIRE(players.at(MakeSteamID(1)) == PlayerAttributesList(PlayerAttribute::Exploiter));
+
+	// Rotating again before the rolled over journal is deleted (failed compaction) keeps both
+	journal.Append(MakeData(2, PlayerAttribute::Suspicious));
+	journal.Rotate();
+
+	players = ReplayAll(journal, count);
+	REQUIRE(count == 3);
+	REQUIRE(journal.GetEntryCount() == 0);
+	REQUIRE(players.at(MakeSteamID(1)) == PlayerAttributesList(PlayerAttribute::Exploiter));
+	REQUIRE(players.at(MakeSteamID(2)) == PlayerAttributesList(PlayerAttribute::Suspicious));
+}
+
+TEST_CASE("tf2bd_playerlist_journal_torn_write", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_playerlist_journal_tests");
+	const auto path = dir / "playerlist.journal";
+
+	{
+		PlayerListJournal journal(path);
+		journal.Append(MakeData(1, PlayerAttribute::Cheater));
+	}
+
+	// Crashed halfway through writing the second entry
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::app);
+		file << R"({"attributes":["cheater"],"steamid":"[U:1:10)";
+	}
+
+	PlayerListJournal journal(path);
+	journal.Append(MakeData(3, PlayerAttribute::Racist));
+
+	size_t count = 0;
+	const auto players = ReplayAll(journal, count);
+	REQUIRE(count == 2);
+	REQUIRE(players.size() == 2);
+	REQUIRE(players.at(MakeSteamID(1)) == PlayerAttributesList(PlayerAttribute::Cheater));
+	REQUIRE(players.at(MakeSteamID(3)) == PlayerAttributesList(PlayerAttribute::Racist));
+}
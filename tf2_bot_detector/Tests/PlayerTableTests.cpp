@@ -0,0 +1,176 @@
+#include "GameData/PlayerTable.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <any>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	constexpr size_t LOBBY_SIZE = 100;
+
+	// Roughly what m_CurrentPlayerData looked like before the table: every player is its own
+	// heap allocation, with the hot fields buried between the cold ones.
+	struct HeapPlayer
+	{
+		std::string m_Name;
+		std::string m_Address;
+		std::map<std::type_index, std::any> m_UserData;
+		TFTeam m_Team{};
+		PlayerStatusState m_State{};
+		uint16_t m_Ping{};
+		PlayerScores m_Scores{};
+		time_point_t m_LastStatusUpdateTime{};
+	};
+
+	void FillTable(PlayerTable& table)
+	{
+		const auto now = tfbd_clock_t::now();
+		for (size_t i = 0; i < LOBBY_SIZE; i++)
+		{
+			const auto index = table.Add(MakeSteamID(i), nullptr);
+			table.m_Teams[index] = (i % 2) ? TFTeam::Red : TFTeam::Blue;
+			table.m_States[index] = (i % 7) ? PlayerStatusState::Active : PlayerStatusState::Spawning;
+			table.m_Pings[index] = uint16_t(20 + (i * 37) % 150);
+			table.m_LastStatusUpdateTimes[index] = now - std::chrono::seconds((i * 13) % LOBBY_SIZE);
+		}
+	}
+
+	std::unordered_map<SteamID, std::shared_ptr<HeapPlayer>> MakeHeapPlayers()
+	{
+		std::unordered_map<SteamID, std::shared_ptr<HeapPlayer>> players;
+		const auto now = tfbd_clock_t::now();
+		for (size_t i = 0; i < LOBBY_SIZE; i++)
+		{
+			auto& player = players[MakeSteamID(i)] = std::make_shared<HeapPlayer>();
+			player->m_Name = "player " + std::to_string(i);
+			player->m_Team = (i % 2) ? TFTeam::Red : TFTeam::Blue;
+			player->m_State = (i % 7) ? PlayerStatusState::Active : PlayerStatusState::Spawning;
+			player->m_Ping = uint16_t(20 + (i * 37) % 150);
+			player->m_LastStatusUpdateTime = now - std::chrono::seconds((i * 13) % LOBBY_SIZE);
+		}
+
+		return players;
+	}
+}
+
+TEST_CASE("tf2bd_playertable_slots", "[tf2bd]")
+{
+	PlayerTable table;
+
+	const auto a = table.Add(MakeSteamID(0), nullptr);
+	const auto b = table.Add(MakeSteamID(1), nullptr);
+	REQUIRE(table.GetCurrentCount() == 2);
+
+	table.m_Pings[b] = 50;
+	table.Remove(a);
+	REQUIRE(table.GetCurrentCount() == 1);
+	REQUIRE(table.m_Pings[b] == 50); // other slots don't move
+
+	// freed slots get reused, and reset
+	table.m_Pings[a] = 123;
+	const auto c = table.Add(MakeSteamID(2), nullptr);
+	REQUIRE(c == a);
+	REQUIRE(table.m_Pings[c] == 0);
+	REQUIRE(table.m_SteamIDs[c] == MakeSteamID(2));
+
+	// detached players keep their data, but aren't current anymore
+	table.DetachAll();
+	REQUIRE(table.GetCurrentCount() == 0);
+	REQUIRE(!table.IsCurrent(b));
+	REQUIRE(table.m_Pings[b] == 50);
+	REQUIRE(table.GetRecentPlayers(32).empty());
+}
+
+TEST_CASE("tf2bd_playertable_remove_elsewhere", "[tf2bd]")
+{
+	PlayerTable table;
+	const auto a = table.Add(MakeSteamID(0), nullptr);
+	const auto b = table.Add(MakeSteamID(1), nullptr);
+
+	// The last reference to a dropped player went away on some other thread
+	table.Detach(a);
+	std::thread([&] { table.Remove(a); }).join();
+	REQUIRE(table.GetSlotCount() == 2);
+
+	// ...and the slot gets picked up on the next add
+	const auto c = table.Add(MakeSteamID(2), nullptr);
+	REQUIRE(c == a);
+	REQUIRE(table.IsCurrent(c));
+	REQUIRE(table.IsCurrent(b));
+	REQUIRE(table.GetCurrentCount() == 2);
+}
+
+TEST_CASE("tf2bd_playertable_recent", "[tf2bd]")
+{
+	PlayerTable table;
+	FillTable(table);
+	const auto recent = table.GetRecentPlayers(32);
+	REQUIRE(recent.size() == 32);
+
+	for (size_t i = 1; i < recent.size(); i++)
+		REQUIRE(table.m_LastStatusUpdateTimes[recent[i - 1]] >= table.m_LastStatusUpdateTimes[recent[i]]);
+}
+
+TEST_CASE("tf2bd_playertable_benchmark", "[tf2bd][!benchmark]")
+{
+	PlayerTable table;
+	FillTable(table);
+	const auto heapPlayers = MakeHeapPlayers();
+
+	BENCHMARK("recent players: table")
+	{
+		return table.GetRecentPlayers(32);
+	};
+
+	// Same algorithm as GetRecentPlayers(), so the only difference is the memory layout
+	BENCHMARK("recent players: heap")
+	{
+		std::vector<const HeapPlayer*> players;
+		players.reserve(heapPlayers.size());
+		for (const auto& [id, player] : heapPlayers)
+			players.push_back(player.get());
+
+		std::partial_sort(players.begin(), players.begin() + 32, players.end(), [](const HeapPlayer* a, const HeapPlayer* b)
+			{
+				return b->m_LastStatusUpdateTime < a->m_LastStatusUpdateTime;
+			});
+
+		players.resize(32);
+		return players;
+	};
+
+	BENCHMARK("active red ping: table")
+	{
+		uint32_t totalPing = 0;
+		table.ForEachCurrent([&](PlayerTable::index_t i)
+			{
+				if (table.m_Teams[i] == TFTeam::Red && table.m_States[i] == PlayerStatusState::Active)
+					totalPing += table.m_Pings[i];
+			});
+
+		return totalPing;
+	};
+
+	BENCHMARK("active red ping: heap")
+	{
+		uint32_t totalPing = 0;
+		for (const auto& [id, player] : heapPlayers)
+		{
+			if (player->m_Team == TFTeam::Red && player->m_State == PlayerStatusState::Active)
+				totalPing += player->m_Ping;
+		}
+
+		return totalPing;
+	};
+}
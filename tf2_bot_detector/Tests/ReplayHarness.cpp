@@ -0,0 +1,400 @@
+#include "ReplayHarness.h"
+#include "TestHelpers.h"
+#include "Actions/RCONActionManager.h"
+#include "Config/PlayerListJSON.h"
+#include "Config/Settings.h"
+#include "ConsoleLog/ConsoleLogParser.h"
+#include "DB/TempDB.h"
+#include "GameData/IPlayer.h"
+#include "Networking/HTTPClient.h"
+#include "Networking/HTTPHelpers.h"
+#include "GlobalDispatcher.h"
+#include "Log.h"
+#include "ModeratorLogic.h"
+#include "SteamID.h"
+#include "WorldEventListener.h"
+#include "WorldState.h"
+
+#include <mh/coroutine/task.hpp>
+#include <mh/text/format.hpp>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace std::chrono_literals;
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// "10/17/2020 - 20:00:05", the same way ConsoleLogParser reads them
+	constexpr size_t TIMESTAMP_LENGTH = 21;
+	std::optional<time_point_t> ParseTimestamp(const std::string_view& str)
+	{
+		if (str.size() < TIMESTAMP_LENGTH)
+			return std::nullopt;
+
+		std::tm time{};
+		time.tm_isdst = -1;
+		if (std::sscanf(std::string(str.substr(0, TIMESTAMP_LENGTH)).c_str(), "%d/%d/%d - %d:%d:%d",
+			&time.tm_mon, &time.tm_mday, &time.tm_year, &time.tm_hour, &time.tm_min, &time.tm_sec) != 6)
+		{
+			return std::nullopt;
+		}
+
+		time.tm_mon -= 1;
+		time.tm_year -= 1900;
+		return clock_t::from_time_t(std::mktime(&time));
+	}
+
+	class ReplayHTTPClient final : public IHTTPClient
+	{
+	public:
+		struct Response
+		{
+			std::string m_Host;
+			std::string m_Path; // prefix, so it doesn't have to match the query string
+			HTTPResponseCode m_Status = HTTPResponseCode::OK;
+			std::string m_Body;
+		};
+
+		explicit ReplayHTTPClient(std::vector<Response> responses) : m_Responses(std::move(responses)) {}
+
+		std::string GetString(const URL& url) const override
+		{
+			m_TotalCount++;
+
+			for (const auto& response : m_Responses)
+			{
+				if (url.m_Host != response.m_Host || !url.m_Path.starts_with(response.m_Path))
+					continue;
+
+				if (response.m_Status != HTTPResponseCode::OK)
+				{
+					m_FailedCount++;
+					throw http_error(response.m_Status, mh::format("Failed to HTTP GET {}", url));
+				}
+
+				return response.m_Body;
+			}
+
+			m_FailedCount++;
+			m_UnmatchedCount++;
+			throw http_error(HTTPResponseCode::NotFound, mh::format("No recorded response for {}", url));
+		}
+
+		mh::task<std::string> GetStringAsync(URL url) const override
+		{
+			co_return GetString(url);
+		}
+
+		RequestCounts GetRequestCounts() const override
+		{
+			return { m_TotalCount, m_FailedCount, 0, 0 };
+		}
+
+		uint32_t GetUnmatchedCount() const { return m_UnmatchedCount; }
+
+	private:
+		std::vector<Response> m_Responses;
+
+		// Requests come in from thread pool threads too
+		mutable std::atomic<uint32_t> m_TotalCount = 0;
+		mutable std::atomic<uint32_t> m_FailedCount = 0;
+		mutable std::atomic<uint32_t> m_UnmatchedCount = 0;
+	};
+
+	struct ReplaySession
+	{
+		SteamID m_LocalSteamID;
+
+		struct Mark
+		{
+			SteamID m_SteamID;
+			std::string m_Name;
+			std::vector<PlayerAttribute> m_Attributes;
+		};
+		std::vector<Mark> m_Marks;
+
+		struct RCONResponse
+		{
+			std::string m_Command;
+			std::vector<std::string> m_Lines;
+		};
+		std::multimap<time_point_t, RCONResponse> m_RCONResponses;
+
+		std::vector<ReplayHTTPClient::Response> m_HTTPResponses;
+	};
+
+	std::string ReadFile(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.good())
+			throw std::runtime_error(mh::format("Failed to open {}", path));
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+		return stream.str();
+	}
+
+	time_point_t GetTimestamp(const nlohmann::json& j)
+	{
+		if (auto time = ParseTimestamp(j.get<std::string_view>()))
+			return *time;
+
+		throw std::runtime_error(mh::format("Invalid timestamp {}", j.dump()));
+	}
+
+	ReplaySession LoadSession(const std::filesystem::path& sessionDir)
+	{
+		const auto json = nlohmann::json::parse(ReadFile(sessionDir / "session.json"));
+
+		ReplaySession session;
+		session.m_LocalSteamID = SteamID(json.at("local_steamid").get<std::string_view>());
+
+		if (auto found = json.find("marks"); found != json.end())
+		{
+			for (const auto& mark : *found)
+			{
+				session.m_Marks.push_back({
+					SteamID(mark.at("steamid").get<std::string_view>()),
+					mark.value("name", ""),
+					mark.at("attributes").get<std::vector<PlayerAttribute>>(),
+				});
+			}
+		}
+
+		if (auto found = json.find("rcon"); found != json.end())
+		{
+			for (const auto& response : *found)
+			{
+				session.m_RCONResponses.emplace(GetTimestamp(response.at("time")), ReplaySession::RCONResponse{
+					response.at("command").get<std::string>(),
+					response.at("response").get<std::vector<std::string>>(),
+				});
+			}
+		}
+
+		if (auto found = json.find("http"); found != json.end())
+		{
+			for (const auto& response : *found)
+			{
+				auto& entry = session.m_HTTPResponses.emplace_back();
+				entry.m_Host = response.at("host").get<std::string>();
+				entry.m_Path = response.at("path").get<std::string>();
+				entry.m_Status = HTTPResponseCode(response.value("status", int(HTTPResponseCode::OK)));
+
+				if (auto file = response.find("file"); file != response.end())
+					entry.m_Body = ReadFile(sessionDir / file->get<std::string_view>());
+			}
+		}
+
+		return session;
+	}
+
+	// Everything that happened within one second of the session
+	struct ReplayStep
+	{
+		std::string m_LogText;
+		size_t m_LogLineCount = 0;
+		std::vector<const ReplaySession::RCONResponse*> m_RCONResponses;
+	};
+
+	std::map<time_point_t, ReplayStep> LoadSteps(const std::filesystem::path& conLogFile, const ReplaySession& session)
+	{
+		std::map<time_point_t, ReplayStep> steps;
+
+		std::ifstream file(conLogFile, std::ios::binary);
+		if (!file.good())
+			throw std::runtime_error(mh::format("Failed to open {}", conLogFile));
+
+		ReplayStep* current = nullptr;
+		for (std::string line; std::getline(file, line); )
+		{
+			if (auto time = ParseTimestamp(line))
+				current = &steps[*time];
+
+			// Output from before the first timestamp has nothing to attach to
+			if (!current)
+				continue;
+
+			current->m_LogText.append(line).append("\n");
+			current->m_LogLineCount++;
+		}
+
+		for (const auto& [time, response] : session.m_RCONResponses)
+			steps[time].m_RCONResponses.push_back(&response);
+
+		return steps;
+	}
+
+	class ReplayObserver final : public AutoWorldEventListener
+	{
+	public:
+		using AutoWorldEventListener::AutoWorldEventListener;
+
+		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) override
+		{
+			m_FirstSeen.try_emplace(player.GetSteamID(), world.GetCurrentTime());
+
+			if (auto userID = player.GetUserID())
+				m_UserIDs[*userID] = player.GetSteamID();
+		}
+
+		std::unordered_map<SteamID, time_point_t> m_FirstSeen;
+		std::unordered_map<UserID_t, SteamID> m_UserIDs;
+	};
+
+	// Picks the userid back out of the command a KickAction would send
+	struct KickTargetWriter final : ICommandWriter
+	{
+		void Write(std::string cmd, std::string args) override
+		{
+			// callvote kick "<userid> <reason>"
+			constexpr auto PREFIX = "kick \""sv;
+			if (cmd != "callvote" || !args.starts_with(PREFIX))
+				return;
+
+			UserID_t userID{};
+			const auto begin = args.data() + PREFIX.size();
+			if (std::from_chars(begin, args.data() + args.size(), userID).ec == std::errc{})
+				m_UserID = userID;
+		}
+
+		std::optional<UserID_t> m_UserID;
+	};
+
+	struct VirtualTimeScope
+	{
+		explicit VirtualTimeScope(time_point_t time) { tfbd_clock_t::SetVirtualTime(time); }
+		~VirtualTimeScope() { tfbd_clock_t::ClearVirtualTime(); }
+	};
+}
+
+ReplayResults tf2_bot_detector::RunReplay(const std::filesystem::path& sessionDir)
+{
+	const ReplaySession session = LoadSession(sessionDir);
+	const auto steps = LoadSteps(sessionDir / "console.log", session);
+	if (steps.empty())
+		throw std::runtime_error(mh::format("{} has no timestamped lines", sessionDir / "console.log"));
+
+	// Settings, playerlists, rules, the TempDB and their journals all come from (and go to) rootDir
+	const TempTestDir rootDir("tf2bd_replay");
+	FilesystemRootScope filesystemRoot(rootDir.GetPath());
+	VirtualTimeScope virtualTime(steps.begin()->first);
+
+	auto httpClient = std::make_shared<ReplayHTTPClient>(session.m_HTTPResponses);
+
+	Settings settings;
+	settings.m_LocalSteamIDOverride = session.m_LocalSteamID;
+	settings.m_AllowInternetUsage = true;
+	settings.SetHTTPClient(httpClient);
+	settings.m_SteamAPIMode = SteamAPIMode::Direct;
+	settings.SetFakeSteamAPIKey(std::string(32, '0'));
+	settings.m_SaveConsoleLogs = false;
+	settings.m_SaveChatHistory = false;
+	settings.m_AutoVotekick = true;
+	settings.m_Unsaved.m_ChatMsgWrappers = ChatWrappers(ChatFmtStrLengths{});
+
+	const auto tempDB = DB::ITempDB::Create();
+	auto world = IWorldState::Create(settings, *tempDB);
+	RCONActionManager actionManager(settings, *world);
+	auto moderator = IModeratorLogic::Create(*world, settings, actionManager);
+	ReplayObserver observer(*world);
+
+	for (const auto& mark : session.m_Marks)
+	{
+		for (PlayerAttribute attribute : mark.m_Attributes)
+			moderator->SetPlayerAttribute(mark.m_SteamID, mark.m_Name, attribute, AttributePersistence::Transient);
+	}
+
+	ReplayResults results;
+	actionManager.SetActionQueuedFunc([&](const IAction& action)
+		{
+			results.m_ActionCounts.at(size_t(action.GetType()))++;
+
+			if (action.GetType() != ActionType::Kick)
+				return;
+
+			KickTargetWriter writer;
+			action.WriteCommands(writer);
+			if (!writer.m_UserID)
+				return;
+
+			if (auto id = observer.m_UserIDs.find(*writer.m_UserID); id != observer.m_UserIDs.end())
+			{
+				if (auto firstSeen = observer.m_FirstSeen.find(id->second); firstSeen != observer.m_FirstSeen.end())
+					results.m_VotekickLatencies.push_back(world->GetCurrentTime() - firstSeen->second);
+			}
+		});
+
+	// The parser truncates the file when it opens it, so start it off empty and then feed
+	// it the session a second at a time
+	const auto conLogFile = rootDir / "console.log";
+	std::ofstream conLog(conLogFile, std::ios::binary | std::ios::trunc);
+
+	ConsoleLogParser parser(*world, settings, conLogFile);
+	parser.Update();
+
+	// Every line needs a newline in front of its timestamp
+	conLog << '\n';
+
+	const auto allocationsBegin = GetAllocationCounts();
+	const auto wallTimeBegin = std::chrono::steady_clock::now();
+
+	std::vector<mh::task<>> pendingLines;
+	for (const auto& [time, step] : steps)
+	{
+		tfbd_clock_t::SetVirtualTime(time);
+
+		conLog << step.m_LogText << std::flush;
+		results.m_LineCount += step.m_LogLineCount;
+		parser.RequestRead();
+		parser.Update();
+
+		for (const auto* response : step.m_RCONResponses)
+		{
+			for (const auto& line : response->m_Lines)
+				pendingLines.push_back(world->AddConsoleOutputLine(line));
+
+			results.m_LineCount += response->m_Lines.size();
+		}
+
+		// rcon output gets parsed on another thread, wait for it to come back before moving on
+		const auto pumpBegin = std::chrono::steady_clock::now();
+		while (!pendingLines.empty())
+		{
+			GetDispatcher().run_for(1ms);
+			std::erase_if(pendingLines, [](mh::task<>& task) { return task.is_ready(); });
+
+			if ((std::chrono::steady_clock::now() - pumpBegin) > 10s)
+			{
+				LogError("Gave up waiting for {} rcon lines to be parsed", pendingLines.size());
+				pendingLines.clear();
+			}
+		}
+
+		world->Update();
+		moderator->Update();
+		actionManager.Update();
+
+		// Nothing on the other end to run them
+		actionManager.clearActions();
+	}
+
+	results.m_WallTime = std::chrono::steady_clock::now() - wallTimeBegin;
+	results.m_Allocations = GetAllocationCounts() - allocationsBegin;
+	results.m_HTTPRequests = httpClient->GetRequestCounts().m_Total;
+	results.m_UnmatchedHTTPRequests = httpClient->GetUnmatchedCount();
+
+	return results;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Actions/Actions.h"
+#include "Clock.h"
+#include "AllocationCounter.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	struct ReplayResults
+	{
+		// console.log lines plus rcon response lines
+		size_t m_LineCount = 0;
+		std::chrono::duration<double> m_WallTime{};
+		double GetLinesPerSecond() const { return m_LineCount / m_WallTime.count(); }
+
+		std::array<size_t, size_t(ActionType::COUNT)> m_ActionCounts{};
+		size_t GetActionCount(ActionType type) const { return m_ActionCounts.at(size_t(type)); }
+
+		// Session time between a player first showing up in status and a votekick on them being queued
+		std::vector<duration_t> m_VotekickLatencies;
+
+		uint32_t m_HTTPRequests = 0;
+		uint32_t m_UnmatchedHTTPRequests = 0;
+
+		AllocationCounts m_Allocations;
+	};
+
+	/// <summary>
+	/// Plays back a recorded session through ConsoleLogParser -> WorldState -> ModeratorLogic
+	/// -> RCONActionManager, as fast as it can be parsed. The directory has the console.log
+	/// from the session, and a session.json with the rcon responses and http responses to
+	/// play back alongside it. tfbd_clock_t follows the timestamps in the log for the
+	/// duration of the replay. Everything the replay loads or writes (settings, playerlists,
+	/// the console.log it feeds the parser) lives in a new temp directory.
+	/// </summary>
+	ReplayResults RunReplay(const std::filesystem::path& sessionDir);
+}
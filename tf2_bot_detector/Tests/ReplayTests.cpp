@@ -0,0 +1,52 @@
+#include "ReplayHarness.h"
+#include "Log.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <filesystem>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// A recorded 6v6 session: a marked cheater joins our team 20 seconds in.
+	std::filesystem::path GetSessionDir(const char* name)
+	{
+		return std::filesystem::path(TF2BD_TEST_DATA_DIR) / "Replay" / name;
+	}
+
+	void LogResults(const char* name, const ReplayResults& results)
+	{
+		const auto maxLatency = results.m_VotekickLatencies.empty() ? duration_t{} :
+			*std::max_element(results.m_VotekickLatencies.begin(), results.m_VotekickLatencies.end());
+
+		Log("[Replay] {}: {} lines in {:.1f}ms ({:.0f} lines/sec), {} kicks/{} chat msgs queued, "
+			"worst join->votekick {}s, {} allocations ({} bytes), {} http requests ({} unmatched)",
+			name, results.m_LineCount, to_seconds(results.m_WallTime) * 1000, results.GetLinesPerSecond(),
+			results.GetActionCount(ActionType::Kick), results.GetActionCount(ActionType::ChatMessage),
+			to_seconds(maxLatency), results.m_Allocations.m_Count, results.m_Allocations.m_Bytes,
+			results.m_HTTPRequests, results.m_UnmatchedHTTPRequests);
+	}
+}
+
+// Too slow to run on every debug startup, the TF2BD_ReplayTests ctest runs it
+TEST_CASE("tf2bd_replay_votekick", "[tf2bd][.replay]")
+{
+	const auto results = RunReplay(GetSessionDir("votekick"));
+	LogResults("votekick", results);
+
+	REQUIRE(results.m_LineCount > 0);
+	REQUIRE(!tfbd_clock_t::IsVirtualTime());
+
+	REQUIRE(results.GetActionCount(ActionType::Kick) >= 1);
+	REQUIRE(!results.m_VotekickLatencies.empty());
+	REQUIRE(results.m_VotekickLatencies.front() <= 15s);
+}
+
+TEST_CASE("tf2bd_replay_benchmark", "[tf2bd][!benchmark]")
+{
+	const auto sessionDir = GetSessionDir("votekick");
+	BENCHMARK("replay: votekick") { return RunReplay(sessionDir).m_LineCount; };
+}
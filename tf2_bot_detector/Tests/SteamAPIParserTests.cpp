@@ -0,0 +1,130 @@
+#include "Networking/SteamAPI.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::SteamAPI;
+
+namespace
+{
+	// Responses in the same shape as the real Steam Web API ones, with made up accounts.
+	std::string LoadCorpusFile(const char* fileName)
+	{
+		const auto path = std::filesystem::path(TF2BD_TEST_DATA_DIR) / "SteamAPI" / fileName;
+		std::ifstream file(path, std::ios::binary);
+		REQUIRE(file.good());
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+		return stream.str();
+	}
+
+	std::vector<PlayerSummary> ParsePlayerSummariesDOM(const std::string& data)
+	{
+		return nlohmann::json::parse(data).at("response").at("players").get<std::vector<PlayerSummary>>();
+	}
+
+	std::vector<PlayerBans> ParsePlayerBansDOM(const std::string& data)
+	{
+		return nlohmann::json::parse(data).at("players").get<std::vector<PlayerBans>>();
+	}
+
+	std::unordered_set<SteamID> ParseFriendListDOM(const std::string& data)
+	{
+		const auto json = nlohmann::json::parse(data);
+
+		std::unordered_set<SteamID> retVal;
+		for (const auto& friendEntry : json.at("friendslist").at("friends"))
+			retVal.insert(SteamID(friendEntry.at("steamid").get<std::string_view>()));
+
+		return retVal;
+	}
+}
+
+TEST_CASE("tf2bd_steamapi_parse_summaries", "[tf2bd]")
+{
+	const auto data = LoadCorpusFile("GetPlayerSummaries.json");
+	const auto expected = ParsePlayerSummariesDOM(data);
+	const auto actual = ParsePlayerSummaries(data);
+
+	REQUIRE(actual.size() == expected.size());
+	for (size_t i = 0; i < actual.size(); i++)
+	{
+		REQUIRE(actual[i].m_SteamID == expected[i].m_SteamID);
+		REQUIRE(actual[i].m_RealName == expected[i].m_RealName);
+		REQUIRE(actual[i].m_Nickname == expected[i].m_Nickname);
+		REQUIRE(actual[i].m_AvatarHash == expected[i].m_AvatarHash);
+		REQUIRE(actual[i].m_ProfileURL == expected[i].m_ProfileURL);
+		REQUIRE(actual[i].m_Status == expected[i].m_Status);
+		REQUIRE(actual[i].m_Visibility == expected[i].m_Visibility);
+		REQUIRE(actual[i].m_ProfileConfigured == expected[i].m_ProfileConfigured);
+		REQUIRE(actual[i].m_CommentPermissions == expected[i].m_CommentPermissions);
+		REQUIRE(actual[i].m_CreationTime == expected[i].m_CreationTime);
+		REQUIRE(actual[i].m_LastLogOff == expected[i].m_LastLogOff);
+	}
+}
+
+TEST_CASE("tf2bd_steamapi_parse_summaries_null_realname", "[tf2bd]")
+{
+	const auto summaries = ParsePlayerSummaries(R"({"response":{"players":[{"steamid":"76561197960287930",)"
+		R"("realname":null,"personaname":"Rabscuttle","personastate":1,"communityvisibilitystate":3,)"
+		R"("avatarhash":"fef49e7fa7e1997310d705b2a6158ff8dc1cdfeb","profileurl":"https://steamcommunity.com/id/rabscuttle/"}]}})");
+
+	REQUIRE(summaries.size() == 1);
+	REQUIRE(summaries[0].m_SteamID == SteamID("76561197960287930"));
+	REQUIRE(summaries[0].m_RealName.empty());
+	REQUIRE(summaries[0].m_Nickname == "Rabscuttle");
+}
+
+TEST_CASE("tf2bd_steamapi_parse_bans", "[tf2bd]")
+{
+	const auto data = LoadCorpusFile("GetPlayerBans.json");
+	const auto expected = ParsePlayerBansDOM(data);
+	const auto actual = ParsePlayerBans(data);
+
+	REQUIRE(actual.size() == expected.size());
+	for (size_t i = 0; i < actual.size(); i++)
+	{
+		REQUIRE(actual[i].m_SteamID == expected[i].m_SteamID);
+		REQUIRE(actual[i].m_CommunityBanned == expected[i].m_CommunityBanned);
+		REQUIRE(actual[i].m_EconomyBan == expected[i].m_EconomyBan);
+		REQUIRE(actual[i].m_VACBanCount == expected[i].m_VACBanCount);
+		REQUIRE(actual[i].m_GameBanCount == expected[i].m_GameBanCount);
+		REQUIRE(actual[i].m_TimeSinceLastBan == expected[i].m_TimeSinceLastBan);
+	}
+}
+
+TEST_CASE("tf2bd_steamapi_parse_friends", "[tf2bd]")
+{
+	const auto data = LoadCorpusFile("GetFriendList.json");
+	REQUIRE(ParseFriendList(data) == ParseFriendListDOM(data));
+}
+
+TEST_CASE("tf2bd_steamapi_parse_errors", "[tf2bd]")
+{
+	REQUIRE_THROWS_AS(ParsePlayerBans(R"({"players":[)"), SteamAPIError);
+	REQUIRE_THROWS_AS(ParsePlayerBans(R"({"something_else":[]})"), SteamAPIError);
+	REQUIRE_THROWS_AS(ParsePlayerBans(R"({"players":[{"SteamId":"76561197960287930"}]})"), SteamAPIError);
+	REQUIRE_THROWS_AS(ParseFriendList(R"({"friendslist":{"friends":[{"steamid":"not a steamid"}]}})"), SteamAPIError);
+	REQUIRE(ParsePlayerSummaries(R"({"response":{"players":[]}})").empty());
+}
+
+TEST_CASE("tf2bd_steamapi_parse_benchmark", "[tf2bd][!benchmark]")
+{
+	const auto summaries = LoadCorpusFile("GetPlayerSummaries.json");
+	const auto bans = LoadCorpusFile("GetPlayerBans.json");
+	const auto friends = LoadCorpusFile("GetFriendList.json");
+
+	BENCHMARK("summaries: dom") { return ParsePlayerSummariesDOM(summaries); };
+	BENCHMARK("summaries: streaming") { return ParsePlayerSummaries(summaries); };
+	BENCHMARK("bans: dom") { return ParsePlayerBansDOM(bans); };
+	BENCHMARK("bans: streaming") { return ParsePlayerBans(bans); };
+	BENCHMARK("friends: dom") { return ParseFriendListDOM(friends); };
+	BENCHMARK("friends: streaming") { return ParseFriendList(friends); };
+}
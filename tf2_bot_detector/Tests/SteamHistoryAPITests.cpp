@@ -0,0 +1,168 @@
+#include "DB/TempDB.h"
+#include "Networking/SteamHistoryAPI.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::SteamHistoryAPI;
+
+namespace
+{
+	PlayerSourceBan MakeBan(const SteamID& id)
+	{
+		PlayerSourceBan ban{};
+		ban.m_ID = id;
+		ban.m_BanState = BanState::Permanent;
+		ban.m_BanReason = "Cheating";
+		ban.m_BanTimestamp = time_point_t(1600000000s);
+		ban.m_Server = "Some Community";
+		return ban;
+	}
+}
+
+TEST_CASE("tf2bd_sourcebans_cache_roundtrip", "[tf2bd]")
+{
+	// TempDB stores bans with to_json and reads them back with the same from_json as the API response
+	PlayerSourceBan ban{};
+	ban.m_ID = SteamID(1234, SteamAccountType::Individual);
+	ban.m_BanState = BanState::Current;
+	ban.m_UserName = "some guy";
+	ban.m_BanReason = "Cheating";
+	ban.m_BanTimestamp = time_point_t(1600000000s);
+	ban.m_UnbanTimestamp = time_point_t(1700000000s);
+	ban.m_Server = "Some Community";
+
+	PlayerSourceBan unbanned = ban;
+	unbanned.m_BanState = BanState::Unbanned;
+	unbanned.m_UnbanReason = "Appealed";
+	unbanned.m_Server = "Another Community";
+
+	const PlayerSourceBans bans{ ban, unbanned };
+	const auto parsed = nlohmann::json::parse(nlohmann::json(bans).dump()).get<PlayerSourceBans>();
+
+	REQUIRE(parsed.size() == 2);
+	for (size_t i = 0; i < bans.size(); i++)
+	{
+		REQUIRE(parsed[i].m_ID == bans[i].m_ID);
+		REQUIRE(parsed[i].m_BanState == bans[i].m_BanState);
+		REQUIRE(parsed[i].m_UserName == bans[i].m_UserName);
+		REQUIRE(parsed[i].m_BanReason == bans[i].m_BanReason);
+		REQUIRE(parsed[i].m_UnbanReason == bans[i].m_UnbanReason);
+		REQUIRE(parsed[i].m_BanTimestamp == bans[i].m_BanTimestamp);
+		REQUIRE(parsed[i].m_UnbanTimestamp == bans[i].m_UnbanTimestamp);
+		REQUIRE(parsed[i].m_Server == bans[i].m_Server);
+	}
+
+	// No bans is cached too
+	REQUIRE(nlohmann::json::parse(nlohmann::json(PlayerSourceBans{}).dump()).get<PlayerSourceBans>().empty());
+}
+
+TEST_CASE("tf2bd_sourcebans_parse_result", "[tf2bd]")
+{
+	const SteamID banned = MakeSteamID(1);
+
+	nlohmann::json json;
+	json["response"][std::to_string(banned.ID64)] = PlayerSourceBans{ MakeBan(banned) };
+
+	{
+		const auto result = ParsePlayerSourceBansResult(json.dump());
+		REQUIRE(result.m_IsComplete);
+		REQUIRE(result.m_Bans.size() == 1);
+		REQUIRE(result.m_Bans.at(banned).size() == 1);
+	}
+
+	// Nobody has bans
+	REQUIRE(ParsePlayerSourceBansResult(R"({"response":{}})").m_IsComplete);
+
+	// One bad entry doesn't throw away the rest, but we can't tell who it was for
+	json["response"][std::to_string(MakeSteamID(2).ID64)] = nlohmann::json::array({ { { "SteamID", "garbage" } } });
+	{
+		const auto result = ParsePlayerSourceBansResult(json.dump());
+		REQUIRE(!result.m_IsComplete);
+		REQUIRE(result.m_Bans.size() == 1);
+		REQUIRE(result.m_Bans.contains(banned));
+	}
+
+	// Nothing usable at all, so nobody gets marked clean and the batch is retried
+	REQUIRE_THROWS(ParsePlayerSourceBansResult("<html>502 Bad Gateway</html>"));
+	REQUIRE_THROWS(ParsePlayerSourceBansResult(R"({"error":"invalid key"})"));
+
+	nlohmann::json onlyGarbage;
+	onlyGarbage["response"][std::to_string(MakeSteamID(2).ID64)] = nlohmann::json::array({ { { "SteamID", "garbage" } } });
+	REQUIRE_THROWS(ParsePlayerSourceBansResult(onlyGarbage.dump()));
+}
+
+TEST_CASE("tf2bd_sourcebans_cache_state", "[tf2bd]")
+{
+	const auto now = tfbd_clock_t::now();
+
+	DB::SourceBansCacheInfo info{};
+	info.m_SteamID = MakeSteamID(1);
+
+	const auto stateAt = [&](duration_t age)
+	{
+		info.m_LastCacheUpdateTime = now - age;
+		return info.GetCacheState(now);
+	};
+
+	// No bans, checked again after a day
+	REQUIRE(stateAt(0s) == DB::SourceBansCacheState::Fresh);
+	REQUIRE(stateAt(day_t(1)) == DB::SourceBansCacheState::Fresh);
+	REQUIRE(stateAt(day_t(1) + 1s) == DB::SourceBansCacheState::Stale);
+
+	// Known bans, checked again after three days
+	info.m_Bans.push_back(MakeBan(info.m_SteamID));
+	REQUIRE(stateAt(day_t(3)) == DB::SourceBansCacheState::Fresh);
+	REQUIRE(stateAt(day_t(3) + 1s) == DB::SourceBansCacheState::Stale);
+
+	// Either way, not shown at all after 30 days
+	REQUIRE(stateAt(day_t(30)) == DB::SourceBansCacheState::Stale);
+	REQUIRE(stateAt(day_t(30) + 1s) == DB::SourceBansCacheState::Expired);
+	info.m_Bans.clear();
+	REQUIRE(stateAt(day_t(30)) == DB::SourceBansCacheState::Stale);
+	REQUIRE(stateAt(day_t(30) + 1s) == DB::SourceBansCacheState::Expired);
+}
+
+TEST_CASE("tf2bd_sourcebans_negative_cache", "[tf2bd]")
+{
+	const auto now = tfbd_clock_t::now();
+	const SteamID banned = MakeSteamID(1);
+	const SteamID clean = MakeSteamID(2);
+	const SteamID group(3, SteamAccountType::Clan);
+	const std::vector<SteamID> requested{ banned, clean, group };
+
+	PlayerSourceBansResult result;
+	result.m_Bans[banned] = { MakeBan(banned) };
+
+	const auto findInfo = [](const std::vector<DB::SourceBansCacheInfo>& infos, const SteamID& id)
+	{
+		return std::find_if(infos.begin(), infos.end(), [&](const auto& info) { return info.GetSteamID() == id; });
+	};
+
+	// Complete response, anyone missing has no bans
+	result.m_IsComplete = true;
+	{
+		const auto infos = DB::SourceBansCacheInfo::FromResult(requested, result, now);
+		REQUIRE(infos.size() == 2);
+		REQUIRE(findInfo(infos, banned)->m_Bans.size() == 1);
+		REQUIRE(findInfo(infos, clean)->m_Bans.empty());
+		REQUIRE(findInfo(infos, clean)->m_LastCacheUpdateTime == now);
+		REQUIRE(findInfo(infos, group) == infos.end());
+	}
+
+	// Incomplete response, missing might just mean it didn't parse
+	result.m_IsComplete = false;
+	{
+		const auto infos = DB::SourceBansCacheInfo::FromResult(requested, result, now);
+		REQUIRE(infos.size() == 1);
+		REQUIRE(findInfo(infos, banned) != infos.end());
+		REQUIRE(findInfo(infos, clean) == infos.end());
+	}
+}
@@ -0,0 +1,245 @@
+#include "SteamID.h"
+#include "Util/RegexUtils.h"
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+// Only the bitfield members can be read in constant expressions
+static_assert(TryParseSteamID3("[U:1:1234]")->ID == 1234);
+static_assert(TryParseSteamID3("[U:1:1234]")->Type == SteamAccountType::Individual);
+static_assert(TryParseSteamID3("[U:1:1234]")->Universe == SteamAccountUniverse::Public);
+static_assert(TryParseSteamID3("[U:1:1234]")->Instance == SteamAccountInstance::Desktop);
+static_assert(TryParseSteamID3("[g:1:99:4]")->Type == SteamAccountType::Clan);
+static_assert(TryParseSteamID3("[g:1:99:4]")->Instance == SteamAccountInstance::Web);
+static_assert(TryParseSteamID3("[I:0:0]")->ID64 == 0);
+static_assert(!TryParseSteamID3("[U:1:]"));
+static_assert(!TryParseSteamID3("[U:12:1]"));
+static_assert(!TryParseSteamID3("[U:1:1:]"));
+static_assert(!TryParseSteamID3("U:1:1"));
+static_assert(!TryParseSteamID3("76561198003911389"));
+
+static_assert(TryParseSteamID64("76561198003911389")->ID64 == 76561198003911389);
+static_assert(TryParseSteamID64(" 76561198003911389\n")->ID64 == 76561198003911389);
+static_assert(!TryParseSteamID64(""));
+static_assert(!TryParseSteamID64("7656119800391138x"));
+
+static_assert(TryParseSteamID2("STEAM_0:1:21822830")->ID == 43645661);
+static_assert(TryParseSteamID2("STEAM_0:1:21822830")->Universe == SteamAccountUniverse::Public);
+static_assert(TryParseSteamID2("STEAM_1:0:5")->ID == 10);
+static_assert(!TryParseSteamID2("STEAM_0:2:5"));
+static_assert(!TryParseSteamID2("STEAM_0:1:"));
+
+namespace
+{
+	// What SteamID(string_view) used to do for Steam3 IDs, before TryParseSteamID3
+	std::optional<SteamID> ParseSteamID3Regex(const std::string_view& str)
+	{
+		static const std::regex s_SteamID3Regex(R"regex(\[([a-zA-Z]):(\d):(\d+)(?::(\d+))?\])regex", std::regex::optimize);
+
+		svmatch result;
+		if (!std::regex_match(str.begin(), str.end(), result, s_SteamID3Regex))
+			return std::nullopt;
+
+		SteamAccountType type{};
+		switch (*result[1].first)
+		{
+		case 'U': type = SteamAccountType::Individual; break;
+		case 'M': type = SteamAccountType::Multiseat; break;
+		case 'G': type = SteamAccountType::GameServer; break;
+		case 'A': type = SteamAccountType::AnonGameServer; break;
+		case 'P': type = SteamAccountType::Pending; break;
+		case 'C': type = SteamAccountType::ContentServer; break;
+		case 'g': type = SteamAccountType::Clan; break;
+		case 'a': type = SteamAccountType::AnonUser; break;
+		case 'T':
+		case 'L':
+		case 'c':
+			type = SteamAccountType::Chat; break;
+		case 'I':
+			return SteamID{};
+		default:
+			throw std::invalid_argument("Unknown SteamAccountType");
+		}
+
+		uint32_t universe;
+		from_chars_throw(result[2], universe);
+
+		uint32_t id;
+		from_chars_throw(result[3], id);
+
+		uint32_t instance = uint32_t(SteamAccountInstance::Desktop);
+		if (result[4].matched)
+			from_chars_throw(result[4], instance);
+
+		return SteamID(id, type, SteamAccountUniverse(universe), SteamAccountInstance(instance));
+	}
+
+	// What SteamID::str() used to do, for individual accounts
+	std::string FormatSteamIDStream(const SteamID& id)
+	{
+		std::ostringstream stream;
+		stream << '[' << "U" << ':' << static_cast<int>(id.Universe) << ':' << id.ID << ']';
+		return stream.str();
+	}
+
+	std::vector<SteamID> MakeSteamIDs(size_t count)
+	{
+		std::mt19937 random(91011);
+		std::vector<SteamID> retVal;
+		for (size_t i = 0; i < count; i++)
+			retVal.push_back(SteamID(uint32_t(random()), SteamAccountType::Individual));
+
+		return retVal;
+	}
+}
+
+TEST_CASE("tf2bd_steamid_format", "[tf2bd]")
+{
+	CHECK(SteamID(1118537734, SteamAccountType::Individual).str() == "[U:1:1118537734]");
+	CHECK(SteamID(99, SteamAccountType::Clan, SteamAccountUniverse::Public, SteamAccountInstance::Web).str() == "[g:1:99]");
+	CHECK(SteamID().str() == "[I:0:0]");
+	CHECK(SteamID(UINT32_MAX, SteamAccountType::P2PSuperSeeder, SteamAccountUniverse(255)).str().size() == STEAMID3_MAX_LENGTH);
+
+	std::ostringstream stream;
+	stream << SteamID(76561198003911389);
+	CHECK(stream.str() == "[U:1:43645661]");
+
+	char buf[8];
+	CHECK(to_chars(buf, buf + sizeof(buf), SteamID(1118537734, SteamAccountType::Individual)).ec == std::errc::value_too_large);
+
+	for (const SteamID& id : MakeSteamIDs(1000))
+	{
+		REQUIRE(id.str() == FormatSteamIDStream(id));
+		REQUIRE(SteamID(id.str()) == id);
+	}
+}
+
+TEST_CASE("tf2bd_steamid_bulk", "[tf2bd]")
+{
+	const std::vector<SteamID> ids(3, SteamID(76561198003911389));
+
+	std::string str = "?steamids=";
+	AppendSteamID64s(str, ids);
+	CHECK(str == "?steamids=76561198003911389,76561198003911389,76561198003911389");
+
+	str.clear();
+	AppendSteamID64s(str, std::span<const SteamID>{});
+	CHECK(str.empty());
+}
+
+TEST_CASE("tf2bd_steamid3_fuzz", "[tf2bd]")
+{
+	constexpr std::string_view SEEDS[] = { "[U:1:1118537734]", "[g:1:99:5]", "[A:1:2:3]", "[I:0:0]" };
+	constexpr std::string_view ALPHABET = "[]:UIgaAQz0123456789";
+
+	std::mt19937 random(5678);
+	for (size_t i = 0; i < 20000; i++)
+	{
+		std::string str(SEEDS[random() % std::size(SEEDS)]);
+		for (size_t mutations = 1 + random() % 3; mutations > 0 && !str.empty(); mutations--)
+		{
+			const size_t pos = random() % str.size();
+			const char c = ALPHABET[random() % ALPHABET.size()];
+			switch (random() % 3)
+			{
+			case 0: str.insert(str.begin() + pos, c); break;
+			case 1: str.erase(pos, 1); break;
+			case 2: str[pos] = c; break;
+			}
+		}
+
+		CAPTURE(str);
+
+		std::optional<SteamID> expected;
+		bool expectedThrew = false;
+		try
+		{
+			expected = ParseSteamID3Regex(str);
+		}
+		catch (...)
+		{
+			expectedThrew = true;
+		}
+
+		std::optional<SteamID> parsed;
+		bool threw = false;
+		try
+		{
+			parsed = TryParseSteamID3(str);
+		}
+		catch (...)
+		{
+			threw = true;
+		}
+
+		REQUIRE(threw == expectedThrew);
+		REQUIRE(parsed == expected);
+	}
+}
+
+// Run with --run-tests "[!benchmark]" (the tf2bd_benchmarks target does this)
+TEST_CASE("tf2bd_steamid_benchmark", "[tf2bd][!benchmark]")
+{
+	const auto ids = MakeSteamIDs(1000);
+
+	std::vector<std::string> strs;
+	for (const SteamID& id : ids)
+		strs.push_back(id.str());
+
+	BENCHMARK("parse: regex")
+	{
+		size_t count = 0;
+		for (const auto& str : strs)
+			count += ParseSteamID3Regex(str).has_value();
+
+		return count;
+	};
+	BENCHMARK("parse: TryParseSteamID3")
+	{
+		size_t count = 0;
+		for (const auto& str : strs)
+			count += TryParseSteamID3(str).has_value();
+
+		return count;
+	};
+
+	BENCHMARK("format: stream")
+	{
+		size_t length = 0;
+		for (const SteamID& id : ids)
+			length += FormatSteamIDStream(id).size();
+
+		return length;
+	};
+	BENCHMARK("format: str()")
+	{
+		size_t length = 0;
+		for (const SteamID& id : ids)
+			length += id.str().size();
+
+		return length;
+	};
+
+	BENCHMARK("steamids: stream")
+	{
+		std::ostringstream stream;
+		for (size_t i = 0; i < ids.size(); i++)
+			stream << (i ? "," : "") << ids[i].ID64;
+
+		return stream.str();
+	};
+	BENCHMARK("steamids: AppendSteamID64s")
+	{
+		std::string str;
+		AppendSteamID64s(str, ids);
+		return str;
+	};
+}
@@ -0,0 +1,81 @@
+#include "DB/TempDB.h"
+#include "TestHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <optional>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	DB::SessionHistoryInfo MakeInfo(const SteamID& id, time_point_t firstSeen, time_point_t lastSeen)
+	{
+		DB::SessionHistoryInfo info{};
+		info.m_SteamID = id;
+		info.m_Name = "player";
+		info.m_FirstSeen = firstSeen;
+		info.m_LastSeen = lastSeen;
+		return info;
+	}
+
+	std::optional<DB::SessionHistoryInfo> Find(const DB::ITempDB& db, const SteamID& id)
+	{
+		DB::SessionHistoryInfo info{};
+		info.m_SteamID = id;
+		return db.TryGet(info) ? std::optional(info) : std::nullopt;
+	}
+}
+
+TEST_CASE("tf2bd_tempdb_session_history", "[tf2bd]")
+{
+	const TempTestDir dir("tf2bd_tempdb_tests");
+	const auto db = DB::ITempDB::Create(dir / "tf2bd_temp_db.sqlite");
+
+	// Stored with second precision
+	const time_point_t now(std::chrono::duration_cast<std::chrono::seconds>(tfbd_clock_t::now().time_since_epoch()));
+	const SteamID regular = MakeSteamID(1);
+	const SteamID oldPlayer = MakeSteamID(2);
+	const SteamID recentPlayer = MakeSteamID(3);
+
+	{
+		auto info = MakeInfo(regular, now - 2h, now - 1h);
+		info.m_Kills = 70000;
+		info.m_Deaths = 100000;
+		db->Store({ info });
+	}
+	{
+		const auto found = Find(*db, regular);
+		REQUIRE(found);
+		CHECK(found->m_FirstSeen == now - 2h);
+		CHECK(found->m_LastSeen == now - 1h);
+		CHECK(found->m_Kills == 70000);
+		CHECK(found->m_Deaths == 100000);
+	}
+
+	// Evicted again later, but we still first saw them in the earlier session
+	db->Store({ MakeInfo(regular, now - 30min, now) });
+	{
+		const auto found = Find(*db, regular);
+		REQUIRE(found);
+		CHECK(found->m_FirstSeen == now - 2h);
+		CHECK(found->m_LastSeen == now);
+		CHECK(found->m_Kills == 0);
+	}
+
+	// Anything older than GetMaxAge() goes away
+	db->Store({
+		MakeInfo(oldPlayer, now - DB::SessionHistoryInfo::GetMaxAge() - 2h, now - DB::SessionHistoryInfo::GetMaxAge() - 1h),
+		MakeInfo(recentPlayer, now - DB::SessionHistoryInfo::GetMaxAge() + 1h, now - DB::SessionHistoryInfo::GetMaxAge() + 2h),
+		});
+	CHECK(!Find(*db, oldPlayer));
+	CHECK(Find(*db, recentPlayer));
+	CHECK(Find(*db, regular));
+
+	const auto history = db->GetSessionHistory(time_point_t{}, 10);
+	REQUIRE(history.size() == 2);
+	CHECK(history[0].GetSteamID() == regular);
+	CHECK(history[1].GetSteamID() == recentPlayer);
+}
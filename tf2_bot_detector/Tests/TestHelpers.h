@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Filesystem.h"
+#include "Platform/Platform.h"
+#include "SteamID.h"
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace tf2_bot_detector
+{
+	// A made up individual account, different for every i
+	inline SteamID MakeSteamID(uint32_t i)
+	{
+		return SteamID(1000 + i, SteamAccountType::Individual);
+	}
+
+	/// <summary>
+	/// A new, empty directory under the system temp directory, unique to this process and
+	/// instance so overlapping test runs can't see each other's files. Deleted again when
+	/// this goes out of scope.
+	/// </summary>
+	class TempTestDir final
+	{
+	public:
+		explicit TempTestDir(const std::string_view& name)
+		{
+			static std::atomic<uint32_t> s_Counter = 0;
+
+			m_Path = std::filesystem::temp_directory_path() / (std::string(name) + '_' +
+				std::to_string(Processes::GetCurrentProcessID()) + '_' + std::to_string(s_Counter++));
+
+			std::filesystem::remove_all(m_Path);
+			std::filesystem::create_directories(m_Path);
+		}
+		~TempTestDir()
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_Path, ec);
+		}
+
+		TempTestDir(const TempTestDir&) = delete;
+		TempTestDir& operator=(const TempTestDir&) = delete;
+
+		const std::filesystem::path& GetPath() const { return m_Path; }
+		std::filesystem::path operator/(const std::filesystem::path& child) const { return m_Path / child; }
+
+	private:
+		std::filesystem::path m_Path;
+	};
+
+	// Everything IFilesystem reads and writes goes under root instead of the user's folders
+	struct FilesystemRootScope final
+	{
+		explicit FilesystemRootScope(const std::filesystem::path& root) { IFilesystem::Get().SetRootOverride(root); }
+		~FilesystemRootScope() { IFilesystem::Get().SetRootOverride({}); }
+
+		FilesystemRootScope(const FilesystemRootScope&) = delete;
+		FilesystemRootScope& operator=(const FilesystemRootScope&) = delete;
+	};
+}
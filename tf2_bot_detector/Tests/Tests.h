@@ -3,6 +3,7 @@
 #ifdef TF2BD_ENABLE_TESTS
 namespace tf2_bot_detector
 {
-	int RunTests();
+	// argv[0] is ignored, like a program name
+	int RunTests(int argc = 0, const char* const* argv = nullptr);
 }
 #endif
@@ -0,0 +1,108 @@
+#include "Config/Settings.h"
+#include "DB/TempDB.h"
+#include "Networking/HTTPClient.h"
+#include "Networking/HTTPHelpers.h"
+#include "GlobalDispatcher.h"
+#include "TestHelpers.h"
+#include "WorldState.h"
+
+#include <catch2/catch.hpp>
+#include <mh/coroutine/task.hpp>
+#include <mh/text/format.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// Fails every request, we only care which ones were made
+	class RecordingHTTPClient final : public IHTTPClient
+	{
+	public:
+		std::string GetString(const URL& url) const override
+		{
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Requested.push_back(url.ToString());
+			}
+			throw http_error(HTTPResponseCode::NotFound, "Not on the network");
+		}
+		mh::task<std::string> GetStringAsync(URL url) const override
+		{
+			co_return GetString(url);
+		}
+
+		RequestCounts GetRequestCounts() const override { return {}; }
+
+		size_t CountRequests(const std::string_view& path) const
+		{
+			std::lock_guard lock(m_Mutex);
+			return std::count_if(m_Requested.begin(), m_Requested.end(),
+				[&](const std::string& url) { return url.find(path) != url.npos; });
+		}
+
+	private:
+		mutable std::mutex m_Mutex;
+		mutable std::vector<std::string> m_Requested;
+	};
+}
+
+TEST_CASE("tf2bd_worldstate_lobby_prefetch", "[tf2bd]")
+{
+	const TempTestDir rootDir("tf2bd_worldstate_tests");
+	FilesystemRootScope filesystemRoot(rootDir.GetPath());
+
+	auto httpClient = std::make_shared<RecordingHTTPClient>();
+
+	// Nothing that isn't batched should be fetched up front
+	Settings settings;
+	settings.m_AllowInternetUsage = true;
+	settings.SetHTTPClient(httpClient);
+	settings.m_SteamAPIMode = SteamAPIMode::Direct;
+	settings.SetFakeSteamAPIKey(std::string(32, '0'));
+	settings.m_LazyLoadAPIData = true;
+
+	const auto tempDB = DB::ITempDB::Create(rootDir / "tf2bd_temp_db.sqlite");
+	auto world = IWorldState::Create(settings, *tempDB);
+
+	std::vector<mh::task<>> pendingLines;
+	for (uint32_t i = 0; i < 12; i++)
+	{
+		pendingLines.push_back(world->AddConsoleOutputLine(mh::format("  Member[{}] {}  team = {}  type = MATCH_PLAYER",
+			i, MakeSteamID(i), (i % 2) ? "TF_GC_TEAM_INVADERS" : "TF_GC_TEAM_DEFENDERS")));
+	}
+
+	while (!pendingLines.empty())
+	{
+		GetDispatcher().run_for(1ms);
+		std::erase_if(pendingLines, [](mh::task<>& task) { return task.is_ready(); });
+	}
+
+	// The requests are made off the main thread, so give them a moment to show up
+	const auto HasRequested = [&]
+	{
+		return httpClient->CountRequests("/ISteamUser/GetPlayerSummaries/") > 0 &&
+			httpClient->CountRequests("/ISteamUser/GetPlayerBans/") > 0;
+	};
+	for (int i = 0; i < 1000 && !HasRequested(); i++)
+	{
+		world->Update();
+		GetDispatcher().run_for(1ms);
+	}
+
+	// The whole lobby goes out in one request each, even though nobody asked for them yet
+	REQUIRE(httpClient->CountRequests("/ISteamUser/GetPlayerSummaries/") == 1);
+	REQUIRE(httpClient->CountRequests("/ISteamUser/GetPlayerBans/") == 1);
+
+	// Everything per-player waits until something actually wants it
+	REQUIRE(httpClient->CountRequests("logs.tf") == 0);
+	REQUIRE(httpClient->CountRequests("/IEconItems_440/") == 0);
+	REQUIRE(httpClient->CountRequests("/IPlayerService/GetOwnedGames/") == 0);
+}
@@ -9,6 +9,7 @@
 #include "Networking/LogsTFAPI.h"
 #include "TextureManager.h"
 #include "GenericErrors.h"
+#include "UI/ScoreboardModel.h"
 
 #include "Networking/HTTPHelpers.h"
 
@@ -22,18 +23,6 @@
 
 #include "nlohmann/json.hpp"
 
-enum ScoreboardColumnID
-{
-	ScoreboardColumnID_ID,
-	ScoreboardColumnID_Name,
-	ScoreboardColumnID_Kills,
-	ScoreboardColumnID_Death,
-	ScoreboardColumnID_Time,
-	ScoreboardColumnID_Ping,
-	ScoreboardColumnID_SteamID
-};
-
-
 using namespace std::chrono_literals;
 using namespace std::string_view_literals;
 using namespace tf2_bot_detector;
@@ -100,92 +89,20 @@ void MainWindow::OnDrawScoreboard()
 				//ImGui::TableSetupScrollFreeze();
 				ImGui::TableHeadersRow();
 
-				// this is mostly copied from m_Application->m_MainState->GeneratePlayerPrintData().
-				// 100 = player compatiblilty.
-				static IPlayer* printData[100] { nullptr };
+				// sorted rows are cached, and only rebuilt when something actually changes
+				auto& scoreboard = m_Application->GetMainState()->m_Scoreboard;
 
-				// we regenerate this array every frame, so.
-				auto& world = m_Application->GetWorld();
-				auto begin = std::begin(printData);
-				auto end = std::end(printData);
-
-				// fill the array with tables copied from world state.
+				if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs(); sort_specs && sort_specs->SpecsDirty)
 				{
-					auto* current = begin;
-
-					// try to use lobby data and copy it over to playerprintdata.
-					for (IPlayer& member : world.GetLobbyMembers()) {
-						*current = &member;
-						current++;
-					}
-
-					// We seem to have either an empty lobby or we're playing on a community server.
-					// Just find the most recent status updates.
-					if (current == begin) {
-						for (IPlayer& playerData : world.GetPlayers()) {
-							// i fail to understand what this check is for, but whatever.
-							if (playerData.GetLastStatusUpdateTime() >= (world.GetLastStatusUpdateTime() - 15s))
-							{
-								*current = &playerData;
-								current++;
-
-								if (current >= end)
-									break; // This might happen, but we're not in a lobby so everything has to be approximate
-							}
-						}
-					}
-
-					end = current;
+					scoreboard.SetSortSpecs(*sort_specs);
+					sort_specs->SpecsDirty = false;
 				}
 
-
-				ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
-
-				std::sort(begin, end, [&sort_specs](const IPlayer* lhs, const IPlayer* rhs) -> bool {
-					assert(lhs);
-					assert(rhs);
-
-					// copied from CompareWithSortSpecs in imgui_demo.
-					for (int n = 0; n < sort_specs->SpecsCount; n++)
-					{
-						const ImGuiTableColumnSortSpecs* sort_spec = &sort_specs->Specs[n];
-
-						int delta = 0;
-
-
-						switch (sort_spec->ColumnUserID)
-						{
-						case ScoreboardColumnID_ID: {
-							auto luid = lhs->GetUserID();
-							auto ruid = rhs->GetUserID();
-							if (luid && ruid)
-							{
-								delta = luid.value() - ruid.value();
-							}
-							break;
-						}
-						case ScoreboardColumnID_Name: delta = strcmp(lhs->GetNameUnsafe().c_str(), rhs->GetNameUnsafe().c_str()); break;
-						case ScoreboardColumnID_Kills: delta = lhs->GetScores().m_Kills - rhs->GetScores().m_Kills; break;
-						case ScoreboardColumnID_Death: delta = lhs->GetScores().m_Deaths - rhs->GetScores().m_Deaths; break;
-						case ScoreboardColumnID_Time: delta = lhs->GetConnectedTime() > rhs->GetConnectedTime() ? 1 : -1 ; break;
-						case ScoreboardColumnID_Ping: delta = lhs->GetPing() - rhs->GetPing(); break;
-						case ScoreboardColumnID_SteamID: delta = lhs->GetSteamID().ID > rhs->GetSteamID().ID ? 1 : -1 ; break;
-						default: break;
-						}
-
-						// lhs is bigger than rhs.
-						if (delta != 0)
-							return sort_spec->SortDirection == ImGuiSortDirection_Ascending ? delta < 0 : delta > 0 ;
-					}
-
-					// we couldn't sort using the specs so its like whatever i guess
-					return false;
-				});
-
-				// draw the sorted players
-				std::for_each(begin, end, [&](IPlayer* p) -> void {
-					OnDrawScoreboardRow(*p);
-				});
+				for (const ScoreboardModel::Row& row : scoreboard.GetRows())
+				{
+					if (const auto player = row.m_Player.lock())
+						OnDrawScoreboardRow(row, *player);
+				}
 
 				ImGui::EndTable();
 			}
@@ -210,7 +127,7 @@ static ImVec4 BlendColors(const std::array<float, 4>& dstColor, const std::array
 	return ImVec4(result);
 }
 
-void MainWindow::OnDrawScoreboardRow(IPlayer& player)
+void MainWindow::OnDrawScoreboardRow(const ScoreboardModel::Row& row, IPlayer& player)
 {
 	ImGui::TableNextRow();
 	ImGui::TableSetColumnIndex(0);
@@ -228,17 +145,11 @@ void MainWindow::OnDrawScoreboardRow(IPlayer& player)
 	else if (player.GetSteamID() == m_Settings.GetLocalSteamID())
 		textColor = { ImGuiCol_Text, m_Settings.m_Theme.m_Colors.m_ScoreboardYouFG };
 
-	mh::fmtstr<32> buf;
-	if (!player.GetUserID().has_value())
-		buf = "?";
-	else
-		buf.fmt("{}", player.GetUserID().value());
-
 	bool shouldDrawPlayerTooltip = false;
 
 	// Selectable
-	const auto teamShareResult = m_Application->GetModLogic().GetTeamShareResult(player);
-	const auto playerAttribs = m_Application->GetModLogic().GetPlayerAttributes(player);
+	const auto teamShareResult = row.m_TeamShareResult;
+	const auto& playerAttribs = row.m_Marks;
 	{
 		ImVec4 bgColor = [&]() -> ImVec4
 		{
@@ -273,7 +184,7 @@ void MainWindow::OnDrawScoreboardRow(IPlayer& player)
 
 		bgColor.w = std::min(bgColor.w + 0.5f, 1.0f);
 		ImGuiDesktop::ScopeGuards::StyleColor styleColorScopeActive(ImGuiCol_HeaderActive, bgColor);
-		ImGui::Selectable(buf.c_str(), true, ImGuiSelectableFlags_SpanAllColumns);
+		ImGui::Selectable(row.m_UserID.c_str(), true, ImGuiSelectableFlags_SpanAllColumns);
 
 		shouldDrawPlayerTooltip = ImGui::IsItemHovered();
 
@@ -296,11 +207,10 @@ void MainWindow::OnDrawScoreboardRow(IPlayer& player)
 			ImGui::TextFmt("<Unknown>");
 
 		// If their steamcommunity name doesn't match their ingame name
-		if (auto summary = player.GetPlayerSummary();
-			summary && !playerName.empty() && summary->m_Nickname != playerName)
+		if (!row.m_SteamNickname.empty())
 		{
 			ImGui::SameLine();
-			ImGui::TextFmt({ 1, 0, 0, 1 }, "({})", summary->m_Nickname);
+			ImGui::TextFmt({ 1, 0, 0, 1 }, "({})", row.m_SteamNickname);
 		}
 
 		// Move cursor pos up a few pixels if we have icons to draw
@@ -312,75 +222,20 @@ void MainWindow::OnDrawScoreboardRow(IPlayer& player)
 		};
 		std::vector<IconDrawData> icons;
 
-		// Check their steam bans
-		if (auto bans = player.GetPlayerBans())
+		const auto AddIcon = [&](bool shouldDraw, const ITexture* icon, const ImVec4& color, std::string_view tooltip)
 		{
-			// If they are VAC banned
-			std::invoke([&]
-				{
-					if constexpr (!DEBUG_ALWAYS_DRAW_ICONS)
-					{
-						if (bans->m_VACBanCount <= 0)
-							return;
-					}
-
-					auto icon = m_BaseTextures->GetVACShield_16();
-					if (!icon)
-						return;
-
-					icons.push_back({ (ImTextureID)(intptr_t)icon->GetHandle(), { 1, 1, 1, 1 }, "VAC Banned" });
-				});
-
-			// If they are game banned
-			std::invoke([&]
-				{
-					if constexpr (!DEBUG_ALWAYS_DRAW_ICONS)
-					{
-						if (bans->m_GameBanCount <= 0)
-							return;
-					}
-
-					auto icon = m_BaseTextures->GetGameBanIcon_16();
-					if (!icon)
-						return;
-
-					icons.push_back({ (ImTextureID)(intptr_t)icon->GetHandle(), { 1, 1, 1, 1 }, "Game Banned" });
-				});
-		}
-
-		// If they are friends with us on Steam
-		std::invoke([&]
-			{
-				if constexpr (!DEBUG_ALWAYS_DRAW_ICONS)
-				{
-					if (!player.IsFriend())
-						return;
-				}
-
-				auto icon = m_BaseTextures->GetHeart_16();
-				if (!icon)
-					return;
-
-				icons.push_back({ (ImTextureID)(intptr_t)icon->GetHandle(), { 1, 0, 0, 1 }, "Steam Friends" });
-			});
-
-		// They are SourceBanned
-		if (auto sourceBans = player.GetPlayerSourceBanState()) {
-			std::invoke([&]
-				{
-					if constexpr (!DEBUG_ALWAYS_DRAW_ICONS)
-					{
-						if (sourceBans->size() <= 0)
-							return;
-					}
+			if (!DEBUG_ALWAYS_DRAW_ICONS && !shouldDraw)
+				return;
+			if (!icon)
+				return;
 
-					auto icon = m_BaseTextures->GetSourceBansIcon_16();
-					if (!icon)
-						return;
+			icons.push_back({ (ImTextureID)(intptr_t)icon->GetHandle(), color, tooltip });
+		};
 
-					icons.push_back({ (ImTextureID)(intptr_t)icon->GetHandle(), { 1, 1, 1, 1 }, "Has SourceBans Entries" });
-				});
-		}
+		AddIcon(row.m_VACBanned, m_BaseTextures->GetVACShield_16(), { 1, 1, 1, 1 }, "VAC Banned");
+		AddIcon(row.m_GameBanned, m_BaseTextures->GetGameBanIcon_16(), { 1, 1, 1, 1 }, "Game Banned");
+		AddIcon(row.m_IsFriend, m_BaseTextures->GetHeart_16(), { 1, 0, 0, 1 }, "Steam Friends");
+		AddIcon(row.m_SourceBanned, m_BaseTextures->GetSourceBansIcon_16(), { 1, 1, 1, 1 }, "Has SourceBans Entries");
 
 		if (!icons.empty())
 		{
@@ -458,12 +313,14 @@ void MainWindow::OnDrawScoreboardRow(IPlayer& player)
 
 	// Steam ID column
 	{
-		const auto str = player.GetSteamID().str();
-		ImGui::TextFmt(str);
+		ImGui::TextFmt(row.m_SteamID);
 	}
 
 	if (shouldDrawPlayerTooltip)
+	{
+		m_Application->GetWorld().SetHoveredPlayer(player.GetSteamID());
 		DrawPlayerTooltip(player, teamShareResult, playerAttribs);
+	}
 }
 
 void MainWindow::OnDrawScoreboardContextMenu(IPlayer& player)
@@ -910,6 +767,21 @@ static void PrintPlayerMarkedFriendsCount(IPlayer& player, const IModeratorLogic
 			});
 }
 
+static void PrintPlayerFriendsCluster(const IPlayer& player, const IModeratorLogic& modLogic)
+{
+	const FriendsCluster* cluster = modLogic.FindFriendsCluster(player.GetSteamID());
+	if (!cluster)
+		return;
+
+	ImGui::TextFmt(" Friends Group : ");
+	ImGui::SameLineNoPad();
+
+	if (cluster->m_MarkedMembers > 0)
+		ImGui::TextFmt(COLOR_YELLOW, "{} on this server ({} marked)", cluster->m_Members.size(), cluster->m_MarkedMembers);
+	else
+		ImGui::TextFmt("{} on this server", cluster->m_Members.size());
+}
+
 static void PrintPlayerInventoryInfo(const IPlayer& player)
 {
 	ImGui::TextFmt("Inventory Size : ");
@@ -984,6 +856,7 @@ void MainWindow::DrawPlayerTooltipBody(IPlayer& player, TeamShareResult teamShar
 	PrintPlayerLogsCount(player);
 	PrintPlayerInventoryInfo(player);
 	PrintPlayerMarkedFriendsCount(player, m_Application->GetModLogic());
+	PrintPlayerFriendsCluster(player, m_Application->GetModLogic());
 
 #ifdef _DEBUG
 	ImGui::TextFmt("   Active time : {}", HumanDuration(player.GetActiveTime()));
@@ -1088,79 +961,9 @@ void MainWindow::OnDrawTeamStats()
 	if (!m_Settings.m_UIState.m_MainWindow.m_TeamStatsEnabled)
 		return;
 
-	struct TeamStats
-	{
-		uint8_t m_PlayerCount = 0;
-		uint8_t m_PlayerCountActive = 0;
-		uint32_t m_Kills = 0;
-		uint32_t m_Deaths = 0;
-		uint32_t m_MarkedCount = 0;
-		uint32_t m_MarkedCountActive = 0;
-
-		duration_t m_AccountAgeSum{};
-	};
-
-	TeamStats statsArray[2]{};
-
-	IWorldState& world = m_Application->GetWorld();
-
-	for (const IPlayer& player : world.GetPlayers())
-	{
-		TeamStats* stats = nullptr;
-		switch (world.GetTeamShareResult(player))
-		{
-		case TeamShareResult::SameTeams:
-			stats = &statsArray[0];
-			break;
-		case TeamShareResult::OppositeTeams:
-			stats = &statsArray[1];
-			break;
-		default:
-			LogError("Unknown TeamShareResult");
-			[[fallthrough]];
-		case TeamShareResult::Neither:
-			break;
-		}
-
-		if (!stats)
-			continue;
-
-		stats->m_PlayerCount++;
-
-		if (player.GetConnectionState() == PlayerStatusState::Active) {
-			stats->m_PlayerCountActive++;
-		}
-
-		bool foundAccountAge = false;
-		if (auto summary = player.GetPlayerSummary())
-		{
-			if (auto age = summary->GetAccountAge())
-			{
-				stats->m_AccountAgeSum += *age;
-				foundAccountAge = true;
-			}
-		}
-
-		if (!foundAccountAge)
-		{
-			if (auto age = player.GetEstimatedAccountAge())
-			{
-				stats->m_AccountAgeSum += *age;
-				foundAccountAge = true;
-			}
-		}
-
-		stats->m_Kills += player.GetScores().m_Kills;
-		stats->m_Deaths += player.GetScores().m_Deaths;
-
-		if (!m_Application->GetModLogic().GetPlayerList()->GetPlayerAttributes(player).empty()) {
-			stats->m_MarkedCount++;
-
-			if (player.GetConnectionState() == PlayerStatusState::Active) {
-				stats->m_MarkedCountActive++;
-			}
-		}
-	}
+	// kept up to date as players/kills/marks change, so this is just reading a few numbers
+	auto& teamStats = m_Application->GetMainState()->m_TeamStats;
+	const TeamStats statsArray[2] = { teamStats.GetFriendlyTeam(), teamStats.GetEnemyTeam() };
 
 	const auto& themeCols = m_Settings.m_Theme.m_Colors;
 	auto friendlyBG = mh::lerp(themeCols.m_ScoreboardFriendlyTeamBG[3],
@@ -1263,13 +1066,13 @@ void MainWindow::OnDrawTeamStats()
 	}
 
 #if 0
-	if (const auto totalTime = statsArray[0].m_AccountAgeSum + statsArray[1].m_AccountAgeSum; totalTime.count() > 0)
+	if (const auto totalTime = statsArray[0].GetAccountAgeSum() + statsArray[1].GetAccountAgeSum(); totalTime.count() > 0)
 	{
-		const float timeFraction = float(statsArray[0].m_AccountAgeSum.count() / double(totalTime.count()));
+		const float timeFraction = float(statsArray[0].GetAccountAgeSum().count() / double(totalTime.count()));
 
 		ImGui::ProgressBar(timeFraction, { -FLT_MIN, 0 },
 			mh::fmtstr<128>("Team Account Age: {} | {}",
-				HumanDuration(statsArray[0].m_AccountAgeSum), HumanDuration(statsArray[1].m_AccountAgeSum)).c_str());
+				HumanDuration(statsArray[0].GetAccountAgeSum()), HumanDuration(statsArray[1].GetAccountAgeSum())).c_str());
 	}
 #endif
 }
@@ -14,6 +14,7 @@
 #include "ReleaseChannel.h"
 #include "TextureManager.h"
 #include "UpdateManager.h"
+#include "UpdateScheduler.h"
 #include "Util/PathUtils.h"
 #include "Version.h"
 #include "GlobalDispatcher.h"
@@ -388,6 +389,117 @@ void MainWindow::OnDrawAboutPopup()
 	}
 }
 
+static mh::task<std::vector<DB::SessionHistoryInfo>> LoadSessionHistoryAsync(const DB::ITempDB& tempDB, time_point_t since)
+{
+	static constexpr size_t MAX_ROWS = 500;
+
+	co_await DB::ITempDB::GetIOPool().co_add_task();
+	co_return tempDB.GetSessionHistory(since, MAX_ROWS);
+}
+
+void MainWindow::RefreshSessionHistory()
+{
+	// Whatever is still loading gets replaced, only the newest query's results are shown
+	const time_point_t since = m_SessionHistoryShowAll ? time_point_t{} : m_Application->m_OpenTime;
+	m_SessionHistoryLoad = LoadSessionHistoryAsync(m_Application->GetTempDB(), since);
+}
+
+void MainWindow::UpdateSessionHistory()
+{
+	if (m_SessionHistoryLoad.empty())
+		return;
+
+	if (!m_SessionHistoryLoad.is_ready())
+	{
+		// Keep drawing until it shows up, even if we're sleeping in the background
+		UpdateScheduler::Get().RequestRedrawWithin(UpdateScheduler::PENDING_POLL_INTERVAL);
+		return;
+	}
+
+	try
+	{
+		m_SessionHistory = m_SessionHistoryLoad.get();
+	}
+	catch (...)
+	{
+		LogException("Failed to load the session history");
+		m_SessionHistory.clear();
+	}
+
+	m_SessionHistoryLoad = {};
+}
+
+void MainWindow::OnDrawSessionHistoryPopup()
+{
+	static constexpr char POPUP_NAME[] = "Session History##Popup";
+
+	static bool s_Open = false;
+	if (m_SessionHistoryPopupOpen)
+	{
+		m_SessionHistoryPopupOpen = false;
+		ImGui::OpenPopup(POPUP_NAME);
+		s_Open = true;
+		RefreshSessionHistory();
+	}
+
+	ImGui::SetNextWindowSize({ 700, 450 }, ImGuiCond_Appearing);
+	if (ImGui::BeginPopupModal(POPUP_NAME, &s_Open))
+	{
+		ImGui::TextFmt("Players who left the server a while ago, and are no longer kept in memory.");
+
+		if (ImGui::Button("Refresh"))
+			RefreshSessionHistory();
+
+		ImGui::SameLine();
+		if (ImGui::Checkbox("Include previous sessions", &m_SessionHistoryShowAll))
+			RefreshSessionHistory();
+
+		UpdateSessionHistory();
+		if (!m_SessionHistoryLoad.empty())
+		{
+			ImGui::SameLine();
+			ImGui::TextFmt({ 1, 1, 0, 1 }, "Loading...");
+		}
+
+		const auto now = m_Application->GetCurrentTimestampCompensated();
+		if (ImGui::BeginTable("SessionHistoryTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Name");
+			ImGui::TableSetupColumn("Steam ID");
+			ImGui::TableSetupColumn("Last Seen");
+			ImGui::TableSetupColumn("K/D", ImGuiTableColumnFlags_WidthFixed);
+			ImGui::TableHeadersRow();
+
+			for (const auto& info : m_SessionHistory)
+			{
+				ImGui::TableNextRow();
+				ImGui::PushID(info.m_SteamID.GetAccountID());
+
+				ImGui::TableNextColumn();
+				if (ImGui::Selectable(info.m_Name.c_str(), false, ImGuiSelectableFlags_DontClosePopups | ImGuiSelectableFlags_SpanAllColumns))
+					Shell::OpenURL(mh::format("https://steamcommunity.com/profiles/{}", info.m_SteamID.ID64));
+				ImGui::SetHoverTooltip("Open Steam profile");
+
+				ImGui::TableNextColumn();
+				ImGui::TextFmt("{}", info.m_SteamID.str());
+
+				ImGui::TableNextColumn();
+				ImGui::TextFmt("{} ago", HumanDuration(now - info.m_LastSeen));
+
+				ImGui::TableNextColumn();
+				ImGui::TextFmt("{}/{}", info.m_Kills, info.m_Deaths);
+
+				ImGui::PopID();
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::EndPopup();
+	}
+}
+
 #include "ITF2BotDetectorRenderer.h"
 
 void MainWindow::PrintDebugInfo()
@@ -497,8 +609,12 @@ void MainWindow::OnDraw()
 	//if (m_SettingsWindow && m_SettingsWindow->ShouldClose())
 	//	m_SettingsWindow.reset();
 
+	// Set again by OnDrawScoreboardRow, but only while the scoreboard is showing and a row is hovered
+	m_Application->GetWorld().SetHoveredPlayer(std::nullopt);
+
 	OnDrawUpdateCheckPopup();
 	OnDrawAboutPopup();
+	OnDrawSessionHistoryPopup();
 
 	{
 		ISetupFlowPage::DrawState ds;
@@ -723,6 +839,11 @@ void MainWindow::OnDrawMenuBar()
 		if (ImGui::MenuItem("Show Scoreboard", nullptr, &m_Settings.m_UIState.m_MainWindow.m_ScoreboardEnabled))
 			m_Settings.SaveFile();
 
+		ImGui::Separator();
+
+		if (ImGui::MenuItem("Session History..."))
+			OpenSessionHistoryPopup();
+
 		ImGui::EndMenu();
 	}
 
@@ -845,63 +966,68 @@ bool MainWindow::IsSleepingEnabled() const
 	return m_Settings.m_SleepWhenUnfocused;
 }
 
-mh::expected<std::shared_ptr<ITexture>, std::error_condition> MainWindow::TryGetAvatarTexture(IPlayer& player)
+auto MainWindow::LoadAvatarTextureAsync(mh::task<std::shared_ptr<const Bitmap>> avatarBitmapTask,
+	std::shared_ptr<ITextureManager> textureManager) -> AvatarTextureTask
 {
-	using StateTask_t = mh::task<mh::expected<std::shared_ptr<ITexture>, std::error_condition>>;
+	std::shared_ptr<const Bitmap> avatarBitmap;
 
-	struct PlayerAvatarData
+	try
+	{
+		avatarBitmap = co_await avatarBitmapTask;
+	}
+	catch (...)
 	{
-		StateTask_t m_State;
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load avatar bitmap");
+		co_return ErrorCode::UnknownError;
+	}
 
-		static StateTask_t LoadAvatarAsync(mh::task<Bitmap> avatarBitmapTask,
-			mh::dispatcher updateDispatcher, std::shared_ptr<ITextureManager> textureManager)
-		{
-			const Bitmap* avatarBitmap = nullptr;
+	// Switch to main thread
+	co_await SwitchToMainThread();
 
-			try
-			{
-				avatarBitmap = &(co_await avatarBitmapTask);
-			}
-			catch (...)
-			{
-				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load avatar bitmap");
-				co_return ErrorCode::UnknownError;
-			}
-
-			// Switch to main thread
-			co_await updateDispatcher.co_dispatch();
+	try
+	{
+		co_return textureManager->CreateTexture(*avatarBitmap);
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to create avatar bitmap");
+		co_return ErrorCode::UnknownError;
+	}
+}
 
-			try
-			{
-				co_return textureManager->CreateTexture(*avatarBitmap);
-			}
-			catch (...)
-			{
-				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to create avatar bitmap");
-				co_return ErrorCode::UnknownError;
-			}
-		}
+mh::expected<std::shared_ptr<ITexture>, std::error_condition> MainWindow::TryGetAvatarTexture(IPlayer& player)
+{
+	struct PlayerAvatarData
+	{
+		// Shared with everyone else using the same avatar
+		std::shared_ptr<SharedAvatarTexture> m_Texture;
 	};
 
-	auto& avatarData = player.GetOrCreateData<PlayerAvatarData>().m_State;
+	auto& avatarData = player.GetOrCreateData<PlayerAvatarData>().m_Texture;
 
-	if (avatarData.empty())
+	if (!avatarData)
 	{
-		auto playerPtr = player.shared_from_this();
-		const auto& summary = playerPtr->GetPlayerSummary();
-		if (summary)
-		{
-			avatarData = PlayerAvatarData::LoadAvatarAsync(
-				summary->GetAvatarBitmap(m_Settings.GetHTTPClient()),
-				GetDispatcher(), m_TextureManager);
-		}
-		else
-		{
+		const auto& summary = player.GetPlayerSummary();
+		if (!summary)
 			return summary.error();
+
+		if (auto found = m_AvatarTextures.find(summary->m_AvatarHash); found != m_AvatarTextures.end())
+			avatarData = found->second.lock();
+
+		if (!avatarData)
+		{
+			// Forget about avatars that nobody is using anymore
+			std::erase_if(m_AvatarTextures, [](const auto& pair) { return pair.second.expired(); });
+
+			avatarData = std::make_shared<SharedAvatarTexture>();
+			avatarData->m_Task = LoadAvatarTextureAsync(
+				summary->GetAvatarBitmap(m_Settings.GetHTTPClient()), m_TextureManager);
+
+			m_AvatarTextures[summary->m_AvatarHash] = avatarData;
 		}
 	}
 
-	if (auto data = avatarData.try_get())
+	if (auto data = avatarData->m_Task.try_get())
 		return *data;
 	else
 		return std::errc::operation_in_progress;
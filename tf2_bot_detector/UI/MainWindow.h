@@ -7,6 +7,7 @@
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/ConsoleLogParser.h"
 #include "Config/Settings.h"
+#include "DB/TempDB.h"
 #include "DiscordRichPresence.h"
 #include "Networking/GithubAPI.h"
 #include "ModeratorLogic.h"
@@ -17,9 +18,12 @@
 #include "PlayerStatus.h"
 #include "GameData/TFConstants.h"
 #include "Application.h"
+#include "UI/ScoreboardModel.h"
 #include <mh/error/expected.hpp>
 
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 struct ImFont;
@@ -27,6 +31,7 @@ struct ImVec4;
 
 namespace tf2_bot_detector
 {
+	class Bitmap;
 	class IBaseTextures;
 	class IConsoleLine;
 	class IConsoleLineListener;
@@ -56,7 +61,7 @@ namespace tf2_bot_detector
 		void OnDrawAllPanesDisabled();
 
 		void OnDrawScoreboardContextMenu(IPlayer& player);
-		void OnDrawScoreboardRow(IPlayer& player);
+		void OnDrawScoreboardRow(const ScoreboardModel::Row& row, IPlayer& player);
 		void OnDrawColorPicker(const char* name_id, std::array<float, 4>& color);
 		void OnDrawChat();
 		void OnDrawServerStats();
@@ -83,6 +88,15 @@ namespace tf2_bot_detector
 		bool m_AboutPopupOpen = false;
 		void OpenAboutPopup() { m_AboutPopupOpen = true; }
 
+		void OnDrawSessionHistoryPopup();
+		bool m_SessionHistoryPopupOpen = false;
+		bool m_SessionHistoryShowAll = false;
+		std::vector<DB::SessionHistoryInfo> m_SessionHistory;
+		mh::task<std::vector<DB::SessionHistoryInfo>> m_SessionHistoryLoad;
+		void OpenSessionHistoryPopup() { m_SessionHistoryPopupOpen = true; }
+		void RefreshSessionHistory();
+		void UpdateSessionHistory();  // Picks up the results of RefreshSessionHistory() once they're ready
+
 		void PrintDebugInfo();
 		void GenerateDebugReport();
 
@@ -104,6 +118,16 @@ namespace tf2_bot_detector
 		TF2BDApplication* m_Application;
 
 		mh::expected<std::shared_ptr<ITexture>, std::error_condition> TryGetAvatarTexture(IPlayer& player);
+
+		// One texture per unique avatar hash, kept alive by the players using it
+		using AvatarTextureTask = mh::task<mh::expected<std::shared_ptr<ITexture>, std::error_condition>>;
+		struct SharedAvatarTexture
+		{
+			AvatarTextureTask m_Task;
+		};
+		std::unordered_map<std::string, std::weak_ptr<SharedAvatarTexture>> m_AvatarTextures;
+		static AvatarTextureTask LoadAvatarTextureAsync(mh::task<std::shared_ptr<const Bitmap>> avatarBitmapTask,
+			std::shared_ptr<ITextureManager> textureManager);
 		std::shared_ptr<ITextureManager> m_TextureManager;
 		std::unique_ptr<IBaseTextures> m_BaseTextures;
 
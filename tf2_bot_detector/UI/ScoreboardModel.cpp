@@ -0,0 +1,225 @@
+#include "ScoreboardModel.h"
+#include "GameData/IPlayer.h"
+#include "ModeratorLogic.h"
+#include "ConsoleLog/IConsoleLine.h"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <string>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+ScoreboardModel::ScoreboardModel(IWorldState& world, IModeratorLogic& modLogic) :
+	AutoWorldEventListener(world),
+	AutoConsoleLineListener(world),
+	m_World(world),
+	m_ModLogic(modLogic)
+{
+}
+
+void ScoreboardModel::SetSortSpecs(const ImGuiTableSortSpecs& specs)
+{
+	m_SortSpecs.clear();
+	for (int i = 0; i < specs.SpecsCount; i++)
+	{
+		m_SortSpecs.push_back({
+			.m_ColumnID = int(specs.Specs[i].ColumnUserID),
+			.m_Ascending = specs.Specs[i].SortDirection == ImGuiSortDirection_Ascending,
+			});
+	}
+
+	Sort();
+}
+
+void ScoreboardModel::OnConsoleLineParsed(IWorldState& world, IConsoleLine& line)
+{
+	switch (line.GetType())
+	{
+	case ConsoleLineType::LobbyHeader:
+	case ConsoleLineType::LobbyMember:
+	case ConsoleLineType::LobbyChanged:
+	case ConsoleLineType::LobbyStatusFailed:
+	case ConsoleLineType::TeamsSwitched:
+		Invalidate();
+		break;
+
+	case ConsoleLineType::KillNotification:
+	case ConsoleLineType::SuicideNotification:
+		m_NeedsSort = true;
+		break;
+
+	default:
+		break;
+	}
+}
+
+const std::vector<ScoreboardModel::Row>& ScoreboardModel::GetRows()
+{
+	if (auto playerList = m_ModLogic.GetPlayerList())
+	{
+		if (const auto revision = playerList->GetRevision(); revision != m_PlayerListRevision)
+		{
+			m_PlayerListRevision = revision;
+			m_IsDirty = true;
+		}
+	}
+
+	if (m_IsDirty)
+	{
+		Rebuild();
+		return m_Rows;
+	}
+
+	if (m_NeedsSort)
+		Sort();
+
+	if (m_HasPendingRows)
+	{
+		// Steam API data doesn't come with an event, so keep checking until it shows up
+		m_HasPendingRows = false;
+		for (Row& row : m_Rows)
+		{
+			if (row.m_HasPendingAPIData)
+			{
+				UpdateRowAPIData(row);
+				m_HasPendingRows |= row.m_HasPendingAPIData;
+			}
+		}
+	}
+
+	return m_Rows;
+}
+
+void ScoreboardModel::Rebuild()
+{
+	m_IsDirty = false;
+	m_Rows.clear();
+
+	for (IPlayer& member : m_World.GetLobbyMembers())
+		m_Rows.push_back({ .m_Player = member.shared_from_this() });
+
+	// We seem to have either an empty lobby or we're playing on a community server.
+	// Just find the most recent status updates.
+	if (m_Rows.empty())
+	{
+		const auto lastStatusUpdate = m_World.GetLastStatusUpdateTime();
+		for (IPlayer& player : m_World.GetPlayers())
+		{
+			if (player.GetLastStatusUpdateTime() >= (lastStatusUpdate - 15s))
+				m_Rows.push_back({ .m_Player = player.shared_from_this() });
+		}
+	}
+
+	m_HasPendingRows = false;
+	for (Row& row : m_Rows)
+	{
+		UpdateRow(row);
+		m_HasPendingRows |= row.m_HasPendingAPIData;
+	}
+
+	Sort();
+}
+
+void ScoreboardModel::UpdateRow(Row& row) const
+{
+	const auto playerPtr = row.m_Player.lock();
+	if (!playerPtr)
+		return;
+
+	const IPlayer& player = *playerPtr;
+
+	row.m_TeamShareResult = m_ModLogic.GetTeamShareResult(player);
+	row.m_Marks = m_ModLogic.GetPlayerAttributes(player);
+
+	if (auto userID = player.GetUserID())
+		row.m_UserID = std::to_string(*userID);
+	else
+		row.m_UserID = "?";
+
+	row.m_SteamID = player.GetSteamID().str();
+	row.m_IsFriend = player.IsFriend();
+
+	UpdateRowAPIData(row);
+}
+
+void ScoreboardModel::UpdateRowAPIData(Row& row) const
+{
+	row.m_HasPendingAPIData = false;
+
+	const auto playerPtr = row.m_Player.lock();
+	if (!playerPtr)
+		return;
+
+	const IPlayer& player = *playerPtr;
+	const auto IsPending = [](const auto& expected)
+	{
+		return !expected && expected.error() == std::errc::operation_in_progress;
+	};
+
+	const auto& summary = player.GetPlayerSummary();
+	row.m_HasPendingAPIData |= IsPending(summary);
+	if (const auto& name = player.GetNameSafe(); summary && !name.empty() && summary->m_Nickname != name)
+		row.m_SteamNickname = summary->m_Nickname;
+	else
+		row.m_SteamNickname.clear();
+
+	const auto& bans = player.GetPlayerBans();
+	row.m_HasPendingAPIData |= IsPending(bans);
+	row.m_VACBanned = bans && bans->m_VACBanCount > 0;
+	row.m_GameBanned = bans && bans->m_GameBanCount > 0;
+
+	const auto& sourceBans = player.GetPlayerSourceBanState();
+	row.m_HasPendingAPIData |= IsPending(sourceBans);
+	row.m_SourceBanned = sourceBans && !sourceBans->empty();
+}
+
+void ScoreboardModel::Sort()
+{
+	// equal elements have to compare equal, or std::sort is allowed to do whatever it wants
+	const auto ToDelta = [](auto ordering) { return std::is_lt(ordering) ? -1 : (std::is_gt(ordering) ? 1 : 0); };
+
+	m_NeedsSort = false;
+	std::sort(m_Rows.begin(), m_Rows.end(), [&](const Row& lhsRow, const Row& rhsRow) -> bool
+		{
+			const auto lhs = lhsRow.m_Player.lock();
+			const auto rhs = rhsRow.m_Player.lock();
+
+			// Players that are gone sink to the bottom, they aren't drawn anyway
+			if (!lhs || !rhs)
+				return lhs && !rhs;
+
+			// copied from CompareWithSortSpecs in imgui_demo.
+			for (const SortSpec& spec : m_SortSpecs)
+			{
+				int delta = 0;
+
+				switch (spec.m_ColumnID)
+				{
+				case ScoreboardColumnID_ID: {
+					auto luid = lhs->GetUserID();
+					auto ruid = rhs->GetUserID();
+					if (luid && ruid)
+						delta = luid.value() - ruid.value();
+
+					break;
+				}
+				case ScoreboardColumnID_Name: delta = strcmp(lhs->GetNameUnsafe().c_str(), rhs->GetNameUnsafe().c_str()); break;
+				case ScoreboardColumnID_Kills: delta = lhs->GetScores().m_Kills - rhs->GetScores().m_Kills; break;
+				case ScoreboardColumnID_Death: delta = lhs->GetScores().m_Deaths - rhs->GetScores().m_Deaths; break;
+				case ScoreboardColumnID_Time: delta = ToDelta(lhs->GetConnectedTime() <=> rhs->GetConnectedTime()); break;
+				case ScoreboardColumnID_Ping: delta = lhs->GetPing() - rhs->GetPing(); break;
+				case ScoreboardColumnID_SteamID: delta = ToDelta(lhs->GetSteamID().ID <=> rhs->GetSteamID().ID); break;
+				default: break;
+				}
+
+				if (delta != 0)
+					return spec.m_Ascending ? delta < 0 : delta > 0;
+			}
+
+			return false;
+		});
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Config/PlayerListJSON.h"
+#include "ConsoleLog/ConsoleLineListener.h"
+#include "WorldEventListener.h"
+#include "WorldState.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ImGuiTableSortSpecs;
+
+namespace tf2_bot_detector
+{
+	class IModeratorLogic;
+	class IPlayer;
+
+	enum ScoreboardColumnID
+	{
+		ScoreboardColumnID_ID,
+		ScoreboardColumnID_Name,
+		ScoreboardColumnID_Kills,
+		ScoreboardColumnID_Death,
+		ScoreboardColumnID_Time,
+		ScoreboardColumnID_Ping,
+		ScoreboardColumnID_SteamID
+	};
+
+	/// <summary>
+	/// The list of players shown on the scoreboard, sorted, along with everything per-row that's
+	/// expensive to look up every frame (marks, team share, ban/friend icons).
+	///
+	/// Only rebuilt when something changes who's on the scoreboard or what their row looks like
+	/// (status updates, lobby changes, players leaving, our friends list, the playerlist). Kills
+	/// only re-sort it. Values that change constantly (score, ping, connected time) are still read
+	/// from the player while drawing.
+	/// </summary>
+	class ScoreboardModel final : AutoWorldEventListener, AutoConsoleLineListener
+	{
+	public:
+		ScoreboardModel(IWorldState& world, IModeratorLogic& modLogic);
+
+		struct Row
+		{
+			// Doesn't keep players alive after the world lets go of them, skip the row if expired.
+			std::weak_ptr<IPlayer> m_Player;
+
+			TeamShareResult m_TeamShareResult{};
+			PlayerMarks m_Marks;
+
+			std::string m_UserID;              // "?" if unknown
+			std::string m_SteamID;
+			std::string m_SteamNickname;       // empty unless different from their ingame name
+
+			bool m_VACBanned = false;
+			bool m_GameBanned = false;
+			bool m_SourceBanned = false;
+			bool m_IsFriend = false;
+
+			// Steam API data that was still loading when this row was built.
+			bool m_HasPendingAPIData = false;
+		};
+
+		/// <summary>
+		/// Call when ImGui says the sort specs are dirty.
+		/// </summary>
+		void SetSortSpecs(const ImGuiTableSortSpecs& specs);
+
+		const std::vector<Row>& GetRows();
+
+		void Invalidate() { m_IsDirty = true; }
+
+	private:
+		IWorldState& m_World;
+		IModeratorLogic& m_ModLogic;
+
+		struct SortSpec
+		{
+			int m_ColumnID;
+			bool m_Ascending;
+		};
+		std::vector<SortSpec> m_SortSpecs{ { ScoreboardColumnID_Kills, false } };
+
+		std::vector<Row> m_Rows;
+		bool m_IsDirty = true;
+		bool m_NeedsSort = false;
+		bool m_HasPendingRows = false;
+		uint64_t m_PlayerListRevision = 0;
+
+		void Rebuild();
+		void Sort();
+		void UpdateRow(Row& row) const;
+		void UpdateRowAPIData(Row& row) const;
+
+		// Anything in here could change who's on the scoreboard or what they look like
+		void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) override { Invalidate(); }
+		void OnLocalPlayerInitialized(IWorldState& world, bool initialized) override { Invalidate(); }
+		void OnPlayerDroppedFromServer(IWorldState& world, IPlayer& player, const std::string_view& reason) override { Invalidate(); }
+		void OnFriendsListChanged(IWorldState& world) override { Invalidate(); }
+
+		// Lobby changes and kills don't have world events of their own
+		void OnConsoleLineParsed(IWorldState& world, IConsoleLine& line) override;
+	};
+}
@@ -305,6 +305,11 @@ void SettingsWindow::OnDrawPerformanceSettings()
 {
 	if (ImGui::TreeNode("Performance"))
 	{
+		static constexpr uint32_t MIN_REMEMBERED_PLAYERS = 64;
+		static constexpr uint32_t MAX_REMEMBERED_PLAYERS = 2048;
+		static constexpr uint32_t MIN_IDLE_MINUTES = 1;
+		static constexpr uint32_t MAX_IDLE_MINUTES = 600;
+
 		// Sleep when unfocused
 		{
 			if (ImGui::Checkbox("Sleep when unfocused", &m_Settings.m_SleepWhenUnfocused))
@@ -312,6 +317,23 @@ void SettingsWindow::OnDrawPerformanceSettings()
 			ImGui::SetHoverTooltip("Slows program refresh rate when not focused to reduce CPU/GPU usage.");
 		}
 
+		// Player history retention
+		{
+			if (ImGui::SliderScalar("Max remembered players", ImGuiDataType_U32, &m_Settings.m_PlayerHistoryMaxPlayers,
+				&MIN_REMEMBERED_PLAYERS, &MAX_REMEMBERED_PLAYERS))
+			{
+				m_Settings.SaveFile();
+			}
+			ImGui::SetHoverTooltip("Players who have left the server are forgotten once there are more than this many, least recently seen first. They can still be found in View > Session History.");
+
+			if (ImGui::SliderScalar("Forget players after", ImGuiDataType_U32, &m_Settings.m_PlayerHistoryMaxIdleMinutes,
+				&MIN_IDLE_MINUTES, &MAX_IDLE_MINUTES, "%u minutes"))
+			{
+				m_Settings.SaveFile();
+			}
+			ImGui::SetHoverTooltip("Players who have left the server are forgotten after this long. They can still be found in View > Session History.");
+		}
+
 		ImGui::NewLine();
 		ImGui::TreePop();
 	}
@@ -0,0 +1,66 @@
+#include "UpdateScheduler.h"
+
+#include <algorithm>
+
+using namespace tf2_bot_detector;
+
+UpdateScheduler& UpdateScheduler::Get()
+{
+	static UpdateScheduler s_Scheduler;
+	return s_Scheduler;
+}
+
+void UpdateScheduler::BeginUpdate()
+{
+	m_NextDeadline = clock_t::now() + MAX_SLEEP_TIME;
+}
+
+void UpdateScheduler::ScheduleUpdateAt(time_point_t time)
+{
+	m_NextDeadline = std::min(m_NextDeadline, time);
+}
+
+void UpdateScheduler::Wake()
+{
+	m_Woken = true;
+	RequestRedraw();
+}
+
+void UpdateScheduler::RequestRedraw()
+{
+	m_Dirty = true;
+	InvokeWakeCallback();
+}
+
+void UpdateScheduler::RequestRedrawWithin(duration_t delay)
+{
+	auto expected = NO_REDRAW_DEADLINE;
+	if (m_RedrawDeadline.compare_exchange_strong(expected, (clock_t::now() + delay).time_since_epoch().count()))
+	{
+		// First request since the last frame, make sure the main loop knows when to wake up
+		InvokeWakeCallback();
+	}
+}
+
+bool UpdateScheduler::ConsumeDirty()
+{
+	if (!m_Dirty.exchange(false) && !IsRedrawDue())
+		return false;
+
+	// Whatever we draw now includes everything that asked for a later redraw
+	m_RedrawDeadline = NO_REDRAW_DEADLINE;
+	return true;
+}
+
+void UpdateScheduler::InvokeWakeCallback()
+{
+	std::lock_guard lock(m_WakeCallbackMutex);
+	if (m_WakeCallback)
+		m_WakeCallback();
+}
+
+void UpdateScheduler::SetWakeCallback(std::function<void()> callback)
+{
+	std::lock_guard lock(m_WakeCallbackMutex);
+	m_WakeCallback = std::move(callback);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Keeps track of when the app next needs to run Update(), so the main loop can block
+	/// until then instead of spinning when sleeping is enabled.
+	///
+	/// Anything with a timer reports its next deadline through ScheduleUpdateAt() every update,
+	/// and anything event-driven (http responses, etc) calls Wake() from whatever thread it's on.
+	/// </summary>
+	class UpdateScheduler final
+	{
+	public:
+		static UpdateScheduler& Get();
+
+		// Longest we'll ever go without an update, in case someone forgot to schedule one.
+		static constexpr duration_t MAX_SLEEP_TIME = std::chrono::seconds(5);
+
+		// How often to check on things we can't get a wakeup from (futures, inotify, etc).
+		static constexpr duration_t PENDING_POLL_INTERVAL = std::chrono::milliseconds(100);
+		// Same, but for console.log while we're sleeping in the background.
+		static constexpr duration_t SLEEP_POLL_INTERVAL = std::chrono::seconds(1);
+
+		// Main thread only. Called at the start of each update, before deadlines are collected again.
+		void BeginUpdate();
+
+		// Main thread only. Update no later than the given time.
+		void ScheduleUpdateAt(time_point_t time);
+		void ScheduleUpdateIn(duration_t delay) { ScheduleUpdateAt(clock_t::now() + delay); }
+
+		time_point_t GetNextDeadline() const { return m_NextDeadline; }
+		bool IsDeadlineReached() const { return clock_t::now() >= m_NextDeadline; }
+
+		// Thread safe. Wakes up the main loop, and forces an update (and a redraw).
+		void Wake();
+		bool IsWoken() const { return m_Woken; }
+		bool ConsumeWake() { return m_Woken.exchange(false); }
+
+		// Something visible has changed, redraw next frame.
+		void MarkDirty() { m_Dirty = true; }
+		// Thread safe. Like MarkDirty(), but also wakes up the main loop without forcing an update.
+		void RequestRedraw();
+		// Thread safe. Redraw within the given delay. Any other requests made before then share
+		// the same frame, so things that change constantly (the log) can't keep us drawing.
+		void RequestRedrawWithin(duration_t delay);
+		time_point_t GetRedrawDeadline() const { return time_point_t(duration_t(m_RedrawDeadline.load())); }
+		bool IsRedrawDue() const { return clock_t::now() >= GetRedrawDeadline(); }
+		// Main thread only. Should we draw a frame? Clears all pending redraw requests if so.
+		bool ConsumeDirty();
+
+		// Called on Wake(), from any thread. Used to interrupt the renderer waiting for input.
+		void SetWakeCallback(std::function<void()> callback);
+
+	private:
+		UpdateScheduler() = default;
+
+		void InvokeWakeCallback();
+
+		static constexpr duration_t::rep NO_REDRAW_DEADLINE = duration_t::max().count();
+
+		time_point_t m_NextDeadline{};
+		std::atomic_bool m_Woken = false;
+		std::atomic_bool m_Dirty = true;
+		std::atomic<duration_t::rep> m_RedrawDeadline = NO_REDRAW_DEADLINE;
+
+		std::mutex m_WakeCallbackMutex;
+		std::function<void()> m_WakeCallback;
+	};
+}
@@ -24,14 +24,19 @@ namespace tf2_bot_detector
 		return mh::from_chars(to_string_view(match), out);
 	}
 
-	template<typename TIter, typename T, typename... TArgs>
-	inline void from_chars_throw(const std::sub_match<TIter>& match, T& out, TArgs&&... args)
+	template<typename T, typename... TArgs>
+	inline void from_chars_throw(const std::string_view& sv, T& out, TArgs&&... args)
 	{
-		const auto sv = to_string_view(match);
 		auto result = mh::from_chars(sv, out, std::forward<TArgs>(args)...);
 		if (!result)
 		{
 			throw std::runtime_error(mh::format("Failed to parse {} as {}", std::quoted(sv), typeid(T).name()));
 		}
 	}
+
+	template<typename TIter, typename T, typename... TArgs>
+	inline void from_chars_throw(const std::sub_match<TIter>& match, T& out, TArgs&&... args)
+	{
+		from_chars_throw(to_string_view(match), out, std::forward<TArgs>(args)...);
+	}
 }
@@ -17,10 +17,13 @@ namespace tf2_bot_detector
 
 		virtual void OnTimestampUpdate(IWorldState& world) = 0;
 		virtual void OnPlayerStatusUpdate(IWorldState& world, const IPlayer& player) = 0;
+
+		// msg points into the console output being parsed, copy it to keep it past this call
 		virtual void OnChatMsg(IWorldState& world, IPlayer& player, const std::string_view& msg) = 0;
 		virtual void OnLocalPlayerInitialized(IWorldState& world, bool initialized) = 0;
 		virtual void OnLocalPlayerSpawned(IWorldState& world, TFClassType classType) = 0;
 		virtual void OnPlayerDroppedFromServer(IWorldState& world, IPlayer& player, const std::string_view& reason) = 0;
+		virtual void OnFriendsListChanged(IWorldState& world) = 0;
 	};
 
 	class BaseWorldEventListener : public IWorldEventListener
@@ -32,6 +35,7 @@ namespace tf2_bot_detector
 		void OnLocalPlayerInitialized(IWorldState& world, bool initialized) override {}
 		void OnLocalPlayerSpawned(IWorldState& world, TFClassType classType) override {}
 		void OnPlayerDroppedFromServer(IWorldState& world, IPlayer& player, const std::string_view& reason) override {}
+		void OnFriendsListChanged(IWorldState& world) override {}
 	};
 
 	class AutoWorldEventListener : public BaseWorldEventListener
@@ -16,6 +16,7 @@
 #include "GameData/IPlayer.h"
 #include "GameData/Player.h"
 #include "Log.h"
+#include "UpdateScheduler.h"
 #include "WorldEventListener.h"
 #include "Config/AccountAges.h"
 #include "GlobalDispatcher.h"
@@ -56,16 +57,22 @@ using namespace std::string_literals;
 using namespace std::string_view_literals;
 using namespace tf2_bot_detector;
 
-std::shared_ptr<IWorldState> IWorldState::Create(const Settings& settings)
+// Per-player Steam Web API lookups allowed at once. Anything more just sits in the HTTP client's throttle.
+static constexpr size_t STEAM_API_MAX_FETCHES = 4;
+
+std::shared_ptr<IWorldState> IWorldState::Create(const Settings& settings, DB::ITempDB& tempDB)
 {
-	return std::make_shared<WorldState>(settings);
+	return std::make_shared<WorldState>(settings, tempDB);
 }
 
-WorldState::WorldState(const Settings& settings) :
+WorldState::WorldState(const Settings& settings, DB::ITempDB& tempDB) :
 	m_Settings(settings),
+	m_TempDB(tempDB),
 	m_PlayerSummaryUpdates(this),
 	m_PlayerBansUpdates(this),
 	m_PlayerSourceBansUpdates(this),
+	m_PlayerLogsUpdates([this](const SteamID& id, const auto& result) { OnPlayerLogsReady(id, result); }),
+	m_SteamAPIFetches(STEAM_API_MAX_FETCHES, [this](const SteamID& id) { return GetFetchPriority(id); }),
 	m_ConsoleLineListenerBroadcaster(*this)
 {
 	AddConsoleLineListener(this);
@@ -78,11 +85,52 @@ WorldState::~WorldState()
 
 void WorldState::Update()
 {
+	PrefetchLobbyMembers();
+
 	m_PlayerSummaryUpdates.Update();
 	m_PlayerBansUpdates.Update();
+	UpdateSourceBansCache();
 	m_PlayerSourceBansUpdates.Update();
+	std::erase_if(m_PendingTempDBStores, [](mh::task<>& task) { return task.is_ready(); });
+
+	m_PlayerLogsUpdates.Update(GetSettings().GetHTTPClient(), &m_TempDB);
+
+	m_SteamAPIFetches.Update();
 
 	UpdateFriends();
+
+	if ((tfbd_clock_t::now() - m_LastPlayerEviction) >= 30s)
+	{
+		m_LastPlayerEviction = tfbd_clock_t::now();
+		EvictDepartedPlayers();
+	}
+}
+
+time_point_t WorldState::GetNextUpdateTime() const
+{
+	time_point_t next = std::min({
+		m_PlayerSummaryUpdates.GetNextUpdateTime(),
+		m_PlayerBansUpdates.GetNextUpdateTime(),
+		m_PlayerSourceBansUpdates.GetNextUpdateTime(),
+		m_PlayerLogsUpdates.GetNextUpdateTime(),
+		m_SteamAPIFetches.GetNextUpdateTime(),
+		m_LastFriendsUpdate + 5min,
+		m_LastPlayerEviction + 30s,
+		});
+
+	if (!m_LobbyPrefetchQueue.empty())
+		next = tfbd_clock_t::now();
+
+	if (!m_SourceBansCacheLookups.empty())
+		next = std::min(next, clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL);
+
+	if (m_FriendsFuture.valid() && !m_FriendsFuture.is_ready())
+		next = std::min(next, clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL);
+
+	if (!m_PendingTempDBStores.empty())
+		next = std::min(next, clock_t::now() + UpdateScheduler::PENDING_POLL_INTERVAL);
+
+	return next;
 }
 
 void WorldState::UpdateFriends()
@@ -109,7 +157,11 @@ void WorldState::UpdateFriends()
 
 		try
 		{
-			m_Friends = m_FriendsFuture.get();
+			if (auto friends = m_FriendsFuture.get(); friends != m_Friends)
+			{
+				m_Friends = std::move(friends);
+				InvokeEventListener(&IWorldEventListener::OnFriendsListChanged, *this);
+			}
 		}
 		catch (const http_error& e)
 		{
@@ -167,8 +219,8 @@ mh::task<> WorldState::AddConsoleOutputLine(std::string line)
 
 	auto parsed = IConsoleLine::ParseConsoleLine(line, GetCurrentTime(), *this);
 
-	// switch to main thread
-	co_await GetDispatcher().co_dispatch();
+	// switch to main thread (and make sure it's awake to pick us up)
+	co_await SwitchToMainThread();
 
 	if (parsed)
 	{
@@ -193,9 +245,7 @@ void WorldState::UpdateTimestamp(const ConsoleLogParser& parser)
 /// </summary>
 void WorldState::ResetScoreboard()
 {
-	for (const auto& [id, player] : m_CurrentPlayerData) {
-		player.get()->m_Scores = PlayerScores();
-	}
+	m_PlayerTable->ResetScores();
 }
 
 void WorldState::AddWorldEventListener(IWorldEventListener* listener)
@@ -210,19 +260,57 @@ void WorldState::RemoveWorldEventListener(IWorldEventListener* listener)
 
 std::optional<SteamID> WorldState::FindSteamIDForName(const std::string_view& playerName) const
 {
-	std::optional<SteamID> retVal;
-	time_point_t lastUpdated{};
+	std::shared_lock lock(m_PlayerNameIndexMutex);
 
-	for (const auto& data : m_CurrentPlayerData)
+	auto found = m_PlayerNameIndex.find(playerName);
+	if (found == m_PlayerNameIndex.end())
+		return std::nullopt;
+
+	// Duplicate names (impostors): most recently updated wins. Entries are kept in the
+	// order they were updated, so ties also go to whoever was updated last.
+	const PlayerNameIndexEntry* best = nullptr;
+	for (const PlayerNameIndexEntry& entry : found->second)
 	{
-		if (data.second->GetStatus().m_Name == playerName && data.second->GetLastStatusUpdateTime() > lastUpdated)
-		{
-			retVal = data.second->GetSteamID();
-			lastUpdated = data.second->GetLastStatusUpdateTime();
-		}
+		if (!best || entry.m_LastStatusUpdateTime >= best->m_LastStatusUpdateTime)
+			best = &entry;
 	}
 
-	return retVal;
+	if (!best)
+		return std::nullopt;
+
+	return best->m_SteamID;
+}
+
+void WorldState::UpdatePlayerNameIndex(const SteamID& id, const std::string_view& oldName,
+	const std::string_view& newName, time_point_t lastStatusUpdateTime)
+{
+	RemoveFromPlayerNameIndex(id, oldName);
+
+	std::unique_lock lock(m_PlayerNameIndexMutex);
+
+	auto found = m_PlayerNameIndex.find(newName);
+	if (found == m_PlayerNameIndex.end())
+		found = m_PlayerNameIndex.emplace(std::string(newName), std::vector<PlayerNameIndexEntry>{}).first;
+
+	found->second.push_back({ id, lastStatusUpdateTime });
+}
+
+void WorldState::RemoveFromPlayerNameIndex(const SteamID& id, const std::string_view& name)
+{
+	std::unique_lock lock(m_PlayerNameIndexMutex);
+
+	if (auto found = m_PlayerNameIndex.find(name); found != m_PlayerNameIndex.end())
+	{
+		std::erase_if(found->second, [&](const PlayerNameIndexEntry& entry) { return entry.m_SteamID == id; });
+		if (found->second.empty())
+			m_PlayerNameIndex.erase(found);
+	}
+}
+
+void WorldState::ClearPlayerNameIndex()
+{
+	std::unique_lock lock(m_PlayerNameIndexMutex);
+	m_PlayerNameIndex.clear();
 }
 
 std::optional<LobbyMemberTeam> WorldState::FindLobbyMemberTeam(const SteamID& id) const
@@ -344,8 +432,12 @@ mh::generator<const IPlayer&> WorldState::GetLobbyMembers() const
 
 mh::generator<const IPlayer&> WorldState::GetPlayers() const
 {
-	for (const auto& pair : m_CurrentPlayerData)
-		co_yield *pair.second;
+	// Walk the table rather than m_CurrentPlayerData, it's a lot friendlier to the cache
+	for (PlayerTable::index_t i = 0; i < m_PlayerTable->GetSlotCount(); i++)
+	{
+		if (m_PlayerTable->IsCurrent(i))
+			co_yield *m_PlayerTable->m_Owners[i];
+	}
 }
 
 void WorldState::QueuePlayerSummaryUpdate(const SteamID& id)
@@ -358,40 +450,156 @@ void WorldState::QueuePlayerBansUpdate(const SteamID& id)
 	return m_PlayerBansUpdates.Queue(id);
 }
 
+static void ApplySourceBans(const Player& player, const SteamHistoryAPI::PlayerSourceBans& bans)
+{
+	// set our latest ban state for this user.
+	SteamHistoryAPI::PlayerSourceBanState banState;
+	for (const auto& ban : bans) {
+		// we didn't store this server, or this ban is newer than the one we already stored.
+		if (banState.find(ban.m_Server) == banState.end() || banState.at(ban.m_Server).m_BanTimestamp < ban.m_BanTimestamp) {
+			banState.insert_or_assign(ban.m_Server, ban);
+		}
+	}
+
+	player.m_PlayerSourceBans = bans;
+	player.m_PlayerSourceBanState = std::move(banState);
+}
+
+static mh::task<std::optional<DB::SourceBansCacheInfo>> TryGetSourceBansCachedAsync(const DB::ITempDB& tempDB, SteamID id)
+{
+	co_await DB::ITempDB::GetIOPool().co_add_task();
+
+	DB::SourceBansCacheInfo info{};
+	info.m_SteamID = id;
+	if (tempDB.TryGet(info))
+		co_return info;
+
+	co_return std::nullopt;
+}
+
+static mh::task<> StoreSourceBansCachedAsync(DB::ITempDB& tempDB, std::vector<DB::SourceBansCacheInfo> infos)
+{
+	co_await DB::ITempDB::GetIOPool().co_add_task();
+
+	for (const auto& info : infos)
+	{
+		try
+		{
+			tempDB.Store(info);
+		}
+		catch (...)
+		{
+			LogException("Failed to cache SourceBans for {}", info.GetSteamID());
+		}
+	}
+}
+
 void WorldState::QueuePlayerSourceBansUpdate(const SteamID& id)
 {
+	// Regulars are served from the cache, and only go back to steamhistory.net once
+	// their entry goes stale. Stale entries are still shown while that happens.
+	if (GetSettings().m_EnableSteamHistoryIntegration && id.Type == SteamAccountType::Individual) try
+	{
+		const bool isLookingUp = std::any_of(m_SourceBansCacheLookups.begin(), m_SourceBansCacheLookups.end(),
+			[&](const auto& lookup) { return lookup.first == id; });
+
+		if (!isLookingUp)
+			m_SourceBansCacheLookups.push_back({ id, TryGetSourceBansCachedAsync(m_TempDB, id) });
+
+		return;
+	}
+	catch (...)
+	{
+		LogException("Failed to check the SourceBans cache for {}", id);
+	}
+
 	return m_PlayerSourceBansUpdates.Queue(id);
 }
 
-template<typename TMap>
-static auto GetRecentPlayersImpl(TMap&& map, size_t recentPlayerCount)
+void WorldState::UpdateSourceBansCache()
 {
-	using value_type = std::conditional_t<std::is_const_v<std::remove_reference_t<TMap>>, const IPlayer*, IPlayer*>;
-	std::vector<value_type> retVal;
-
-	for (auto& [sid, player] : map)
-		retVal.push_back(player.get());
+	const auto now = tfbd_clock_t::now();
+	for (auto it = m_SourceBansCacheLookups.begin(); it != m_SourceBansCacheLookups.end(); )
+	{
+		if (!it->second.is_ready())
+		{
+			++it;
+			continue;
+		}
 
-	std::sort(retVal.begin(), retVal.end(),
-		[](const IPlayer* a, const IPlayer* b)
+		const SteamID id = it->first;
+		auto state = DB::SourceBansCacheState::Expired;
+		try
 		{
-			return b->GetLastStatusUpdateTime() < a->GetLastStatusUpdateTime();
-		});
+			if (const auto& info = it->second.get())
+			{
+				state = info->GetCacheState(now);
+				if (state != DB::SourceBansCacheState::Expired)
+				{
+					if (auto found = FindPlayer(id))
+						ApplySourceBans(*static_cast<const Player*>(found), info->m_Bans);
+				}
+			}
+		}
+		catch (...)
+		{
+			LogException("Failed to check the SourceBans cache for {}", id);
+		}
 
-	if (retVal.size() > recentPlayerCount)
-		retVal.resize(recentPlayerCount);
+		if (state != DB::SourceBansCacheState::Fresh)
+			m_PlayerSourceBansUpdates.Queue(id);
 
-	return retVal;
+		it = m_SourceBansCacheLookups.erase(it);
+	}
+}
+
+void WorldState::QueuePlayerLogsUpdate(const SteamID& id, LogsTFAPI::RequestPriority priority)
+{
+	return m_PlayerLogsUpdates.Queue(id, priority);
+}
+
+void WorldState::QueuePlayerFetch(const SteamID& id, PlayerFetchScheduler::StartFunc start, PlayerFetchScheduler::CancelFunc cancel)
+{
+	m_SteamAPIFetches.Queue(id, std::move(start), std::move(cancel));
+}
+
+std::optional<FetchPriority> WorldState::GetFetchPriority(const SteamID& id) const
+{
+	auto found = m_CurrentPlayerData.find(id);
+	if (found == m_CurrentPlayerData.end() || IsDeparted(*found->second))
+		return std::nullopt;
+
+	if (GetTeamShareResult(id) == TeamShareResult::OppositeTeams)
+		return FetchPriority::Enemy;
+	if (m_HoveredPlayer == id)
+		return FetchPriority::Hovered;
+
+	return FetchPriority::Normal;
+}
+
+void WorldState::OnPlayerLogsReady(const SteamID& id, const mh::expected<LogsTFAPI::PlayerLogsInfo>& result)
+{
+	// Might have been evicted while it was queued
+	if (auto found = FindPlayer(id))
+		static_cast<const Player*>(found)->m_LogsInfo = result;
 }
 
 std::vector<const IPlayer*> WorldState::GetRecentPlayers(size_t recentPlayerCount) const
 {
-	return GetRecentPlayersImpl(m_CurrentPlayerData, recentPlayerCount);
+	std::vector<const IPlayer*> retVal;
+	for (PlayerTable::index_t index : m_PlayerTable->GetRecentPlayers(recentPlayerCount))
+		retVal.push_back(m_PlayerTable->m_Owners[index]);
+
+	return retVal;
 }
 
 std::vector<IPlayer*> WorldState::GetRecentPlayers(size_t recentPlayerCount)
 {
-	return GetRecentPlayersImpl(m_CurrentPlayerData, recentPlayerCount);
+	std::vector<IPlayer*> retVal;
+	for (PlayerTable::index_t index : m_PlayerTable->GetRecentPlayers(recentPlayerCount))
+		retVal.push_back(m_PlayerTable->m_Owners[index]);
+
+	return retVal;
 }
 
 void WorldState::OnConfigExecLineParsed(const ConfigExecLine& execLine)
@@ -447,7 +655,10 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 	{
 		m_CurrentLobbyMembers.clear();
 		m_PendingLobbyMembers.clear();
+		m_LobbyPrefetchQueue.clear();
 		m_CurrentPlayerData.clear();
+		m_PlayerTable->DetachAll();
+		ClearPlayerNameIndex();
 	};
 
 	switch (parsed.GetType())
@@ -485,8 +696,7 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		if (changeType == LobbyChangeType::Created || changeType == LobbyChangeType::Updated)
 		{
 			// We can't trust the existing client indices
-			for (auto& player : m_CurrentPlayerData)
-				player.second->m_ClientIndex = 0;
+			m_PlayerTable->ResetClientIndices();
 		}
 
 		if (changeType == LobbyChangeType::Destroyed) {
@@ -603,7 +813,10 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 
 		// FIXME: this seems to never update, so we might as well just not bother.
 		const TFTeam tfTeam = member.m_Team == LobbyMemberTeam::Defenders ? TFTeam::Red : TFTeam::Blue;
-		FindOrCreatePlayer(member.m_SteamID).m_Team = tfTeam;
+		FindOrCreatePlayer(member.m_SteamID).SetTeam(tfTeam);
+
+		// Picked up on the next Update(), once the rest of the tf_lobby_debug output is in
+		m_LobbyPrefetchQueue.push_back(member.m_SteamID);
 
 		break;
 	}
@@ -643,7 +856,7 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		auto& statusLine = static_cast<const ServerStatusShortPlayerLine&>(parsed);
 		const auto& status = statusLine.GetPlayerStatus();
 		if (auto steamID = FindSteamIDForName(status.m_Name))
-			FindOrCreatePlayer(*steamID).m_ClientIndex = status.m_ClientIndex;
+			FindOrCreatePlayer(*steamID).SetClientIndex(status.m_ClientIndex);
 
 		break;
 	}
@@ -661,10 +874,10 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		if (attackerSteamID) 
 		{
 			auto& attacker = FindOrCreatePlayer(*attackerSteamID);
-			attacker.m_Scores.m_Kills++;
+			attacker.GetScores().m_Kills++;
 
 			if (victimSteamID == localSteamID)
-				attacker.m_Scores.m_LocalKills++;
+				attacker.GetScores().m_LocalKills++;
 
 			killLogStream << "<" << std::setw(17) << std::setfill('0') << attacker.GetSteamID().ID64 << "> " << attacker.GetNameSafe();
 		}
@@ -674,10 +887,10 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 		if (victimSteamID)
 		{
 			auto& victim = FindOrCreatePlayer(*victimSteamID);
-			victim.m_Scores.m_Deaths++;
+			victim.GetScores().m_Deaths++;
 
 			if (attackerSteamID == localSteamID)
-				victim.m_Scores.m_LocalDeaths++;
+				victim.GetScores().m_LocalDeaths++;
 
 
 			killLogStream << "<" << victim.GetSteamID().ID64 << "> " << victim.GetNameSafe();
@@ -770,6 +983,115 @@ void WorldState::OnConsoleLineParsed(IWorldState& world, IConsoleLine& parsed)
 	}
 }
 
+void WorldState::PrefetchLobbyMembers()
+{
+	if (m_LobbyPrefetchQueue.empty())
+		return;
+
+	// Everything queued here goes out together in the next batch of each BatchedAction, so
+	// the whole lobby only costs a request or two even when everything else is lazy loaded.
+	// Anything that was already fetched (or is in progress) isn't queued again.
+	for (const SteamID& id : m_LobbyPrefetchQueue)
+	{
+		auto found = m_CurrentPlayerData.find(id);
+		if (found == m_CurrentPlayerData.end())
+			continue;
+
+		const Player& player = *found->second;
+		player.GetPlayerSummary();
+		player.GetPlayerBans();
+		player.GetPlayerSourceBanState();
+	}
+
+	m_LobbyPrefetchQueue.clear();
+}
+
+bool WorldState::IsDeparted(const Player& player) const
+{
+	const SteamID steamID = player.GetSteamID();
+	if (steamID == m_Settings.GetLocalSteamID() || FindLobbyMemberTeam(steamID))
+		return false;
+
+	// Only known from chat, friends lists, kill feed etc, so never seen on the server to leave it
+	const time_point_t lastStatusUpdate = player.GetLastStatusUpdateTime();
+	if (lastStatusUpdate == time_point_t{})
+		return false;
+
+	// Anyone who showed up in a recent status update is still on the server
+	return lastStatusUpdate < (m_LastStatusUpdateTime - 1min);
+}
+
+static mh::task<> StoreSessionHistoryAsync(DB::ITempDB& tempDB, std::vector<DB::SessionHistoryInfo> history)
+{
+	co_await DB::ITempDB::GetIOPool().co_add_task();
+
+	try
+	{
+		tempDB.Store(history);
+	}
+	catch (...)
+	{
+		LogException("Failed to save {} departed players to the session history", history.size());
+	}
+}
+
+void WorldState::EvictDepartedPlayers()
+{
+	const auto now = GetCurrentTime();
+	const auto maxIdleTime = m_Settings.GetPlayerHistoryMaxIdleTime();
+	const size_t maxPlayers = m_Settings.m_PlayerHistoryMaxPlayers;
+
+	std::vector<Player*> departed;
+	for (const auto& [steamID, player] : m_CurrentPlayerData)
+	{
+		if (IsDeparted(*player))
+			departed.push_back(player.get());
+	}
+
+	if (departed.empty())
+		return;
+
+	// least recently seen first
+	std::sort(departed.begin(), departed.end(), [](const Player* a, const Player* b)
+		{
+			return a->GetLastStatusUpdateTime() < b->GetLastStatusUpdateTime();
+		});
+
+	std::vector<DB::SessionHistoryInfo> history;
+	size_t evictedCount = 0;
+	for (Player* player : departed)
+	{
+		const bool isIdle = (now - player->GetLastStatusUpdateTime()) > maxIdleTime;
+		const bool isOverLimit = m_CurrentPlayerData.size() > maxPlayers;
+		if (!isIdle && !isOverLimit)
+			break;
+
+		const SteamID steamID = player->GetSteamID();
+
+		if (steamID.Type == SteamAccountType::Individual)
+		{
+			DB::SessionHistoryInfo& info = history.emplace_back();
+			info.m_SteamID = steamID;
+			info.m_Name = player->GetNameUnsafe();
+			info.m_FirstSeen = player->GetConnectionTime();
+			info.m_LastSeen = player->GetLastStatusUpdateTime();
+			info.m_Kills = player->GetScores().m_Kills;
+			info.m_Deaths = player->GetScores().m_Deaths;
+		}
+
+		RemoveFromPlayerNameIndex(steamID, player->GetStatus().m_Name);
+		m_PlayerTable->Detach(player->GetTableIndex());
+		m_CurrentPlayerData.erase(steamID); // player is (probably) gone after this
+		evictedCount++;
+	}
+
+	if (!history.empty())
+		m_PendingTempDBStores.push_back(StoreSessionHistoryAsync(m_TempDB, std::move(history)));
+
+	if (evictedCount > 0)
+		DebugLog("Moved {} departed players to the session history, {} players remaining", evictedCount, m_CurrentPlayerData.size());
+}
+
 Player& WorldState::FindOrCreatePlayer(const SteamID& id)
 {
 	Player* data;
@@ -786,7 +1108,7 @@ Player& WorldState::FindOrCreatePlayer(const SteamID& id)
 			data->GetPlayerSummary();
 			data->GetPlayerBans();
 			data->GetTF2Playtime();
-			data->GetLogsInfo();
+			data->PrefetchLogsInfo();
 			data->GetFriendsInfo();
 			data->GetInventoryInfo();
 			data->GetPlayerSourceBanState();
@@ -901,7 +1223,8 @@ auto WorldState::PlayerSourceBansUpdateAction::SendRequest(state_type& state,
 		for (auto& entry : collection)
 		{
 			// TODO: make your own custom error... lol.. don't repurpose errors like this...
-			if (auto found = state->FindPlayer(entry)) {
+			// Leave anything we already got from the cache alone.
+			if (auto found = state->FindPlayer(entry); found && !static_cast<Player*>(found)->m_PlayerSourceBanState) {
 				static_cast<Player*>(found)->m_PlayerSourceBanState = ErrorCode::InternetConnectivityDisabled;
 				static_cast<Player*>(found)->m_PlayerSourceBans = ErrorCode::InternetConnectivityDisabled;
 			}
@@ -910,49 +1233,47 @@ auto WorldState::PlayerSourceBansUpdateAction::SendRequest(state_type& state,
 		return {};
 	}
 
-	std::vector<SteamID> steamIDs = Take100(collection);
+	m_Requested = Take100(collection);
 
-	return SteamHistoryAPI::GetPlayerSourceBansAsync(state->GetSettings().GetSteamHistoryAPIKey(), std::move(steamIDs), *client);
+	return SteamHistoryAPI::GetPlayerSourceBansAsync(state->GetSettings().GetSteamHistoryAPIKey(), m_Requested, *client);
 }
 
 void WorldState::PlayerSourceBansUpdateAction::OnDataReady(state_type& state,
 	const response_type& response, queue_collection_type& collection)
 {
-	DebugLog("[SteamHistory] Received {} player's bans", response.size());
-
-	for (const auto& steamID : collection) {
-		auto& player = state->FindOrCreatePlayer(steamID);
-		// SteamHistoryAPI::PlayerSourceBans
-
-		SteamHistoryAPI::PlayerSourceBanState banState;
-
-		// we have a ban.
-		if (response.find(steamID) != response.end()) {
-			const auto& bans = response.at(steamID);
-
+	DebugLog("[SteamHistory] Received {} player's bans", response.m_Bans.size());
+	if (!response.m_IsComplete)
+		LogWarning("[SteamHistory] Incomplete response, players without bans will be requested again");
+
+	for (const auto& steamID : m_Requested) {
+		// steamhistory.net only returns keys for users that have bans
+		// FIXME: ask XVF so it returns keys at least for users with no bans
+		SteamHistoryAPI::PlayerSourceBans bans;
+		if (auto found = response.m_Bans.find(steamID); found != response.m_Bans.end()) {
+			bans = found->second;
 			DebugLog("[SteamHistory] user {} has {} ban records", steamID, bans.size());
+		}
+		else if (!response.m_IsComplete) {
+			// Might be one of the entries that didn't parse, ask again with the next batch
+			continue;
+		}
 
-			// set our entire history of bans (remove?)
-			player.m_PlayerSourceBans = bans;
-
-			// set our latest ban state for this user.
-			for (const auto& ban : bans) {
-				// we didn't store this server, or this ban is newer than the one we already stored.
-				if (banState.find(ban.m_Server) == banState.end() || banState.at(ban.m_Server).m_BanTimestamp < ban.m_BanTimestamp) {
-					banState.insert(std::pair(ban.m_Server, ban));
-				}
-			}
+		ApplySourceBans(state->FindOrCreatePlayer(steamID), bans);
+		collection.erase(steamID);
+	}
 
-			player.m_PlayerSourceBanState = banState;
+	if (auto infos = DB::SourceBansCacheInfo::FromResult(m_Requested, response, tfbd_clock_t::now()); !infos.empty())
+	{
+		try
+		{
+			state->m_PendingTempDBStores.push_back(StoreSourceBansCachedAsync(state->m_TempDB, std::move(infos)));
 		}
-		else {
-			player.m_PlayerSourceBanState = banState;
-			player.m_PlayerSourceBans = SteamHistoryAPI::PlayerSourceBans();
+		catch (...)
+		{
+			LogException("Failed to cache SourceBans results");
 		}
 	}
 
-	// any other users are either errors (and we should reattempt)
-	// or doesn't have a ban, so we can safely clear our queue.
-	// FIXME: ask XVF so it returns keys at least for users with no bans
-	collection.clear();
+	// Anyone queued after the request went out is picked up by the next one
+	m_Requested.clear();
 }
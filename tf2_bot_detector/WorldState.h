@@ -2,12 +2,16 @@
 
 #include "Clock.h"
 #include "SteamID.h"
+#include "GameData/PlayerFetchScheduler.h"
+#include "GameData/PlayerTable.h"
 #include "GameData/TFConstants.h"
 
 #include <mh/coroutine/task.hpp>
 #include <mh/coroutine/generator.hpp>
 
 #include <optional>
+#include <shared_mutex>
+#include <string_view>
 
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/ConsoleLogParser.h"
@@ -30,6 +34,9 @@
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "ConsoleLog/ConsoleLogParser.h"
 #include "BatchedAction.h"
+#include "DB/TempDB.h"
+#include "Networking/LogsTFAPI.h"
+#include "Networking/SteamHistoryAPI.h"
 #include <mh/algorithm/algorithm.hpp>
 #include <mh/concurrency/dispatcher.hpp>
 #include <mh/concurrency/main_thread.hpp>
@@ -54,6 +61,11 @@ namespace tf2_bot_detector
 	class Settings;
 	enum class TFClassType;
 
+	namespace DB
+	{
+		class ITempDB;
+	}
+
 	enum class TeamShareResult
 	{
 		SameTeams,
@@ -81,11 +93,14 @@ namespace tf2_bot_detector
 	public:
 		virtual ~IWorldState() = default;
 
-		static std::shared_ptr<IWorldState> Create(const Settings& settings);
+		static std::shared_ptr<IWorldState> Create(const Settings& settings, DB::ITempDB& tempDB);
 
 		virtual void Update() = 0;
 		virtual void ResetScoreboard() = 0;
 
+		// The soonest time Update() has something to do.
+		virtual time_point_t GetNextUpdateTime() const = 0;
+
 		virtual time_point_t GetCurrentTime() const = 0;
 		virtual time_point_t GetLastStatusUpdateTime() const = 0;
 
@@ -124,6 +139,9 @@ namespace tf2_bot_detector
 		virtual const std::string& GetMapName() const = 0;
 
 		virtual const IAccountAges& GetAccountAges() const = 0;
+
+		// The player under the mouse in the scoreboard, if any. Their data is fetched before most others.
+		virtual void SetHoveredPlayer(const std::optional<SteamID>& id) = 0;
 	};
 
 	inline mh::generator<IPlayer&> IWorldState::GetLobbyMembers()
@@ -140,7 +158,7 @@ namespace tf2_bot_detector
 	class WorldState final : public IWorldState, BaseConsoleLineListener
 	{
 	public:
-		WorldState(const Settings& settings);
+		WorldState(const Settings& settings, DB::ITempDB& tempDB);
 		~WorldState();
 
 		std::shared_ptr<WorldState> shared_from_this() { return std::static_pointer_cast<WorldState>(IWorldState::shared_from_this()); }
@@ -150,6 +168,7 @@ namespace tf2_bot_detector
 		size_t GetApproxLobbyMemberCount() const override;
 
 		void Update() override;
+		time_point_t GetNextUpdateTime() const override;
 		void UpdateTimestamp(const ConsoleLogParser& parser);
 		void ResetScoreboard() override;
 
@@ -189,6 +208,9 @@ namespace tf2_bot_detector
 		void QueuePlayerSummaryUpdate(const SteamID& id);
 		void QueuePlayerBansUpdate(const SteamID& id);
 		void QueuePlayerSourceBansUpdate(const SteamID& id);
+		void QueuePlayerLogsUpdate(const SteamID& id, LogsTFAPI::RequestPriority priority);
+		void QueuePlayerFetch(const SteamID& id, PlayerFetchScheduler::StartFunc start, PlayerFetchScheduler::CancelFunc cancel);
+		void SetHoveredPlayer(const std::optional<SteamID>& id) override { m_HoveredPlayer = id; }
 
 		const Settings& GetSettings() const { return m_Settings; }
 		const std::vector<LobbyMember>& GetCurrentLobbyMembers() const { return m_CurrentLobbyMembers; }
@@ -206,6 +228,7 @@ namespace tf2_bot_detector
 
 	private:
 		const Settings& m_Settings;
+		DB::ITempDB& m_TempDB;
 
 		CompensatedTS m_CurrentTimestamp;
 
@@ -213,6 +236,23 @@ namespace tf2_bot_detector
 		void OnConfigExecLineParsed(const ConfigExecLine& execLine);
 
 		void UpdateFriends();
+
+		// Lobby members we haven't started fetching data for yet. They usually show up in
+		// tf_lobby_debug well before they finish connecting, so by the time they show up in
+		// status (and in the connecting cheater warnings) most of it is already here. Only the
+		// batched lookups, so this still applies while Settings::m_LazyLoadAPIData is set.
+		std::vector<SteamID> m_LobbyPrefetchQueue;
+		void PrefetchLobbyMembers();
+
+		// Showed up in status at some point, but not for a while, and isn't in the lobby
+		bool IsDeparted(const Player& player) const;
+
+		// Keeps m_CurrentPlayerData from growing forever on community servers (no lobby resets)
+		void EvictDepartedPlayers();
+		time_point_t m_LastPlayerEviction{};
+
+		// Evicted players on their way into the TempDB, on DB::ITempDB::GetIOPool()
+		std::vector<mh::task<>> m_PendingTempDBStores;
 		mh::task<std::unordered_set<SteamID>> m_FriendsFuture;
 		std::unordered_set<SteamID> m_Friends;
 		time_point_t m_LastFriendsUpdate{};
@@ -240,21 +280,58 @@ namespace tf2_bot_detector
 		} m_PlayerBansUpdates;
 
 		struct PlayerSourceBansUpdateAction final :
-			BatchedAction<WorldState*, SteamID, SteamHistoryAPI::PlayerSourceBansResponse>
+			BatchedAction<WorldState*, SteamID, SteamHistoryAPI::PlayerSourceBansResult>
 		{
 			using BatchedAction::BatchedAction;
 		protected:
 			response_future_type SendRequest(state_type& state, queue_collection_type& collection) override;
 			void OnDataReady(state_type& state, const response_type& response,
 				queue_collection_type& collection) override;
+
+		private:
+			// Anyone in here that isn't in a complete response has no bans
+			std::vector<SteamID> m_Requested;
 		} m_PlayerSourceBansUpdates;
 
+		// TempDB lookups for m_PlayerSourceBansUpdates, on DB::ITempDB::GetIOPool()
+		std::vector<std::pair<SteamID, mh::task<std::optional<DB::SourceBansCacheInfo>>>> m_SourceBansCacheLookups;
+		void UpdateSourceBansCache();
+
+		LogsTFAPI::PlayerLogsQueue m_PlayerLogsUpdates;
+		void OnPlayerLogsReady(const SteamID& id, const mh::expected<LogsTFAPI::PlayerLogsInfo>& result);
+
+		// Friends, inventories and playtime, all Steam Web API
+		PlayerFetchScheduler m_SteamAPIFetches;
+		std::optional<FetchPriority> GetFetchPriority(const SteamID& id) const;
+		std::optional<SteamID> m_HoveredPlayer;
+
 		std::string m_ServerHostName;
 		std::string m_MapName;
 
 		std::vector<LobbyMember> m_CurrentLobbyMembers;
 		std::vector<LobbyMember> m_PendingLobbyMembers;
+		std::shared_ptr<PlayerTable> m_PlayerTable = std::make_shared<PlayerTable>();
 		std::unordered_map<SteamID, std::shared_ptr<Player>> m_CurrentPlayerData;
+
+		// Current name -> everyone currently using that name, so FindSteamIDForName doesn't have to
+		// scan all of m_CurrentPlayerData. Kept up to date by Player::SetStatus.
+		friend class Player;
+		void UpdatePlayerNameIndex(const SteamID& id, const std::string_view& oldName,
+			const std::string_view& newName, time_point_t lastStatusUpdateTime);
+		void RemoveFromPlayerNameIndex(const SteamID& id, const std::string_view& name);
+		void ClearPlayerNameIndex();
+		struct PlayerNameIndexEntry
+		{
+			SteamID m_SteamID;
+			time_point_t m_LastStatusUpdateTime;
+		};
+		struct PlayerNameHash
+		{
+			using is_transparent = void;
+			size_t operator()(const std::string_view& name) const { return std::hash<std::string_view>{}(name); }
+		};
+		std::unordered_map<std::string, std::vector<PlayerNameIndexEntry>, PlayerNameHash, std::equal_to<>> m_PlayerNameIndex;
+		mutable std::shared_mutex m_PlayerNameIndexMutex; // console lines from rcon are parsed on another thread
 		bool m_IsLocalPlayerInitialized = false;
 		bool m_IsVoteInProgress = false;
 
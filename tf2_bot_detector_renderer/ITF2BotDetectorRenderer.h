@@ -80,6 +80,20 @@ public:
 	/// <returns></returns>
 	virtual bool InFocus() const = 0;
 
+	/// <summary>
+	/// block until there's input to process, Wake() is called, or the timeout expires.
+	///
+	/// note: returns immediately in overlay mode.
+	/// </summary>
+	/// <param name="timeoutMS">max time to wait in ms</param>
+	/// <returns>true if there's input waiting for the next DrawFrame(). Wake() alone doesn't count.</returns>
+	virtual bool WaitForEvents(int timeoutMS) = 0;
+
+	/// <summary>
+	/// interrupt WaitForEvents(). safe to call from any thread.
+	/// </summary>
+	virtual void Wake() = 0;
+
 	/// <summary>
 	/// is this "window" in focus?
 	///
@@ -130,6 +130,16 @@ bool TF2BotDetectorD3D9Renderer::InFocus() const
 	return true;
 }
 
+bool TF2BotDetectorD3D9Renderer::WaitForEvents(int timeoutMS)
+{
+	// tf2 drives our frames
+	return true;
+}
+
+void TF2BotDetectorD3D9Renderer::Wake()
+{
+}
+
 std::string TF2BotDetectorD3D9Renderer::RendererInfo() const
 {
 	return "DirectX 9";
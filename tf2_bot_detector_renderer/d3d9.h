@@ -56,6 +56,12 @@ public:
 	/// <returns></returns>
 	bool InFocus() const;
 
+	/// <summary>
+	/// external-only feature.
+	/// </summary>
+	bool WaitForEvents(int timeoutMS);
+	void Wake();
+
 	std::string RendererInfo() const;
 
 private:
@@ -255,6 +255,24 @@ bool TF2BotDetectorSDLRenderer::InFocus() const
 	return SDL_GetWindowFlags(window) & (SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_MOUSE_FOCUS);
 }
 
+bool TF2BotDetectorSDLRenderer::WaitForEvents(int timeoutMS)
+{
+	// passing nullptr leaves the event in the queue for DrawFrame()
+	if (SDL_WaitEventTimeout(nullptr, timeoutMS) == 0)
+		return false;
+
+	// Wake() events are only there to interrupt the wait, they don't need a frame drawn
+	SDL_FlushEvent(SDL_USEREVENT);
+	return SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+}
+
+void TF2BotDetectorSDLRenderer::Wake()
+{
+	SDL_Event event{};
+	event.type = SDL_USEREVENT;
+	SDL_PushEvent(&event);
+}
+
 std::string TF2BotDetectorSDLRenderer::RendererInfo() const
 {
 	return "TF2BotDetectorSDLRenderer: OpenGl 4.3 + GLSL 430"; // fmt::format(FMT_COMPILE("TF2BotDetectorSDLRenderer: OpenGl GL 4.3 + GLSL 430"));
@@ -61,6 +61,14 @@ public:
 	/// <returns></returns>
 	bool InFocus() const;
 
+	/// <summary>
+	/// sleep until there's an SDL event (input, window events, or Wake()) or the timeout expires.
+	/// </summary>
+	/// <param name="timeoutMS">max time to wait in ms</param>
+	/// <returns>true if there's an event waiting, other than from Wake()</returns>
+	bool WaitForEvents(int timeoutMS);
+	void Wake();
+
 	std::string RendererInfo() const;
 private:
 